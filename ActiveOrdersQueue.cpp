@@ -8,71 +8,302 @@
 
 
 #include "ActiveOrdersQueue.h"
+#include <utility>
+#include "OperationStats.h"
 
-// Constructor for Node class, initializes the order data and next pointer
-ActiveOrdersQueue::Node::Node(Order data) {
-    this->data = data;  // Assign the order data to the node
+const long long ActiveOrdersQueue::DEFAULT_AGING_MILLIS;
+
+// Constructor for Node class, copies the order data and clears the pointers
+ActiveOrdersQueue::Node::Node(const Order& data) : data(data) {
+    this->prev = NULL;   // Set the previous pointer to NULL
+    this->next = NULL;   // Set the next pointer to NULL
+    this->levelPrev = NULL;  // Not in a priority list yet
+    this->levelNext = NULL;
+}
+
+// Constructor for Node class, moves the order data in and clears the pointers
+ActiveOrdersQueue::Node::Node(Order&& data) : data(std::move(data)) {
+    this->prev = NULL;   // Set the previous pointer to NULL
     this->next = NULL;   // Set the next pointer to NULL
+    this->levelPrev = NULL;  // Not in a priority list yet
+    this->levelNext = NULL;
 }
 
 // Constructor for ActiveOrdersQueue class, initializes the queue
-ActiveOrdersQueue::ActiveOrdersQueue() {
+ActiveOrdersQueue::ActiveOrdersQueue(int nodeBlockSize) : nodePool(nodeBlockSize) {
     myFront = NULL;     // Front of the queue is initially NULL
     myBack = NULL;      // Back of the queue is initially NULL
     size = 0;           // Queue is initially empty, so size is 0
     nextOrderId = 1;    // First order will have ID 1
+    mode = SCHEDULE_FIFO;  // Strict arrival order unless changed
+    agingMillis = DEFAULT_AGING_MILLIS;
+    for (int level = 0; level < PRIORITY_LEVELS; ++level) {
+        levelFront[level] = NULL;
+        levelBack[level] = NULL;
+    }
 }
 
 // Destructor for ActiveOrdersQueue class, clears the queue when destroyed
 ActiveOrdersQueue::~ActiveOrdersQueue() {
-    // Keep dequeuing until the queue is empty
-    while (!isEmpty()) {
-        Order temp;
-        dequeue(temp);  // Remove an order and store it in temp (unused here)
+    // Free the nodes directly; dequeue would count and stamp every order
+    while (myFront != NULL) {
+        NodePtr next = myFront->next;
+        destroyNode(myFront);
+        myFront = next;
     }
+    myBack = NULL;
     size = 0;  // Reset size to 0 after clearing the queue
 }
 
-// Enqueue method to add a new order to the back of the queue
-void ActiveOrdersQueue::enqueue(const Order& newOrder) {
+// Enqueue method to add a copy of a new order to the back of the queue
+int ActiveOrdersQueue::enqueue(const Order& newOrder) {
+    STATS_TIMER(timer, STAT_ENQUEUE);
     // Create a new node to hold the order
-    NodePtr newNode = new Node(newOrder);
+    return enqueueNode(new (nodePool.allocate()) Node(newOrder));
+}
+
+// Enqueue method to move a new order to the back of the queue
+int ActiveOrdersQueue::enqueue(Order&& newOrder) {
+    STATS_TIMER(timer, STAT_ENQUEUE);
+    // The node takes over the order's strings and line items
+    return enqueueNode(new (nodePool.allocate()) Node(std::move(newOrder)));
+}
+
+// Adds an order to the back of the queue keeping the ID it already has
+void ActiveOrdersQueue::restoreOrder(Order&& order) {
+    NodePtr newNode = new (nodePool.allocate()) Node(std::move(order));
+    if (newNode->data.getOrderId() >= nextOrderId) {
+        nextOrderId = newNode->data.getOrderId() + 1;  // Never hand out this ID again
+    }
+    linkAtBack(newNode);
+}
+
+// Gives a new node the next order ID and links it at the back
+int ActiveOrdersQueue::enqueueNode(NodePtr newNode) {
     newNode->data.setOrderId(nextOrderId);  // Set the order ID for the new order
+    newNode->data.markPlaced();  // Starts the ticket clock
     nextOrderId++;  // Increment the next available order ID
-    
+    linkAtBack(newNode);
+    return newNode->data.getOrderId();
+}
+
+// Returns the ID the next enqueued order will receive
+int ActiveOrdersQueue::getNextOrderId() const {
+    return nextOrderId;
+}
+
+// Links a new node at the back of the queue and indexes it
+void ActiveOrdersQueue::linkAtBack(NodePtr newNode) {
     // If the queue is empty, set both front and back to the new node
     if (isEmpty()) {
         myFront = myBack = newNode;
     } else {
         // Otherwise, add the new node to the end of the queue and update the back pointer
+        newNode->prev = myBack;
         myBack->next = newNode;
         myBack = newNode;
     }
-    
+    indexById[newNode->data.getOrderId()] = newNode;  // Index the order by its ID
+    if (mode == SCHEDULE_PRIORITY) {
+        linkInLevel(newNode);
+    }
+
     size++;  // Increment the size of the queue
 }
 
+// Links a node at the back of the list of its priority class
+void ActiveOrdersQueue::linkInLevel(NodePtr node) {
+    int level = node->data.getPriority();
+    node->levelNext = NULL;
+    node->levelPrev = levelBack[level];
+    if (levelBack[level] == NULL) {
+        levelFront[level] = node;
+    } else {
+        levelBack[level]->levelNext = node;
+    }
+    levelBack[level] = node;
+}
+
+// Files every queued order in the list of its class, in arrival order
+void ActiveOrdersQueue::rebuildLevels() {
+    for (int level = 0; level < PRIORITY_LEVELS; ++level) {
+        levelFront[level] = NULL;
+        levelBack[level] = NULL;
+    }
+    if (mode == SCHEDULE_PRIORITY) {
+        for (NodePtr node = myFront; node != NULL; node = node->next) {
+            linkInLevel(node);
+        }
+    }
+}
+
+// Picks the list front that has waited longest once its class is counted as waiting
+ActiveOrdersQueue::NodePtr ActiveOrdersQueue::nextScheduled() const {
+    NodePtr best = NULL;
+    long long bestKey = 0;
+    for (int level = PRIORITY_LEVELS - 1; level >= 0; --level) {  // Ties go to the higher class
+        NodePtr front = levelFront[level];
+        if (front != NULL) {
+            long long key = front->data.getPlacedAt() - level * agingMillis;
+            if (best == NULL || key < bestKey) {
+                best = front;
+                bestKey = key;
+            }
+        }
+    }
+    return best;
+}
+
+// Unlinks a node from the arrival list and its priority list
+void ActiveOrdersQueue::unlinkNode(NodePtr node) {
+    if (node->prev == NULL) {
+        myFront = node->next;  // The order was at the front
+    } else {
+        node->prev->next = node->next;
+    }
+    if (node->next == NULL) {
+        myBack = node->prev;   // The order was at the back
+    } else {
+        node->next->prev = node->prev;
+    }
+
+    if (mode == SCHEDULE_PRIORITY) {
+        int level = node->data.getPriority();
+        if (node->levelPrev == NULL) {
+            levelFront[level] = node->levelNext;
+        } else {
+            node->levelPrev->levelNext = node->levelNext;
+        }
+        if (node->levelNext == NULL) {
+            levelBack[level] = node->levelPrev;
+        } else {
+            node->levelNext->levelPrev = node->levelPrev;
+        }
+    }
+
+    size--;
+}
+
+// Chooses how dequeue picks the next order
+void ActiveOrdersQueue::setSchedulingMode(SchedulingMode newMode, long long newAgingMillis) {
+    agingMillis = newAgingMillis > 0 ? newAgingMillis : 0;
+    if (newMode != mode) {
+        mode = newMode;
+        rebuildLevels();  // Files the queued orders by class, or drops the lists
+    }
+}
+
+// Returns the scheduling mode
+SchedulingMode ActiveOrdersQueue::getSchedulingMode() const {
+    return mode;
+}
+
+// Returns the waiting time one priority class is worth
+long long ActiveOrdersQueue::getAgingMillis() const {
+    return agingMillis;
+}
+
 // Dequeue method to remove and return the front order from the queue
 bool ActiveOrdersQueue::dequeue(Order& processedOrder) {
+    STATS_TIMER(timer, STAT_DEQUEUE);
     // If the queue is empty, return false
     if (isEmpty()) {
         return false;
     }
     
-    // Temporarily hold the front node
-    NodePtr temp = myFront;
-    processedOrder = myFront->data;  // Set the processed order to the data of the front node
-    myFront = myFront->next;  // Move the front pointer to the next node
-    delete temp;  // Delete the old front node to free memory
-    size--;  // Decrease the size of the queue
-    
-    // If the queue is now empty, set the back pointer to NULL
-    if (myFront == NULL) {
-        myBack = NULL;
-    }
+    // The front node, or the one priority scheduling picks
+    NodePtr temp = mode == SCHEDULE_FIFO ? myFront : nextScheduled();
+    unlinkNode(temp);  // Out of the lists
+    indexById.erase(temp->data.getOrderId());  // Remove the order from the index
+    processedOrder = std::move(temp->data);  // Move the order out of the node
+    processedOrder.markStarted();  // The kitchen picks it up now
+    destroyNode(temp);  // Return the node to the pool
     return true;  // Successfully dequeued an order
 }
 
+// Destroys a node and returns its storage to the pool
+void ActiveOrdersQueue::destroyNode(NodePtr node) {
+    node->~Node();
+    nodePool.deallocate(node);
+}
+
+// Returns the allocation statistics of the node pool
+PoolStats ActiveOrdersQueue::getNodePoolStats() const {
+    return nodePool.getStats();
+}
+
+// Appends the queued orders and the ID counter to a binary snapshot buffer
+void ActiveOrdersQueue::writeBinary(string& out) const {
+    appendInt32(out, nextOrderId);
+    appendInt32(out, size);
+    for (NodePtr node = myFront; node != NULL; node = node->next) {
+        node->data.writeBinary(out);  // Front to back, so the order is kept
+    }
+}
+
+// Replaces the queue with one read from a binary snapshot
+bool ActiveOrdersQueue::readBinary(BinaryReader& in, const DynamicArrayList* menu) {
+    int32_t nextId, count;
+    if (!in.readInt32(nextId) || !in.readInt32(count) || count < 0
+        || static_cast<size_t>(count) > in.remaining() / Order::MIN_BINARY_SIZE) {
+        return false;  // More orders than the remaining bytes could hold
+    }
+
+    // Decode into a separate chain so a bad snapshot leaves the queue untouched
+    NodePtr front = NULL;
+    NodePtr back = NULL;
+    bool complete = true;
+    for (int i = 0; i < count && complete; ++i) {
+        NodePtr node = new (nodePool.allocate()) Node(Order());
+        complete = node->data.readBinary(in, menu);
+        node->prev = back;
+        if (back == NULL) {
+            front = node;
+        } else {
+            back->next = node;
+        }
+        back = node;
+    }
+    if (!complete) {
+        while (front != NULL) {
+            NodePtr next = front->next;
+            destroyNode(front);
+            front = next;
+        }
+        return false;
+    }
+
+    while (!isEmpty()) {  // Drop the current orders
+        NodePtr next = myFront->next;
+        destroyNode(myFront);
+        myFront = next;
+        size--;
+    }
+    indexById.clear();
+    indexById.reserve(count);
+    for (NodePtr node = front; node != NULL; node = node->next) {
+        indexById[node->data.getOrderId()] = node;
+    }
+    myFront = front;
+    myBack = back;
+    size = count;
+    nextOrderId = nextId;
+    rebuildLevels();  // The priority lists point at the new nodes
+    return true;
+}
+
+// Exchanges the orders of two queues; the scheduling settings stay put
+void ActiveOrdersQueue::swap(ActiveOrdersQueue& other) {
+    std::swap(myFront, other.myFront);
+    std::swap(myBack, other.myBack);
+    std::swap(size, other.size);
+    std::swap(nextOrderId, other.nextOrderId);
+    indexById.swap(other.indexById);
+    nodePool.swap(other.nodePool);  // The nodes go back to the pool they came from
+    rebuildLevels();
+    other.rebuildLevels();
+}
+
 // Returns the current size of the queue
 int ActiveOrdersQueue::getSize() const {
     return size;
@@ -80,50 +311,26 @@ int ActiveOrdersQueue::getSize() const {
 
 // Method to delete a specific order by order ID
 bool ActiveOrdersQueue::deleteOrder(int orderId) {
-    // If the queue is empty, return false
-    if (isEmpty()) {
-        return false;
+    STATS_TIMER(timer, STAT_DELETE_ORDER);
+    // Look the order up in the index instead of walking the queue
+    unordered_map<int, NodePtr>::iterator found = indexById.find(orderId);
+    if (found == indexById.end()) {
+        return false;  // Order with the given ID was not found
     }
-    
-    // Start with the front node
-    NodePtr temp = myFront;
-    NodePtr prev = NULL;  // To track the previous node for deletion
-    
-    // Traverse the queue to find the order by its ID
-    while (temp != NULL) {
-        // If the current node's order ID matches the given order ID
-        if (temp->data.getOrderId() == orderId) {
-            // If the order to delete is at the front
-            if (prev == NULL) {
-                myFront = temp->next;  // Move the front pointer to the next node
-            } else {
-                prev->next = temp->next;  // Remove the node from the list
-            }
-            
-            // If the order to delete is at the back, update the back pointer
-            if (temp == myBack) {
-                myBack = prev;
-            }
-            nextOrderId--;  // Decrement the next available order ID
-            delete temp;  // Free the memory of the deleted node
-            size--;  // Decrease the size of the queue
-            
-            // Reassign order IDs starting from 1 after the deletion
-            NodePtr current = myFront;
-            int newId = 1;
-            while (current != NULL) {
-                current->data.setOrderId(newId);  // Reset the order ID for each remaining order
-                ++newId;
-                current = current->next;
-            }
-            
-            return true;  // Order was successfully deleted
-        }
-        prev = temp;  // Move the previous pointer to the current node
-        temp = temp->next;  // Move to the next node in the queue
+    NodePtr temp = found->second;
+    indexById.erase(found);
+    unlinkNode(temp);   // Unlink the node from its neighbours
+    destroyNode(temp);  // Return the deleted node to the pool
+    return true;  // Order was successfully deleted
+}
+
+// Method to find an active order by order ID
+Order* ActiveOrdersQueue::findOrder(int orderId) {
+    unordered_map<int, NodePtr>::iterator found = indexById.find(orderId);
+    if (found == indexById.end()) {
+        return NULL;  // Order with the given ID was not found
     }
-    
-    return false;  // Order with the given ID was not found
+    return &found->second->data;
 }
 
 // Method to display all active orders in the queue
@@ -6,26 +6,65 @@
    This class manages a dynamic queue of orders, where each order is represented
    by a node in a linked list. The queue follows the FIFO (First-In-First-Out) principle,
    where orders are added to the back and removed from the front.
+   Order IDs are assigned once at enqueue time and never change. An index from
+   order ID to node lets orders be found or cancelled in constant time.
+   Nodes are allocated from a NodePool, so enqueue and dequeue reuse freed
+   nodes instead of calling new and delete for every order.
+   Orders passed as temporaries are moved into their node and dequeue moves
+   the order back out, so an order is not deep-copied on its way through.
+
+   Scheduling is FIFO by default. In SCHEDULE_PRIORITY mode the queue also
+   keeps one FIFO list per OrderPriority class, and dequeue takes the front
+   of one of those lists: each class above normal counts as agingMillis of
+   extra waiting, so a pickup order goes ahead of normal orders placed up to
+   three aging periods before it, but an order that has waited long enough
+   is served before newer orders of any class and nothing starves. Only the
+   PRIORITY_LEVELS list fronts are compared, so dequeue stays constant time
+   however many orders are open. Display and snapshots keep arrival order.
 
    Basic operations:
-     - Constructor: Constructs an empty ActiveOrdersQueue.
+     - Constructor: Constructs an empty ActiveOrdersQueue, optionally with the
+                    number of nodes allocated per pool block.
      - Destructor:  Releases all dynamically allocated memory used by the queue.
-     - enqueue:     Adds a new order to the back of the queue.
-     - dequeue:     Removes the order at the front of the queue.
+     - enqueue:     Adds a new order to the back of the queue and returns its ID;
+                    a temporary order is moved in instead of copied.
+     - restoreOrder: Adds an order to the back of the queue keeping the ID it carries.
+     - getNextOrderId: Returns the ID the next enqueued order will receive.
+     - dequeue:     Moves the order at the front out of the queue.
      - deleteOrder: Deletes a specific order by its unique identifier.
+     - findOrder:   Finds an active order by its unique identifier.
      - displayActiveOrders: Displays all active orders in the queue with their details.
      - isEmpty:     Checks if the queue contains any orders.
      - getSize:     Retrieves the total number of orders currently in the queue.
+     - getNodePoolStats: Retrieves the allocation statistics of the node pool.
+     - setSchedulingMode: Chooses FIFO or priority scheduling with aging.
+     - getSchedulingMode: Returns the scheduling mode.
+     - getAgingMillis: Returns how much waiting one priority class is worth.
+     - writeBinary: Appends the queued orders and the ID counter to a binary buffer.
+     - readBinary:  Replaces the queue with one written by writeBinary.
+     - swap:        Exchanges the orders of two queues.
 
    Private utility:
-     - Node: Represents a single node in the queue, storing an Order object and a pointer
-             to the next node in the sequence.
+     - Node: Represents a single node in the queue, storing an Order object and pointers
+             to the previous and next nodes in the sequence.
+     - enqueueNode: Gives a new node the next order ID and links it at the back.
+     - linkAtBack: Links a new node at the back of the queue and indexes it.
+     - linkInLevel: Links a node at the back of the list of its priority class.
+     - rebuildLevels: Rebuilds the priority lists from the arrival order.
+     - nextScheduled: Picks the node dequeue takes in priority mode.
+     - unlinkNode: Unlinks a node from the arrival list and its priority list.
+     - destroyNode: Destroys a node and returns its storage to the node pool.
 
    Data members:
      - myFront: Pointer to the front node of the queue (first order).
      - myBack:  Pointer to the back node of the queue (last order).
      - size:    Tracks the number of orders currently in the queue.
-     - nextOrderId: Keeps a counter for assigning unique order IDs (if applicable).
+     - nextOrderId: Keeps a counter for assigning unique order IDs.
+     - indexById: Maps the ID of every queued order to its node.
+     - nodePool:  Pool that provides the storage for the nodes.
+     - mode:      The scheduling mode.
+     - agingMillis: Waiting time that one priority class is worth.
+     - levelFront, levelBack: Ends of the list of each priority class.
  
 --------------------------------------------------------------------------*/
 
@@ -33,16 +72,27 @@
 #define ACTIVEORDERSQUEUE_H
 
 #include <iostream>
+#include <unordered_map>
+#include "NodePool.h"
 #include "Order.h"
 using namespace std;
 
+// How dequeue picks the next order.
+enum SchedulingMode {
+    SCHEDULE_FIFO,      // Strictly in arrival order.
+    SCHEDULE_PRIORITY   // By priority class, with aging.
+};
+
 class ActiveOrdersQueue {
 public:
-    ActiveOrdersQueue();
+    static const long long DEFAULT_AGING_MILLIS = 5 * 60 * 1000;  // One class per 5 minutes of waiting.
+
+    ActiveOrdersQueue(int nodeBlockSize = 256);
     /*------------------------------------------------------------------------
       Purpose:       Construct an empty ActiveOrdersQueue object.
 
-      Precondition:  None.
+      Precondition:  nodeBlockSize is the number of nodes the pool allocates
+                     at a time and is a positive integer.
       Postcondition: An empty queue has been created with myFront and myBack
                      and size set to 0 and the nextItemId is set to 1.
      -----------------------------------------------------------------------*/
@@ -54,20 +104,50 @@ public:
       Postcondition: All memory allocated for the queue has been released
                      and size is set to 0.
      -----------------------------------------------------------------------*/
-    void enqueue(const Order&);
+    int enqueue(const Order&);
     /*------------------------------------------------------------------------
       Purpose:       Add a new order to the back of the queue.
 
       Precondition:  newOrder is a valid Order object.
-      Postcondition: The newOrder has been added to the back of the queue.
+      Postcondition: A copy of newOrder has been added to the back of the
+                     queue with the next unused order ID, which is returned,
+                     and stamped as placed now.
+     -----------------------------------------------------------------------*/
+    int enqueue(Order&&);
+    /*------------------------------------------------------------------------
+      Purpose:       Move a new order to the back of the queue.
+
+      Precondition:  newOrder is a valid Order object.
+      Postcondition: Same as enqueue(const Order&), but the order's data has
+                     been moved into the queue without copying its line items
+                     or strings; newOrder is left empty.
+     -----------------------------------------------------------------------*/
+    void restoreOrder(Order&&);
+    /*------------------------------------------------------------------------
+      Purpose:       Move an order that already has its ID to the back of the queue.
+
+      Precondition:  The order's ID is positive and not in the queue.
+      Postcondition: The order has been added with its own ID and its own
+                     lifecycle stamps, and nextOrderId has been moved past
+                     that ID. The argument is left empty.
+     -----------------------------------------------------------------------*/
+    int getNextOrderId() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Get the ID the next enqueued order will receive.
+
+      Precondition:  None.
+      Postcondition: Returns nextOrderId. Every ID below it has been used.
      -----------------------------------------------------------------------*/
     bool dequeue(Order&);
     /*------------------------------------------------------------------------
       Purpose:       Remove the order from the front of the queue.
 
       Precondition:  The queue is not empty.
-      Postcondition: The front order has been removed, and its data is stored
-                     in frontOrder. Returns true if successful, false otherwise.
+      Postcondition: The next order - the front one in FIFO mode, the one
+                     chosen by priority and aging otherwise - has been
+                     removed, and its data has been moved into frontOrder
+                     and stamped as started. Returns true if successful,
+                     false otherwise.
      -----------------------------------------------------------------------*/
     bool deleteOrder(int);
     /*------------------------------------------------------------------------
@@ -75,9 +155,18 @@ public:
 
       Precondition:  orderId is a valid integer.
       Postcondition: The order with the specified ID has been removed if found.
+                     The IDs of the remaining orders are unchanged.
                      Returns true if the order was found and deleted,
                      false otherwise.
      -----------------------------------------------------------------------*/
+    Order* findOrder(int);
+    /*------------------------------------------------------------------------
+      Purpose:       Find an active order by its ID.
+
+      Precondition:  orderId is a valid integer.
+      Postcondition: Returns a pointer to the queued order with the specified
+                     ID, or NULL if no such order is in the queue.
+     -----------------------------------------------------------------------*/
     void displayActiveOrders();
     /*------------------------------------------------------------------------
       Purpose:       Display all active orders in the queue.
@@ -99,26 +188,161 @@ public:
       Precondition:  None.
       Postcondition: Returns the size of the queue.
      -----------------------------------------------------------------------*/
+    PoolStats getNodePoolStats() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Get the allocation statistics of the node pool.
+
+      Precondition:  None.
+      Postcondition: Returns the counters of the pool that stores the nodes.
+     -----------------------------------------------------------------------*/
+    void setSchedulingMode(SchedulingMode, long long = DEFAULT_AGING_MILLIS);
+    /*------------------------------------------------------------------------
+      Purpose:       Choose how dequeue picks the next order.
+
+      Precondition:  agingMillis is the waiting time one priority class is
+                     worth; it is only used in SCHEDULE_PRIORITY mode.
+      Postcondition: Later dequeues use the new mode. Switching to priority
+                     mode files the queued orders by class, in O(n).
+     -----------------------------------------------------------------------*/
+    SchedulingMode getSchedulingMode() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Get the scheduling mode.
+
+      Precondition:  None.
+      Postcondition: Returns SCHEDULE_FIFO unless it was changed.
+     -----------------------------------------------------------------------*/
+    long long getAgingMillis() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Get the waiting time one priority class is worth.
+
+      Precondition:  None.
+      Postcondition: Returns milliseconds.
+     -----------------------------------------------------------------------*/
+    void writeBinary(string&) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Serialize the queue for a binary snapshot.
+
+      Precondition:  None.
+      Postcondition: nextOrderId and every queued order, front first, are
+                     appended to the buffer.
+     -----------------------------------------------------------------------*/
+    bool readBinary(BinaryReader&, const DynamicArrayList*);
+    /*------------------------------------------------------------------------
+      Purpose:       Restore a queue written by writeBinary.
+
+      Precondition:  The reader is positioned at the start of a queue. `menu`
+                     is used to display item names and may be NULL.
+      Postcondition: The queue holds the decoded orders in their original
+                     order and with their original IDs, and nextOrderId is
+                     restored. Returns false, leaving the queue unchanged,
+                     if the data is incomplete or its count is
+                     larger than the remaining bytes could hold.
+     -----------------------------------------------------------------------*/
+    void swap(ActiveOrdersQueue&);
+    /*------------------------------------------------------------------------
+      Purpose:       Exchange the orders of two queues.
+
+      Precondition:  None.
+      Postcondition: Each queue holds the orders, nodes and nextOrderId the
+                     other had. Each keeps its scheduling mode and aging, and
+                     its priority lists are rebuilt for the orders it now
+                     holds.
+     -----------------------------------------------------------------------*/
     
 private:
     class Node {
     public:
-        Node(Order data);
+        Node(const Order& data);
         /*------------------------------------------------------------------------
           Purpose:       Constructs a Node object containing an Order and a pointer to the next node.
 
           Precondition:  A valid Order object is provided.
           Postcondition: A Node is created with `order` set to the Order object and
-                         `next` set to nullptr.
+                         `prev` and `next` set to nullptr.
+        ------------------------------------------------------------------------*/
+        Node(Order&& data);
+        /*------------------------------------------------------------------------
+          Purpose:       Constructs a Node that takes over the data of an Order.
+
+          Precondition:  A valid Order object is provided.
+          Postcondition: Same as Node(const Order&); `data` has been moved in.
         ------------------------------------------------------------------------*/
         Order data; // The order stored in the node.
+        Node* prev; // Pointer to the previous node in the queue.
         Node* next; // Pointer to the next node in the queue.
+        Node* levelPrev; // Previous node of the same priority class, in priority mode.
+        Node* levelNext; // Next node of the same priority class, in priority mode.
     };
     typedef Node* NodePtr;
+
+    int enqueueNode(NodePtr);
+    /*------------------------------------------------------------------------
+      Purpose:       Give a new node the next order ID and link it at the back.
+
+      Precondition:  The node holds an order that is not in the queue.
+      Postcondition: The order has the next unused ID and is stamped as
+                     placed, nextOrderId has been incremented, and the node
+                     has been linked. Returns the ID.
+     -----------------------------------------------------------------------*/
+    void linkAtBack(NodePtr);
+    /*------------------------------------------------------------------------
+      Purpose:       Link a new node at the back of the queue.
+
+      Precondition:  The node holds an order whose ID is not in the queue.
+      Postcondition: The node is the new back of the queue, and of its
+                     priority list in priority mode, it is indexed by its
+                     order ID and size has been incremented.
+     -----------------------------------------------------------------------*/
+    void linkInLevel(NodePtr);
+    /*------------------------------------------------------------------------
+      Purpose:       Link a node at the back of the list of its priority class.
+
+      Precondition:  The node is not in a priority list.
+      Postcondition: The node is the back of its class's list.
+     -----------------------------------------------------------------------*/
+    void rebuildLevels();
+    /*------------------------------------------------------------------------
+      Purpose:       Rebuild the priority lists from the arrival order.
+
+      Precondition:  None.
+      Postcondition: In priority mode every queued node is in the list of its
+                     class, in arrival order; otherwise the lists are empty.
+     -----------------------------------------------------------------------*/
+    NodePtr nextScheduled() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Pick the node dequeue takes in priority mode.
+
+      Precondition:  The queue is not empty and is in priority mode.
+      Postcondition: Returns the list front whose placed time, less
+                     agingMillis per class above normal, is earliest; ties
+                     go to the higher class.
+     -----------------------------------------------------------------------*/
+    void unlinkNode(NodePtr);
+    /*------------------------------------------------------------------------
+      Purpose:       Unlink a node from the queue.
+
+      Precondition:  The node is queued.
+      Postcondition: The node is out of the arrival list and its priority
+                     list, and size has been decremented. The node is still
+                     indexed and not destroyed.
+     -----------------------------------------------------------------------*/
+    void destroyNode(NodePtr);
+    /*------------------------------------------------------------------------
+      Purpose:       Destroy a node and release its storage.
+
+      Precondition:  The node was created in nodePool and is no longer linked.
+      Postcondition: The node's order is destroyed and its slot is back in the pool.
+     -----------------------------------------------------------------------*/
     
     NodePtr myFront; // Pointer to the front node of the queue.
     NodePtr myBack; // Pointer to the back node of the queue.
     int size; // Number of orders in the queue.
     int nextOrderId; // Identifier for the next order.
+    unordered_map<int, NodePtr> indexById; // Maps an order ID to its node.
+    NodePool<Node> nodePool; // Storage for the nodes of the queue.
+    SchedulingMode mode; // How dequeue picks the next order.
+    long long agingMillis; // Waiting time that one priority class is worth.
+    NodePtr levelFront[PRIORITY_LEVELS]; // Front of each priority list, in priority mode.
+    NodePtr levelBack[PRIORITY_LEVELS];  // Back of each priority list, in priority mode.
 };
 #endif /* ACTIVEORDERSQUEUE_H */
@@ -0,0 +1,291 @@
+// This is the implementation file for the AppendOnlyLog class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, AppendOnlyLog.h, provides the class structure and function declarations.
+
+//
+//  AppendOnlyLog.cpp
+//
+
+#include "AppendOnlyLog.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "BinaryIO.h"
+
+static const char LOG_MAGIC[] = "RMSLOG01";  // First bytes of every log file
+static const size_t LOG_MAGIC_SIZE = 8;
+static const size_t RECORD_HEADER_SIZE = 8;  // Length and checksum
+
+static const size_t SCAN_BUFFER_SIZE = 64 * 1024;  // Read-ahead used while scanning a file
+
+// Constructor, stores the commit settings; the log starts closed
+AppendOnlyLog::AppendOnlyLog(int groupSize, FsyncPolicy policy, int flushIntervalMillis) {
+    fd = -1;
+    this->groupSize = groupSize > 0 ? groupSize : 1;
+    this->policy = policy;
+    this->flushIntervalMillis = flushIntervalMillis > 0 ? flushIntervalMillis : 0;
+    batchRecords = 0;
+    unsynced = false;
+    stats.records = 0;
+    stats.commits = 0;
+    stats.fsyncs = 0;
+    stats.bytes = 0;
+    stopping = true;  // Closed until open succeeds
+}
+
+// Destructor, writes pending records and closes the file
+AppendOnlyLog::~AppendOnlyLog() {
+    close();
+}
+
+// Opens or creates a log file and positions it after the last valid record
+bool AppendOnlyLog::open(const string& fileName) {
+    lock_guard<mutex> writing(writeLock);
+    if (fd >= 0) {
+        return false;  // Already open
+    }
+
+    // Find the end of the last valid record without loading the whole file
+    size_t fileSize = 0, validEnd = 0;
+    FILE* in = fopen(fileName.c_str(), "rb");
+    if (in != NULL) {
+        bool valid = scanFile(in, fileSize, validEnd, NULL);
+        fclose(in);
+        if (!valid) {
+            cerr << "Not a log file: " << fileName << endl;
+            return false;
+        }
+    }
+    bool header = fileSize >= LOG_MAGIC_SIZE;
+
+    int file = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (file < 0) {
+        cerr << "Failed to open log: " << fileName << endl;
+        return false;
+    }
+    if (header && validEnd < fileSize) {
+        // Drop a torn tail so new records are not hidden behind it
+        if (ftruncate(file, validEnd) != 0) {
+            ::close(file);
+            return false;
+        }
+    }
+    if (!header) {
+        // New file, or one that crashed while its header was being written
+        if (ftruncate(file, 0) != 0 || write(file, LOG_MAGIC, LOG_MAGIC_SIZE) != (ssize_t)LOG_MAGIC_SIZE) {
+            ::close(file);
+            return false;
+        }
+    }
+
+    fd = file;
+    unsynced = !header;
+    lastSync = chrono::steady_clock::now();
+    {
+        lock_guard<mutex> guard(batchLock);
+        stopping = false;
+    }
+    if (flushIntervalMillis > 0) {
+        flusher = thread(&AppendOnlyLog::flusherLoop, this);
+    }
+    return true;
+}
+
+// Stops the flusher, writes and syncs pending records, and closes the file
+void AppendOnlyLog::close() {
+    {
+        lock_guard<mutex> guard(batchLock);
+        stopping = true;  // No new appends from here on
+    }
+    flushSignal.notify_all();
+    if (flusher.joinable()) {
+        flusher.join();
+    }
+    commit();
+
+    lock_guard<mutex> writing(writeLock);
+    if (fd < 0) {
+        return;
+    }
+    if (unsynced && policy != FSYNC_NEVER) {
+        fsync(fd);
+        stats.fsyncs++;
+    }
+    ::close(fd);
+    fd = -1;
+    unsynced = false;
+}
+
+// Checks whether a file is open
+bool AppendOnlyLog::isOpen() const {
+    lock_guard<mutex> writing(writeLock);
+    return fd >= 0;
+}
+
+// Adds one record to the current batch, writing the batch when it is full
+bool AppendOnlyLog::append(const string& payload) {
+    bool full;
+    {
+        lock_guard<mutex> guard(batchLock);
+        if (stopping) {
+            return false;  // The log is closed
+        }
+        appendInt32(batch, static_cast<int32_t>(payload.size()));
+        appendInt32(batch, static_cast<int32_t>(checksum32(payload.data(), payload.size())));
+        batch.append(payload);
+        batchRecords++;
+        stats.records++;
+        full = batchRecords >= groupSize;
+    }
+    return full ? commit() : true;
+}
+
+// Writes the current batch in one call and applies the fsync policy
+bool AppendOnlyLog::commit() {
+    lock_guard<mutex> writing(writeLock);  // Taken first so batches are written in order
+    {
+        lock_guard<mutex> guard(batchLock);
+        spare.swap(batch);  // Appenders continue into the other buffer
+        batchRecords = 0;
+    }
+
+    bool ok = true;
+    if (!spare.empty()) {
+        ok = fd >= 0 && writeAll(spare);
+        if (ok) {
+            stats.commits++;
+            stats.bytes += spare.size();
+            unsynced = true;
+        } else {
+            cerr << "Failed to write log records" << endl;
+        }
+        spare.clear();  // Keeps its capacity for the next batch
+    }
+
+    if (ok && unsynced && fd >= 0) {
+        chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        bool due = policy == FSYNC_EACH_COMMIT
+                   || (policy == FSYNC_INTERVAL
+                       && now - lastSync >= chrono::milliseconds(flushIntervalMillis));
+        if (due) {
+            ok = fsync(fd) == 0;
+            stats.fsyncs++;
+            lastSync = now;
+            unsynced = false;
+        }
+    }
+    return ok;
+}
+
+// Commits and forces all written records to disk
+bool AppendOnlyLog::sync() {
+    if (!commit()) {
+        return false;
+    }
+    lock_guard<mutex> writing(writeLock);
+    if (fd < 0 || !unsynced) {
+        return fd >= 0;
+    }
+    bool ok = fsync(fd) == 0;
+    stats.fsyncs++;
+    lastSync = chrono::steady_clock::now();
+    unsynced = false;
+    return ok;
+}
+
+// Returns a snapshot of the counters
+LogStats AppendOnlyLog::getStats() const {
+    lock_guard<mutex> writing(writeLock);
+    lock_guard<mutex> guard(batchLock);
+    return stats;
+}
+
+// Reads the payloads of all valid records of a log file
+bool AppendOnlyLog::readRecords(const string& fileName, vector<string>& records) {
+    FILE* in = fopen(fileName.c_str(), "rb");
+    if (in == NULL) {
+        return false;
+    }
+    size_t fileSize, validEnd;
+    bool valid = scanFile(in, fileSize, validEnd, &records) && fileSize >= LOG_MAGIC_SIZE;
+    fclose(in);
+    return valid;
+}
+
+// Reads the records of a file one at a time up to the first torn or corrupted one
+bool AppendOnlyLog::scanFile(FILE* in, size_t& fileSize, size_t& validEnd, vector<string>* records) {
+    struct stat info;
+    if (fstat(fileno(in), &info) != 0) {
+        return false;
+    }
+    fileSize = info.st_size;
+    validEnd = 0;
+    char magic[LOG_MAGIC_SIZE];
+    size_t magicSize = fread(magic, 1, LOG_MAGIC_SIZE, in);
+    if (memcmp(magic, LOG_MAGIC, magicSize) != 0) {
+        return false;  // Not even the start of a log header
+    }
+    if (magicSize < LOG_MAGIC_SIZE) {
+        return true;  // Crashed while the header was being written
+    }
+    validEnd = LOG_MAGIC_SIZE;
+
+    setvbuf(in, NULL, _IOFBF, SCAN_BUFFER_SIZE);  // Records are read from the buffer, not one call each
+    string payload;  // Reused; holds one record at a time
+    char header[RECORD_HEADER_SIZE];
+    while (fread(header, 1, RECORD_HEADER_SIZE, in) == RECORD_HEADER_SIZE) {
+        BinaryReader reader(header, RECORD_HEADER_SIZE);
+        int32_t length = 0, checksum = 0;
+        reader.readInt32(length);
+        reader.readInt32(checksum);
+        size_t left = fileSize - validEnd - RECORD_HEADER_SIZE;
+        if (length < 0 || static_cast<size_t>(length) > left) {
+            break;  // Torn record, or a length no record of this file can have
+        }
+        payload.resize(length);
+        if ((length > 0 && fread(&payload[0], 1, length, in) != static_cast<size_t>(length))
+            || checksum32(payload.data(), length) != static_cast<uint32_t>(checksum)) {
+            break;  // Torn or corrupted record: the log ends here
+        }
+        if (records != NULL) {
+            records->push_back(payload);
+        }
+        validEnd += RECORD_HEADER_SIZE + length;
+    }
+    return true;
+}
+
+// Writes a whole buffer, retrying after partial writes and interrupts
+bool AppendOnlyLog::writeAll(const string& data) {
+    const char* next = data.data();
+    size_t left = data.size();
+    while (left > 0) {
+        ssize_t written = write(fd, next, left);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        next += written;
+        left -= written;
+    }
+    return true;
+}
+
+// Commits the batch once per flush interval until the log is closed
+void AppendOnlyLog::flusherLoop() {
+    unique_lock<mutex> guard(batchLock);
+    while (!stopping) {
+        flushSignal.wait_for(guard, chrono::milliseconds(flushIntervalMillis));
+        if (stopping) {
+            break;
+        }
+        guard.unlock();
+        commit();  // Also applies FSYNC_INTERVAL to data written earlier
+        guard.lock();
+    }
+}
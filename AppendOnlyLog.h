@@ -0,0 +1,221 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the AppendOnlyLog class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   AppendOnlyLog.cpp where the logic of each method is fully defined.
+   AppendOnlyLog.h contains the declaration of the AppendOnlyLog class.
+   This class is a binary file that records are only ever appended to. The
+   cost of persisting a record is proportional to the record, not to the
+   amount of data already in the file.
+
+   File format: an 8-byte magic header ("RMSLOG01") followed by records. Each
+   record is a 32-bit payload length, a 32-bit FNV-1a checksum of the payload
+   and the payload bytes. A record whose length or checksum does not match
+   (for example the last record of a crashed process) ends the log; open
+   truncates such a torn tail so new records follow the last good one.
+   Files are scanned one record at a time through a small read buffer, so
+   opening a large log needs no more memory than its largest record.
+
+   Group commit: append only copies the record into an in-memory batch. The
+   batch is written with a single write call when it reaches groupSize
+   records, when commit is called, or when the background flusher wakes up
+   (every flushIntervalMillis). Appenders are not blocked while a batch is
+   being written. The fsync policy decides how often written batches are
+   forced to disk:
+     - FSYNC_NEVER:       leave it to the operating system.
+     - FSYNC_EACH_COMMIT: fsync after every batch write.
+     - FSYNC_INTERVAL:    fsync at most once per flush interval.
+
+   Basic operations:
+     - Constructor: Sets the group size, fsync policy and flush interval.
+     - Destructor:  Closes the log.
+     - open:        Opens or creates a log file and starts the flusher.
+     - close:       Commits pending records, syncs and closes the file.
+     - isOpen:      Checks whether a file is open.
+     - append:      Adds one record to the current batch.
+     - commit:      Writes the current batch now.
+     - sync:        Commits and forces all written records to disk.
+     - getStats:    Returns record, batch, fsync and byte counters.
+     - readRecords: Reads every valid record of a log file.
+
+   Private utility:
+     - scanFile:    Reads the records of a file and finds the valid end.
+     - writeAll:    Writes a buffer, retrying partial writes.
+     - flusherLoop: Body of the background flusher thread.
+
+   Data members:
+     - fd:            File descriptor of the open log, or -1.
+     - groupSize, policy, flushIntervalMillis: Configuration.
+     - batch, batchRecords: Records appended but not yet written.
+     - spare:         Buffer swapped with the batch while it is written.
+     - unsynced:      Whether written data is waiting for an fsync.
+     - lastSync:      When the last fsync happened.
+     - stats:         Counters.
+     - batchLock:     Protects the batch and the record counter.
+     - writeLock:     Serializes batch writes so batches stay in order.
+     - stopping:      Set while the log is closed; appends are refused and
+                      the flusher exits.
+     - flushSignal, flusher: The background flusher.
+
+--------------------------------------------------------------------------*/
+
+#ifndef APPENDONLYLOG_H
+#define APPENDONLYLOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// When written batches are forced to disk.
+enum FsyncPolicy {
+    FSYNC_NEVER,        // Never call fsync; the operating system flushes eventually.
+    FSYNC_EACH_COMMIT,  // fsync after every batch write.
+    FSYNC_INTERVAL      // fsync at most once per flush interval.
+};
+
+// Counters reported by AppendOnlyLog::getStats.
+struct LogStats {
+    long long records;  // Records appended.
+    long long commits;  // Batch writes (one write call each).
+    long long fsyncs;   // fsync calls.
+    long long bytes;    // Bytes written, including record headers.
+};
+
+class AppendOnlyLog {
+public:
+    AppendOnlyLog(int groupSize = 64, FsyncPolicy policy = FSYNC_EACH_COMMIT, int flushIntervalMillis = 50);
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a closed log with the given commit settings.
+
+      Precondition:  groupSize is positive. flushIntervalMillis is zero (no
+                     background flusher) or positive.
+      Postcondition: The log is created; call open before appending.
+     -----------------------------------------------------------------------*/
+    ~AppendOnlyLog();
+    /*------------------------------------------------------------------------
+      Purpose:       Destructor: Closes the log.
+
+      Precondition:  None.
+      Postcondition: Pending records are written and the file is closed.
+     -----------------------------------------------------------------------*/
+    bool open(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Opens a log file for appending, creating it if needed.
+
+      Precondition:  The log is not open.
+      Postcondition: New records follow the last valid record in the file; a
+                     torn tail is truncated. Returns false if the file cannot
+                     be opened or is not a log file.
+     -----------------------------------------------------------------------*/
+    void close();
+    /*------------------------------------------------------------------------
+      Purpose:       Closes the log.
+
+      Precondition:  None.
+      Postcondition: Pending records are written and, unless the policy is
+                     FSYNC_NEVER, synced. The flusher is stopped.
+     -----------------------------------------------------------------------*/
+    bool isOpen() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Checks whether the log has an open file.
+
+      Precondition:  None.
+      Postcondition: Returns true if open has succeeded and close has not
+                     been called since.
+     -----------------------------------------------------------------------*/
+    bool append(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Appends one record. Safe to call from several threads.
+
+      Precondition:  None.
+      Postcondition: The record is in the current batch; the batch is written
+                     if it has reached groupSize records. Returns false if the
+                     log is closed or the write failed.
+     -----------------------------------------------------------------------*/
+    bool commit();
+    /*------------------------------------------------------------------------
+      Purpose:       Writes the current batch now.
+
+      Precondition:  None.
+      Postcondition: Every record appended before the call has been written
+                     to the file and synced as the policy requires. Returns
+                     false if the write failed.
+     -----------------------------------------------------------------------*/
+    bool sync();
+    /*------------------------------------------------------------------------
+      Purpose:       Commits and forces every written record to disk.
+
+      Precondition:  None.
+      Postcondition: Every record appended before the call is on disk,
+                     whatever the policy. Returns false on failure.
+     -----------------------------------------------------------------------*/
+    LogStats getStats() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the log counters.
+
+      Precondition:  None.
+      Postcondition: Returns a snapshot of the counters.
+     -----------------------------------------------------------------------*/
+    static bool readRecords(const string&, vector<string>&);
+    /*------------------------------------------------------------------------
+      Purpose:       Reads the payload of every valid record of a log file.
+
+      Precondition:  None.
+      Postcondition: The payloads are appended to the vector in file order,
+                     stopping at the first torn or corrupted record. Returns
+                     false if the file cannot be read or is not a log file.
+     -----------------------------------------------------------------------*/
+
+private:
+    AppendOnlyLog(const AppendOnlyLog&);            // Not copyable.
+    AppendOnlyLog& operator=(const AppendOnlyLog&);
+
+    static bool scanFile(FILE*, size_t&, size_t&, vector<string>*);
+    /*------------------------------------------------------------------------
+      Purpose:       Reads the records of a log file one at a time.
+
+      Precondition:  The file is open for reading at its start.
+      Postcondition: Sets fileSize to the size of the file and validEnd to
+                     the offset just past the last valid record (0 for a
+                     file shorter than the magic header) and, if records is
+                     not NULL, appends the payloads. Returns false if the
+                     file does not start with (a prefix of) the magic header.
+     -----------------------------------------------------------------------*/
+    bool writeAll(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Writes a whole buffer to the file.
+
+      Precondition:  writeLock is held.
+      Postcondition: Returns true if every byte was written.
+     -----------------------------------------------------------------------*/
+    void flusherLoop();
+    /*------------------------------------------------------------------------
+      Purpose:       Periodically commits the batch and applies the fsync policy.
+
+      Precondition:  Runs on the flusher thread.
+      Postcondition: Returns once close has set `stopping`.
+     -----------------------------------------------------------------------*/
+
+    int fd;                    // Open log file, or -1.
+    int groupSize;             // Records per batch before it is written.
+    FsyncPolicy policy;        // When written batches are synced.
+    int flushIntervalMillis;   // Flusher period; 0 disables the flusher.
+    string batch;              // Encoded records not yet written.
+    int batchRecords;          // Number of records in the batch.
+    string spare;              // Buffer being written; reused as the next batch.
+    bool unsynced;             // Written data not yet synced.
+    chrono::steady_clock::time_point lastSync; // Time of the last fsync.
+    LogStats stats;            // Counters.
+    mutable mutex batchLock;   // Protects batch, batchRecords, stats.records and stopping.
+    mutable mutex writeLock;   // Serializes writes; protects fd, spare, unsynced, lastSync
+                               // and the other counters.
+    condition_variable flushSignal; // Wakes the flusher early on close.
+    bool stopping;             // Log is closed; refuse appends, stop the flusher.
+    thread flusher;            // Background flusher thread.
+};
+
+#endif /* APPENDONLYLOG_H */
@@ -0,0 +1,525 @@
+// This is the implementation file for the BatchRunner class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, BatchRunner.h, provides the class structure and function declarations.
+
+//
+//  BatchRunner.cpp
+//
+
+#include "BatchRunner.h"
+#include <cerrno>
+#include <cstdlib>
+#include <iomanip>
+#include <utility>
+#include "OperationStats.h"
+
+// Splits a line at commas into trimmed fields, reusing the vector's strings
+static void splitFields(const string& line, vector<string>& fields) {
+    size_t count = 0;
+    size_t start = 0;
+    while (true) {
+        size_t comma = line.find(',', start);
+        size_t end = comma == string::npos ? line.size() : comma;
+        size_t first = start, last = end;
+        while (first < last && (line[first] == ' ' || line[first] == '\t')) {
+            first++;
+        }
+        while (last > first && (line[last - 1] == ' ' || line[last - 1] == '\t' || line[last - 1] == '\r')) {
+            last--;
+        }
+        if (count == fields.size()) {
+            fields.push_back(string());
+        }
+        fields[count++].assign(line, first, last - first);
+        if (comma == string::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    fields.resize(count);
+}
+
+// Parses a whole field as an integer
+static bool parseInt(const string& field, int& value) {
+    if (field.empty()) {
+        return false;
+    }
+    char* end;
+    errno = 0;
+    long parsed = strtol(field.c_str(), &end, 10);
+    if (*end != '\0' || errno != 0 || parsed < -2147483647L || parsed > 2147483647L) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// Parses a whole field as a price
+static bool parsePrice(const string& field, double& value) {
+    if (field.empty()) {
+        return false;
+    }
+    char* end;
+    value = strtod(field.c_str(), &end);
+    return *end == '\0' && value >= 0;
+}
+
+// Writes ": id name $price, ..." for up to limit of the items
+static void writeItemList(const DynamicArrayList& menu, const vector<int>& ids, size_t limit, ostream& out) {
+    for (size_t i = 0; i < ids.size() && i < limit; ++i) {
+        const MenuItem* item = menu.findMenuItem(ids[i]);
+        out << (i == 0 ? ": " : ", ") << ids[i] << ' ' << item->getName() << " $" << item->getPrice();
+    }
+    if (ids.size() > limit) {
+        out << ", ...";
+    }
+}
+
+// Constructor, binds the runner to the menu and the containers
+BatchRunner::BatchRunner(DynamicArrayList& menu, ActiveOrdersQueue& activeOrders,
+                         CompletedOrdersStack& completedOrders)
+    : menu(menu), activeOrders(activeOrders), completedOrders(completedOrders) {
+    menuJournal = NULL;
+    orderWal = NULL;
+    kitchen = NULL;
+    orderLog = NULL;
+    commandCount = 0;
+    errorCount = 0;
+}
+
+// Sets the journal that receives menu edits
+void BatchRunner::setMenuJournal(MenuJournal* journal) {
+    menuJournal = journal;
+}
+
+// Sets the write-ahead log that receives order changes
+void BatchRunner::setOrderWAL(OrderWAL* wal) {
+    orderWal = wal;
+}
+
+// Sets the log and files used by the save command
+void BatchRunner::setReportFiles(AppendOnlyLog* log, const string& logFile, const string& report) {
+    orderLog = log;
+    orderLogFile = logFile;
+    reportFile = report;
+}
+
+// Sets the worker pool that prepares processed orders
+void BatchRunner::setKitchen(KitchenWorkerPool* pool) {
+    kitchen = pool;
+}
+
+// Executes every command of the stream
+int BatchRunner::run(istream& in, ostream& out) {
+    commandCount = 0;
+    errorCount = 0;
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << fixed << setprecision(2);  // Prices, set once for the whole run
+
+    // With an order log, results wait here until the log holding their changes is synced
+    ostringstream pending;
+    ostream& results = orderWal != NULL ? static_cast<ostream&>(pending) : out;
+    pending << fixed << setprecision(2);
+
+    string line;
+    vector<string> fields;
+    long lineNumber = 0;
+    while (getline(in, line)) {
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos || line[first] == '#') {
+            continue;  // Blank line or comment
+        }
+        commandCount++;
+        if (!execute(line, fields, results)) {
+            errorCount++;
+            results << "  (line " << lineNumber << ")\n";
+        }
+        if (orderWal != NULL && commandCount % ACK_GROUP_SIZE == 0 && !releaseResults(pending, out)) {
+            errorCount++;
+        }
+    }
+    if (orderWal != NULL && !releaseResults(pending, out)) {
+        errorCount++;
+    }
+    waitForKitchen();  // The caller sees every processed order on the stack
+
+    out.flags(flags);
+    out.precision(precision);
+    return static_cast<int>(errorCount);
+}
+
+// Syncs the order log, then acknowledges the commands whose changes it holds
+bool BatchRunner::releaseResults(ostringstream& pending, ostream& out) {
+    bool synced = orderWal->sync();
+    if (synced) {
+        out << pending.str();
+    } else {
+        out << "error: order log could not be synced; results of this group withheld\n";
+    }
+    pending.str("");
+    return synced;
+}
+
+// Waits until the kitchen has pushed every order it was given
+void BatchRunner::waitForKitchen() {
+    if (kitchen != NULL) {
+        kitchen->waitUntilIdle();
+    }
+}
+
+// Returns how many commands the last run executed
+long BatchRunner::getCommandCount() const {
+    return commandCount;
+}
+
+// Returns how many commands of the last run failed
+long BatchRunner::getErrorCount() const {
+    return errorCount;
+}
+
+// Runs one command line
+bool BatchRunner::execute(const string& line, vector<string>& fields, ostream& out) {
+    splitFields(line, fields);
+    const string& command = fields[0];
+    if (command == "order") {
+        return placeOrder(fields, out);
+    } else if (command == "process") {
+        return process(fields, out);
+    } else if (command == "cancel") {
+        return cancel(fields, out);
+    } else if (command == "item") {
+        return addItem(fields, out);
+    } else if (command == "delete_item") {
+        return deleteItem(fields, out);
+    } else if (command == "price") {
+        return changePrice(fields, out);
+    } else if (command == "station") {
+        return changeStation(fields, out);
+    } else if (command == "search") {
+        return search(fields, out);
+    } else if (command == "price_range") {
+        return priceRange(fields, out);
+    } else if (command == "cheapest" || command == "priciest") {
+        return topByPrice(fields, out);
+    } else if (command == "report") {
+        return report(out);
+    } else if (command == "save") {
+        return save(out);
+    } else if (command == "stats") {
+        return stats(out);
+    } else if (command == "tickets") {
+        return tickets(fields, out);
+    } else if (command == "schedule") {
+        return schedule(fields, out);
+    }
+    out << "error: unknown command '" << command << "'";
+    return false;
+}
+
+// item,<name>,<description>,<price>[,<station>]
+bool BatchRunner::addItem(const vector<string>& fields, ostream& out) {
+    double price;
+    PrepStation station = STATION_LINE;
+    if ((fields.size() != 4 && fields.size() != 5) || fields[1].empty() || !parsePrice(fields[3], price)
+        || (fields.size() == 5 && !MenuItem::parseStation(fields[4], station))) {
+        out << "error: expected item,<name>,<description>,<price>[,<station>]";
+        return false;
+    }
+    waitForKitchen();  // The station router reads the menu while it routes an order
+    int id = menu.addMenuItem(MenuItem(fields[1], fields[2], price, station));
+    if (menuJournal) {
+        menuJournal->recordAdd(*menu.findMenuItem(id));
+    }
+    out << "item " << id << " added\n";
+    return true;
+}
+
+// delete_item,<id>
+bool BatchRunner::deleteItem(const vector<string>& fields, ostream& out) {
+    int id;
+    if (fields.size() != 2 || !parseInt(fields[1], id)) {
+        out << "error: expected delete_item,<id>";
+        return false;
+    }
+    waitForKitchen();
+    if (menu.findMenuItem(id) == NULL || !menu.deleteMenuItem(id)) {
+        out << "error: menu item " << id << " not found";
+        return false;
+    }
+    if (menuJournal) {
+        menuJournal->recordDelete(id);
+    }
+    out << "item " << id << " deleted\n";
+    return true;
+}
+
+// price,<id>,<price>
+bool BatchRunner::changePrice(const vector<string>& fields, ostream& out) {
+    int id;
+    double price;
+    if (fields.size() != 3 || !parseInt(fields[1], id) || !parsePrice(fields[2], price)) {
+        out << "error: expected price,<id>,<price>";
+        return false;
+    }
+    waitForKitchen();
+    if (!menu.updateMenuItemPrice(id, price)) {
+        out << "error: menu item " << id << " not found";
+        return false;
+    }
+    if (menuJournal) {
+        menuJournal->recordPriceChange(id, price);
+    }
+    out << "item " << id << " price " << price << '\n';
+    return true;
+}
+
+// station,<id>,<station>
+bool BatchRunner::changeStation(const vector<string>& fields, ostream& out) {
+    int id;
+    PrepStation station;
+    if (fields.size() != 3 || !parseInt(fields[1], id) || !MenuItem::parseStation(fields[2], station)) {
+        out << "error: expected station,<id>,<line|grill|fryer|cold|bar>";
+        return false;
+    }
+    waitForKitchen();
+    if (!menu.updateMenuItemStation(id, station)) {
+        out << "error: menu item " << id << " not found";
+        return false;
+    }
+    if (menuJournal) {
+        menuJournal->recordStationChange(id, station);
+    }
+    out << "item " << id << " station " << MenuItem::getStationName(station) << '\n';
+    return true;
+}
+
+// search,<query>[,<limit>]
+bool BatchRunner::search(const vector<string>& fields, ostream& out) {
+    int limit = 10;
+    if (fields.size() < 2 || fields.size() > 3
+        || (fields.size() == 3 && (!parseInt(fields[2], limit) || limit < 1))) {
+        out << "error: expected search,<query>[,<limit>]";
+        return false;
+    }
+    vector<int> ids;
+    int matches = menu.searchMenu(fields[1], ids, limit);
+    out << "search '" << fields[1] << "' " << matches << " matches";
+    for (size_t i = 0; i < ids.size(); ++i) {
+        out << (i == 0 ? ": " : ", ") << ids[i] << ' ' << menu.findMenuItem(ids[i])->getName();
+    }
+    out << '\n';
+    return true;
+}
+
+// price_range,<min>,<max>[,<station>]
+bool BatchRunner::priceRange(const vector<string>& fields, ostream& out) {
+    double minPrice, maxPrice;
+    PrepStation station = STATION_COUNT;  // Every station
+    if (fields.size() < 3 || fields.size() > 4 || !parsePrice(fields[1], minPrice)
+        || !parsePrice(fields[2], maxPrice)
+        || (fields.size() == 4 && !MenuItem::parseStation(fields[3], station))) {
+        out << "error: expected price_range,<min>,<max>[,<station>]";
+        return false;
+    }
+    vector<int> ids;
+    int count = menu.findItemsByPrice(minPrice, maxPrice, ids, station);
+    out << "price_range " << minPrice << '-' << maxPrice << ' ' << count << " items";
+    writeItemList(menu, ids, 20, out);
+    out << '\n';
+    return true;
+}
+
+// cheapest,<count>[,<station>] or priciest,<count>[,<station>]
+bool BatchRunner::topByPrice(const vector<string>& fields, ostream& out) {
+    int count;
+    PrepStation station = STATION_COUNT;
+    if (fields.size() < 2 || fields.size() > 3 || !parseInt(fields[1], count) || count < 1
+        || (fields.size() == 3 && !MenuItem::parseStation(fields[2], station))) {
+        out << "error: expected " << fields[0] << ",<count>[,<station>]";
+        return false;
+    }
+    vector<int> ids;
+    if (fields[0] == "cheapest") {
+        menu.findCheapestItems(count, ids, station);
+    } else {
+        menu.findPriciestItems(count, ids, station);
+    }
+    out << fields[0] << ' ' << ids.size() << " items";
+    writeItemList(menu, ids, ids.size(), out);
+    out << '\n';
+    return true;
+}
+
+// order,<customer>,<id> <id> ...[,<priority>]
+bool BatchRunner::placeOrder(const vector<string>& fields, ostream& out) {
+    OrderPriority priority = PRIORITY_NORMAL;
+    if ((fields.size() != 3 && fields.size() != 4)
+        || (fields.size() == 4 && !Order::parsePriority(fields[3], priority))) {
+        out << "error: expected order,<customer>,<item ids>[,<priority>]";
+        return false;
+    }
+    int ids[64];  // Read in groups so long orders need no extra storage
+    Order order(fields[1]);
+    order.setPriority(priority);
+    const char* next = fields[2].c_str();
+    while (*next != '\0') {
+        int count = 0;
+        while (*next != '\0' && count < 64) {
+            char* end;
+            long id = strtol(next, &end, 10);
+            if (end == next) {
+                out << "error: bad item ID list '" << fields[2] << "'";
+                return false;
+            }
+            if (menu.findMenuItem(static_cast<int>(id)) == NULL) {
+                out << "error: menu item " << id << " not found";
+                return false;  // Nothing is queued for a rejected order
+            }
+            ids[count++] = static_cast<int>(id);
+            next = end;
+            while (*next == ' ') {
+                next++;
+            }
+        }
+        order.addItems(ids, count, menu);
+    }
+    if (order.getItemCount() == 0) {
+        out << "error: order has no items";
+        return false;  // An empty ticket would only clutter the kitchen
+    }
+
+    double total = order.getTotalPrice();
+    int orderId = activeOrders.enqueue(std::move(order));
+    if (orderWal) {
+        orderWal->recordEnqueue(*activeOrders.findOrder(orderId));  // Logged before it is confirmed
+    }
+    out << "order " << orderId << " placed $" << total << '\n';
+    return true;
+}
+
+// process[,<count>]
+bool BatchRunner::process(const vector<string>& fields, ostream& out) {
+    int count = 1;
+    if (fields.size() > 2 || (fields.size() == 2 && (!parseInt(fields[1], count) || count < 1))) {
+        out << "error: expected process[,<count>]";
+        return false;
+    }
+    int processed = 0;
+    Order order;
+    while (processed < count && activeOrders.dequeue(order)) {
+        if (kitchen) {
+            kitchen->submit(std::move(order));  // The kitchen logs it as processed once it is done
+        } else {
+            order.setStatus("completed");
+            order.markCompleted();  // Logged with the same time the stack keeps
+            if (orderWal) {
+                orderWal->recordProcess(order);
+            }
+            completedOrders.push(std::move(order));
+        }
+        processed++;
+    }
+    out << "processed " << processed << '\n';
+    return true;
+}
+
+// cancel,<order id>
+bool BatchRunner::cancel(const vector<string>& fields, ostream& out) {
+    int orderId;
+    if (fields.size() != 2 || !parseInt(fields[1], orderId)) {
+        out << "error: expected cancel,<order id>";
+        return false;
+    }
+    if (!activeOrders.deleteOrder(orderId)) {
+        out << "error: order " << orderId << " not found";
+        return false;
+    }
+    if (orderWal) {
+        orderWal->recordCancel(orderId);
+    }
+    out << "order " << orderId << " cancelled\n";
+    return true;
+}
+
+// report
+bool BatchRunner::report(ostream& out) {
+    waitForKitchen();
+    out << "revenue $" << completedOrders.calculateTotalRevenue()
+        << " orders " << completedOrders.getSize()
+        << " items " << completedOrders.getTotalItemCount()
+        << " average $" << completedOrders.getAverageTicket()
+        << " active " << activeOrders.getSize() << '\n';
+    return true;
+}
+
+// stats
+bool BatchRunner::stats(ostream& out) {
+    waitForKitchen();
+    OperationStats::writeJson(out);  // One JSON line
+    return true;
+}
+
+// tickets[,<target minutes>]
+bool BatchRunner::tickets(const vector<string>& fields, ostream& out) {
+    int minutes = 0;
+    if (fields.size() > 2 || (fields.size() == 2 && (!parseInt(fields[1], minutes) || minutes < 0))) {
+        out << "error: expected tickets[,<target minutes>]";
+        return false;
+    }
+    waitForKitchen();
+    if (fields.size() == 2) {
+        completedOrders.setTicketTargetMillis(minutes * 60000LL);
+    }
+    TicketStats ticketStats = completedOrders.getTicketStats();
+    const LatencyHistogram& times = ticketStats.getTicketTimes();
+    out << "tickets " << times.getCount()
+        << " mean " << times.getMean() / 1000
+        << "s p50 " << times.getPercentile(0.5) / 1000.0
+        << "s p90 " << times.getPercentile(0.9) / 1000.0
+        << "s p99 " << times.getPercentile(0.99) / 1000.0
+        << "s max " << times.getMax() / 1000.0
+        << "s late " << ticketStats.getLateCount() << '\n';
+    return true;
+}
+
+// schedule,<fifo|priority>[,<aging minutes>]
+bool BatchRunner::schedule(const vector<string>& fields, ostream& out) {
+    int agingMinutes = static_cast<int>(ActiveOrdersQueue::DEFAULT_AGING_MILLIS / 60000);
+    if (fields.size() < 2 || fields.size() > 3 || (fields[1] != "fifo" && fields[1] != "priority")
+        || (fields.size() == 3 && (!parseInt(fields[2], agingMinutes) || agingMinutes < 0))) {
+        out << "error: expected schedule,<fifo|priority>[,<aging minutes>]";
+        return false;
+    }
+    activeOrders.setSchedulingMode(fields[1] == "fifo" ? SCHEDULE_FIFO : SCHEDULE_PRIORITY,
+                                   agingMinutes * 60000LL);
+    out << "schedule " << fields[1];
+    if (fields[1] == "priority") {
+        out << " aging " << agingMinutes << " min";
+    }
+    out << '\n';
+    return true;
+}
+
+// save
+bool BatchRunner::save(ostream& out) {
+    if (reportFile.empty()) {
+        out << "error: no report file";
+        return false;
+    }
+    waitForKitchen();  // Every processed order is in the log and the stack
+    bool saved;
+    if (orderLog != NULL && orderLog->isOpen()) {
+        orderLog->sync();  // Every logged order is on disk before the report is built
+        saved = CompletedOrdersStack::saveLogReportToFile(orderLogFile, reportFile, &menu);
+    } else {
+        saved = completedOrders.saveCompletedOrdersToFile(reportFile);
+    }
+    if (!saved) {
+        out << "error: could not save " << reportFile;
+        return false;
+    }
+    out << "saved " << reportFile << '\n';
+    return true;
+}
@@ -0,0 +1,228 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the BatchRunner class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   BatchRunner.cpp where the logic of each method is fully defined.
+   BatchRunner.h contains the declaration of the BatchRunner class.
+   This class drives the system without the interactive menu. It reads a
+   stream of commands, one per line, applies each one to the menu and the
+   order containers, and writes a short result line per command. Output is
+   written with '\n' and never flushed per command, so a whole day of traffic
+   runs at full speed. With an order log, result lines are held back and
+   released ACK_GROUP_SIZE commands at a time, each group only after the log
+   has been synced, so no order change is acknowledged before it is on disk.
+
+   Command format (fields separated by commas, like the menu file):
+     item,<name>,<description>,<price>[,<station>]
+                                         Add a menu item. The station is line, grill,
+                                         fryer, cold or bar (line if left out).
+     delete_item,<id>                    Delete a menu item.
+     price,<id>,<price>                  Change the price of a menu item.
+     station,<id>,<station>              Change the prep station of a menu item.
+     search,<query>[,<limit>]            List the best menu matches of a query (10 by default).
+     price_range,<min>,<max>[,<station>] Count the items within a price range and list the
+                                         cheapest 20.
+     cheapest,<count>[,<station>]        List the cheapest items, of one station or of all.
+     priciest,<count>[,<station>]        List the most expensive items.
+     order,<customer>,<id> <id> ...[,<priority>]
+                                         Place an order; IDs are space separated and at
+                                         least one is required. The priority is normal,
+                                         quick, vip or pickup.
+     process[,<count>]                   Process the next order (or up to count).
+     cancel,<order id>                   Cancel an active order.
+     report                              Print the revenue summary.
+     save                                Save the completed orders report.
+     stats                               Print the operation statistics as one JSON line.
+     tickets[,<target minutes>]          Print the ticket-time percentiles (and set the target).
+     schedule,<fifo|priority>[,<aging minutes>]
+                                         Choose how process picks the next order.
+   Blank lines and lines starting with '#' are skipped. A line that cannot be
+   parsed is reported as an error and the run continues.
+
+   Basic operations:
+     - Constructor:    Binds the runner to the menu and the order containers.
+     - setMenuJournal: Journals menu edits, as the interactive menu does.
+     - setOrderWAL:    Logs order changes before they are acknowledged.
+     - setReportFiles: Sets where save writes the completed orders report.
+     - setKitchen:     Hands processed orders to a kitchen worker pool (and its station router).
+     - run:            Executes a command stream.
+     - getCommandCount / getErrorCount: Counters of the last run.
+
+   Private utility:
+     - releaseResults: Syncs the order log and writes the held-back results.
+     - waitForKitchen: Waits until the kitchen has pushed every processed order.
+     - execute: Runs one command line.
+     - One method per command: addItem, deleteItem, changePrice, changeStation, search,
+       priceRange, topByPrice, placeOrder, process, cancel, report, save, stats, tickets, schedule.
+
+   Data members:
+     - menu, activeOrders, completedOrders: The state the commands change.
+     - menuJournal, orderWal: Optional persistence, or NULL.
+     - kitchen: Worker pool preparing processed orders, or NULL.
+     - orderLog, orderLogFile, reportFile: Where save reads and writes.
+     - commandCount, errorCount: Counters of the last run.
+
+--------------------------------------------------------------------------*/
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ActiveOrdersQueue.h"
+#include "AppendOnlyLog.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "KitchenWorkerPool.h"
+#include "MenuJournal.h"
+#include "OrderWAL.h"
+using namespace std;
+
+class BatchRunner {
+public:
+    static const int ACK_GROUP_SIZE = 256;  // Commands whose results wait for one log sync.
+
+    BatchRunner(DynamicArrayList&, ActiveOrdersQueue&, CompletedOrdersStack&);
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a runner for the given menu and order containers.
+
+      Precondition:  The menu and containers outlive the runner.
+      Postcondition: No journal, WAL or report files are set.
+     -----------------------------------------------------------------------*/
+    void setMenuJournal(MenuJournal*);
+    /*------------------------------------------------------------------------
+      Purpose:       Sets the journal that receives menu edits.
+
+      Precondition:  The journal belongs to the same menu, or is NULL.
+      Postcondition: Later item, delete_item, price and station commands are journaled.
+     -----------------------------------------------------------------------*/
+    void setOrderWAL(OrderWAL*);
+    /*------------------------------------------------------------------------
+      Purpose:       Sets the write-ahead log that receives order changes.
+
+      Precondition:  The log has been recovered into the same containers, or
+                     is NULL.
+      Postcondition: Later order, process and cancel commands are logged,
+                     and their result lines are written only once the log
+                     has been synced. The log should commit in groups of
+                     ACK_GROUP_SIZE records or fewer.
+     -----------------------------------------------------------------------*/
+    void setReportFiles(AppendOnlyLog*, const string&, const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Sets where the save command writes its report.
+
+      Precondition:  The log (or NULL) is the completed-order log stored in
+                     logFile.
+      Postcondition: save builds reportFile from the log when it is open,
+                     and from the completed stack otherwise.
+     -----------------------------------------------------------------------*/
+    void setKitchen(KitchenWorkerPool*);
+    /*------------------------------------------------------------------------
+      Purpose:       Sets the worker pool that prepares processed orders.
+
+      Precondition:  The pool is running and its orders end up on the same
+                     completed stack, directly or through a station router,
+                     or it is NULL. With an order log set, the pool logs
+                     completed orders to the same log (setOrderWAL), since
+                     process no longer logs them.
+      Postcondition: process hands orders to the pool instead of pushing
+                     them itself. report, save, stats and tickets first wait
+                     until the pool is idle, and so do item, delete_item,
+                     price and station, since a router reads the menu.
+     -----------------------------------------------------------------------*/
+    int run(istream&, ostream&);
+    /*------------------------------------------------------------------------
+      Purpose:       Executes every command of a stream.
+
+      Precondition:  None.
+      Postcondition: Each command has been applied in order and one result
+                     line per command has been written to the output, which
+                     is not flushed. With an order log, results are written
+                     in groups after each sync; a group whose sync fails is
+                     replaced by an error line and counted as an error.
+                     With a kitchen, every processed order has been pushed
+                     onto the completed stack when run returns. Returns the number of
+                     commands that failed.
+     -----------------------------------------------------------------------*/
+    long getCommandCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns how many commands the last run executed.
+
+      Precondition:  None.
+      Postcondition: Blank and comment lines are not counted.
+     -----------------------------------------------------------------------*/
+    long getErrorCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns how many commands of the last run failed.
+
+      Precondition:  None.
+      Postcondition: Returns the error counter.
+     -----------------------------------------------------------------------*/
+
+private:
+    BatchRunner(const BatchRunner&);            // Not copyable.
+    BatchRunner& operator=(const BatchRunner&);
+
+    bool releaseResults(ostringstream&, ostream&);
+    /*------------------------------------------------------------------------
+      Purpose:       Syncs the order log and writes the held-back results.
+
+      Precondition:  An order log is set.
+      Postcondition: The results are written to the output and cleared.
+                     If the log could not be synced, an error line is
+                     written instead of the results and false is returned.
+     -----------------------------------------------------------------------*/
+    void waitForKitchen();
+    /*------------------------------------------------------------------------
+      Purpose:       Waits until every processed order is on the completed stack.
+
+      Precondition:  None.
+      Postcondition: Returns at once when no kitchen is set.
+     -----------------------------------------------------------------------*/
+    bool execute(const string&, vector<string>&, ostream&);
+    /*------------------------------------------------------------------------
+      Purpose:       Runs one command line.
+
+      Precondition:  The line is not blank and not a comment. The vector is
+                     scratch space for the fields, reused between lines.
+      Postcondition: The command has been applied and its result written.
+                     Returns false if the line is not a valid command or
+                     the command failed.
+     -----------------------------------------------------------------------*/
+    bool addItem(const vector<string>&, ostream&);
+    bool deleteItem(const vector<string>&, ostream&);
+    bool changePrice(const vector<string>&, ostream&);
+    bool changeStation(const vector<string>&, ostream&);
+    bool search(const vector<string>&, ostream&);
+    bool priceRange(const vector<string>&, ostream&);
+    bool topByPrice(const vector<string>&, ostream&);
+    bool placeOrder(const vector<string>&, ostream&);
+    bool process(const vector<string>&, ostream&);
+    bool cancel(const vector<string>&, ostream&);
+    bool report(ostream&);
+    bool save(ostream&);
+    bool stats(ostream&);
+    bool tickets(const vector<string>&, ostream&);
+    bool schedule(const vector<string>&, ostream&);
+    /*------------------------------------------------------------------------
+      Purpose:       Run one command with its comma-separated fields.
+
+      Precondition:  fields[0] is the command name.
+      Postcondition: Same as execute.
+     -----------------------------------------------------------------------*/
+
+    DynamicArrayList& menu;                // Menu changed by item commands.
+    ActiveOrdersQueue& activeOrders;       // Queue changed by order commands.
+    CompletedOrdersStack& completedOrders; // Stack receiving processed orders.
+    MenuJournal* menuJournal;              // Journal for menu edits, or NULL.
+    OrderWAL* orderWal;                    // Write-ahead log for orders, or NULL.
+    KitchenWorkerPool* kitchen;            // Pool preparing processed orders, or NULL.
+    AppendOnlyLog* orderLog;               // Completed-order log read by save, or NULL.
+    string orderLogFile;                   // File of the completed-order log.
+    string reportFile;                     // File written by save.
+    long commandCount;                     // Commands executed by the last run.
+    long errorCount;                       // Commands of the last run that failed.
+};
+
+#endif /* BATCHRUNNER_H */
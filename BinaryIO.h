@@ -0,0 +1,248 @@
+/*--------------------------------------------------------------------------
+   This header provides small helpers for the binary record formats used by
+   the append-only logs. All functions are defined inline, so there is no
+   corresponding .cpp file.
+   Values are encoded in little-endian byte order with fixed widths, so a file
+   written on one machine can be read on another. Strings are written as a
+   32-bit length followed by the raw bytes.
+
+   Basic operations:
+     - appendInt32, appendInt64, appendDouble, appendString: Encode a value
+       at the end of a byte buffer.
+     - storeInt32, storeInt64, storeDouble, storeString: Encode a value at a
+       position the caller has already reserved, for encoders that know
+       their size up front.
+     - checksum32:  FNV-1a checksum used to detect torn or corrupted records.
+     - checksumWords: Checksum that consumes 8 bytes per step, for large
+       payloads such as snapshots.
+     - BinaryReader: Decodes values from a byte range, reporting failure
+       instead of reading past the end. skip and position let callers
+       step over or look at raw bytes.
+
+--------------------------------------------------------------------------*/
+
+#ifndef BINARYIO_H
+#define BINARYIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+using namespace std;
+
+// Appends a 32-bit integer in little-endian order.
+inline void appendInt32(string& out, int32_t value) {
+    uint32_t bits = static_cast<uint32_t>(value);
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+    out.append(bytes, 4);  // One append per value, not one per byte
+}
+
+// Appends a 64-bit integer in little-endian order.
+inline void appendInt64(string& out, int64_t value) {
+    uint64_t bits = static_cast<uint64_t>(value);
+    char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+    out.append(bytes, 8);
+}
+
+// Appends a double by its IEEE-754 bit pattern.
+inline void appendDouble(string& out, double value) {
+    int64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    appendInt64(out, bits);
+}
+
+// Appends a string as its length followed by its bytes.
+inline void appendString(string& out, const string& value) {
+    appendInt32(out, static_cast<int32_t>(value.size()));
+    out.append(value);
+}
+
+// Stores a 32-bit integer at `at` and returns the position after it.
+inline char* storeInt32(char* at, int32_t value) {
+    uint32_t bits = static_cast<uint32_t>(value);
+    for (int i = 0; i < 4; ++i) {
+        at[i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+    return at + 4;
+}
+
+// Stores a 64-bit integer at `at` and returns the position after it.
+inline char* storeInt64(char* at, int64_t value) {
+    uint64_t bits = static_cast<uint64_t>(value);
+    for (int i = 0; i < 8; ++i) {
+        at[i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+    return at + 8;
+}
+
+// Stores a double at `at` and returns the position after it.
+inline char* storeDouble(char* at, double value) {
+    int64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return storeInt64(at, bits);
+}
+
+// Stores a length-prefixed string at `at` and returns the position after it.
+inline char* storeString(char* at, const string& value) {
+    at = storeInt32(at, static_cast<int32_t>(value.size()));
+    memcpy(at, value.data(), value.size());
+    return at + value.size();
+}
+
+// Returns the 32-bit FNV-1a checksum of a byte range.
+inline uint32_t checksum32(const char* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Returns a 32-bit checksum of a byte range, mixing in 8 bytes per step.
+inline uint32_t checksumWords(const char* data, size_t length) {
+    uint64_t hash = 14695981039346656037ull ^ length;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));  // Host byte order; snapshots are not moved between hosts
+        hash = (hash ^ word) * 1099511628211ull;
+        hash ^= hash >> 29;
+    }
+    for (; i < length; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+    }
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+// Reads values written by the append functions from a byte range.
+class BinaryReader {
+public:
+    BinaryReader(const char* data, size_t length) : cursor(data), end(data + length) {}
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a reader over a byte range.
+
+      Precondition:  The range stays valid while the reader is used.
+      Postcondition: The reader is positioned at the start of the range.
+     -----------------------------------------------------------------------*/
+    explicit BinaryReader(const string& data) : cursor(data.data()), end(data.data() + data.size()) {}
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a reader over the bytes of a string.
+
+      Precondition:  The string is not modified while the reader is used.
+      Postcondition: The reader is positioned at the start of the string.
+     -----------------------------------------------------------------------*/
+
+    bool readInt32(int32_t& value) {
+        if (remaining() < 4) {
+            return false;
+        }
+        uint32_t bits = 0;
+        for (int i = 0; i < 4; ++i) {
+            bits |= static_cast<uint32_t>(static_cast<unsigned char>(cursor[i])) << (8 * i);
+        }
+        cursor += 4;
+        value = static_cast<int32_t>(bits);
+        return true;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Reads a 32-bit integer.
+
+      Precondition:  None.
+      Postcondition: Returns false, leaving the reader unchanged, if fewer
+                     than 4 bytes remain.
+     -----------------------------------------------------------------------*/
+    bool readInt64(int64_t& value) {
+        if (remaining() < 8) {
+            return false;
+        }
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) {
+            bits |= static_cast<uint64_t>(static_cast<unsigned char>(cursor[i])) << (8 * i);
+        }
+        cursor += 8;
+        value = static_cast<int64_t>(bits);
+        return true;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Reads a 64-bit integer.
+
+      Precondition:  None.
+      Postcondition: Returns false, leaving the reader unchanged, if fewer
+                     than 8 bytes remain.
+     -----------------------------------------------------------------------*/
+    bool readDouble(double& value) {
+        int64_t bits;
+        if (!readInt64(bits)) {
+            return false;
+        }
+        memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Reads a double.
+
+      Precondition:  None.
+      Postcondition: Returns false if fewer than 8 bytes remain.
+     -----------------------------------------------------------------------*/
+    bool readString(string& value) {
+        int32_t length;
+        if (!readInt32(length)) {
+            return false;
+        }
+        if (length < 0 || remaining() < static_cast<size_t>(length)) {
+            cursor -= 4;  // Leave the reader where it was
+            return false;
+        }
+        value.assign(cursor, length);
+        cursor += length;
+        return true;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Reads a length-prefixed string.
+
+      Precondition:  None.
+      Postcondition: Returns false, leaving the reader unchanged, if the
+                     length is invalid or the bytes are missing.
+     -----------------------------------------------------------------------*/
+    bool skip(size_t length) {
+        if (remaining() < length) {
+            return false;
+        }
+        cursor += length;
+        return true;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Skips over a number of bytes.
+
+      Precondition:  None.
+      Postcondition: Returns false, leaving the reader unchanged, if fewer
+                     than `length` bytes remain.
+     -----------------------------------------------------------------------*/
+    const char* position() const { return cursor; }
+    /*------------------------------------------------------------------------
+      Purpose:       Returns a pointer to the next unread byte.
+
+      Precondition:  None.
+      Postcondition: Returns the cursor.
+     -----------------------------------------------------------------------*/
+    size_t remaining() const { return end - cursor; }
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the number of unread bytes.
+
+      Precondition:  None.
+      Postcondition: Returns the distance from the cursor to the end.
+     -----------------------------------------------------------------------*/
+
+private:
+    const char* cursor;  // Next byte to read.
+    const char* end;     // One past the last byte.
+};
+
+#endif /* BINARYIO_H */
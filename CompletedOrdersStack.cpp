@@ -7,119 +7,246 @@
 //
 
 #include "CompletedOrdersStack.h"
+#include <algorithm>
 #include <cassert>
+#include <utility>
+#include <vector>
+#include "OperationStats.h"
 
-// Node constructor, initializes the order and sets the next pointer to NULL
-CompletedOrdersStack::Node::Node(const Order& order) {
-    this->order = order;  // Assign the order to the node
-    this->next = NULL;    // Initialize next to NULL
-}
+const int CompletedOrdersStack::CHUNK_SIZE;  // Out-of-class definition for use with std::min
+
+// First field of a log record for a popped order; order records start with an
+// order ID or a format tag of Order::writeBinary, and are longer than 8 bytes
+static const int32_t POP_RECORD = -1;
+static const size_t POP_RECORD_SIZE = 8;  // Tag and order ID
 
 // Default constructor, initializes an empty stack
 CompletedOrdersStack::CompletedOrdersStack() {
-    firstOrder = NULL;  // First order pointer is NULL
+    chunks = NULL;      // No chunks are allocated until the first push
+    chunkCount = 0;
+    chunkCapacity = 0;
     size = 0;           // Stack size is initially 0
-    top = NULL;         // Top of the stack is NULL
+    revenueCents = 0;   // No revenue yet
+    itemCount = 0;      // No items yet
+    orderLog = NULL;    // No log attached
+    freezeGeneration = 0;
+    freezesReleased.store(0);
 }
 
-// Destructor, clears all nodes in the stack
-CompletedOrdersStack::~CompletedOrdersStack() {
-    while (!isEmpty()) {
-        Node* temp = top;  // Temporarily hold the top node
-        top = top->next;   // Move top to the next node
-        delete temp;       // Delete the old top node
+// Constructor for an empty frozen copy
+CompletedOrdersStack::Frozen::Frozen() {
+    size = 0;
+    releaseCounter = NULL;
+}
+
+// Move constructor, takes over the chunks and the duty to release them
+CompletedOrdersStack::Frozen::Frozen(Frozen&& other) noexcept
+    : chunks(std::move(other.chunks)), size(other.size), releaseCounter(other.releaseCounter) {
+    other.size = 0;
+    other.releaseCounter = NULL;
+}
+
+// Destructor, releases the chunks if the owner has not done so yet
+CompletedOrdersStack::Frozen::~Frozen() {
+    release();
+}
+
+// Drops the shared chunks and tells the stack it no longer has to copy them
+void CompletedOrdersStack::Frozen::release() {
+    chunks.clear();
+    size = 0;
+    if (releaseCounter != NULL) {
+        releaseCounter->fetch_add(1, memory_order_release);  // Pairs with the acquire in writableSlot
+        releaseCounter = NULL;
     }
 }
 
+// Destructor, releases every chunk of orders
+CompletedOrdersStack::~CompletedOrdersStack() {
+    delete[] chunks;  // Each chunk is deleted with its last owner, which may be a frozen copy
+}
+
 // Returns the current size of the stack
 int CompletedOrdersStack::getSize() const {
+    lock_guard<mutex> guard(stackLock);
     return size;
 }
 
-// Pushes a new order onto the stack
+// Pushes a copy of a new order onto the stack
 void CompletedOrdersStack::push(const Order& order) {
-    NodePtr newOrder = new Node(order);  // Create a new node for the order
-    if (isEmpty()) {
-        firstOrder = newOrder;  // If the stack is empty, set firstOrder and top to the new node
-        top = newOrder;
-    } else {
-        top->next = newOrder;  // Otherwise, link the new node to the current top and update top
-        top = newOrder;
+    lock_guard<mutex> guard(stackLock);
+    Order& slot = nextSlot();
+    slot = order;  // Copies into the slot, reusing its line storage
+    slot.markCompleted();  // Keeps a time set by the caller
+    recordPush(slot);
+}
+
+// Moves a new order onto the stack
+void CompletedOrdersStack::push(Order&& order) {
+    lock_guard<mutex> guard(stackLock);
+    Order& slot = nextSlot();
+    slot = std::move(order);  // Takes over the order's strings and line items
+    slot.markCompleted();  // Keeps a time set by the caller
+    recordPush(slot);
+}
+
+// Moves a recovered order onto the stack without making up a completion time
+void CompletedOrdersStack::restoreOrder(Order&& order, bool logged) {
+    lock_guard<mutex> guard(stackLock);
+    Order& slot = nextSlot();
+    slot = std::move(order);
+    recordPush(slot, logged);
+}
+
+// Returns the slot above the top order, adding a chunk when all are full
+Order& CompletedOrdersStack::nextSlot() {
+    if (size == chunkCount * CHUNK_SIZE) {  // Every allocated chunk is full
+        if (chunkCount == chunkCapacity) {
+            // Double the chunk table; only the pointers are copied, never the orders
+            chunkCapacity = chunkCapacity == 0 ? 4 : chunkCapacity * 2;
+            Chunk* temp = new Chunk[chunkCapacity];
+            for (int c = 0; c < chunkCount; ++c) {
+                temp[c] = std::move(chunks[c]);
+            }
+            delete[] chunks;
+            chunks = temp;
+        }
+        chunks[chunkCount++] = Chunk(new Order[CHUNK_SIZE]);  // Add a new chunk
+        chunkStamps.push_back(freezeGeneration);               // No frozen copy has seen it
     }
+    return writableSlot(size);
+}
+
+// Returns a slot that may be changed, copying its chunk first if a frozen copy shares it
+Order& CompletedOrdersStack::writableSlot(int index) {
+    int c = index / CHUNK_SIZE;
+    Chunk& chunk = chunks[c];
+    // Shared if a freeze came after the chunk became the stack's own and is not released yet.
+    // The acquire makes the released copy's last reads happen before the write that follows.
+    if (chunkStamps[c] < freezeGeneration && freezesReleased.load(memory_order_acquire) < freezeGeneration) {
+        // A background snapshot may still read this chunk; the stack continues on a copy
+        Chunk copy(new Order[CHUNK_SIZE]);
+        for (int i = 0; i < CHUNK_SIZE; ++i) {
+            copy[i] = chunk[i];
+        }
+        chunk = std::move(copy);
+        chunkStamps[c] = freezeGeneration;
+    }
+    return chunk[index % CHUNK_SIZE];
+}
+
+// Counts an order stored at the top and appends it to the log
+void CompletedOrdersStack::recordPush(const Order& order, bool logged) {
     size++;  // Increment the stack size
+    revenueCents += order.getTotalCents();  // Update the running totals
+    itemCount += order.getItemCount();
+    ticketStats.record(order);
+
+    if (orderLog != NULL && !logged) {
+        string record;
+        order.writeBinary(record);
+        orderLog->append(record);  // Group commit writes it with its neighbours
+    }
 }
 
 // Checks if the stack is empty
 bool CompletedOrdersStack::isEmpty() const {
-    return firstOrder == NULL;  // Return true if firstOrder is NULL
+    lock_guard<mutex> guard(stackLock);
+    return size == 0;  // Return true if no orders are stored
 }
 
 // Pops the top order from the stack and returns it
-const Order& CompletedOrdersStack::pop() {
-    assert(!isEmpty());  // Ensure the stack is not empty
-
-    // If there is only one order in the stack
-    if (firstOrder->next == NULL) {
-        const Order& popOrder = firstOrder->order;  // Retrieve the order
-        delete firstOrder;  // Delete the single node
-        firstOrder = NULL;  // Reset pointers
-        top = NULL;
-        size--;  // Decrement the stack size
-        return popOrder;
-    }
-
-    // Traverse the stack to find the second-to-last node
-    NodePtr temp = firstOrder;
-    while (temp->next != top) {
-        temp = temp->next;
-    }
-    const Order& popOrder = top->order;  // Retrieve the top order
-    temp->next = NULL;  // Update the second-to-last node's next pointer
-    delete top;  // Delete the old top node
-    top = temp;  // Update the top pointer
+Order CompletedOrdersStack::pop() {
+    lock_guard<mutex> guard(stackLock);
+    assert(size > 0);  // Ensure the stack is not empty
+
     size--;  // Decrement the stack size
-    return popOrder;
+    Order& top = writableSlot(size);
+    revenueCents -= top.getTotalCents();  // Update the running totals
+    itemCount -= top.getItemCount();
+    ticketStats.remove(top);
+    if (orderLog != NULL) {
+        string record;  // The report drops the order again
+        appendInt32(record, POP_RECORD);
+        appendInt32(record, top.getOrderId());
+        orderLog->append(record);
+    }
+    // Move the order out; the emptied slot is reused by the next push
+    return std::move(top);
 }
 
 // Displays the prices of all completed orders
 void CompletedOrdersStack::displayOrderPrice() {
-    NodePtr temp = firstOrder;  // Start from the first order
-    while (temp != NULL) {
-        cout << "Order " << temp->order.getOrderId() << ": $"
-             << temp->order.getTotalPrice() << endl;  // Display order ID and price
-        temp = temp->next;  // Move to the next node
+    lock_guard<mutex> guard(stackLock);
+    for (int c = 0; c * CHUNK_SIZE < size; ++c) {  // Walk the chunks from the first order
+        const Order* chunk = chunks[c].get();
+        int count = min(CHUNK_SIZE, size - c * CHUNK_SIZE);
+        for (int i = 0; i < count; ++i) {
+            cout << "Order " << chunk[i].getOrderId() << ": $"
+                 << chunk[i].getTotalPrice() << endl;  // Display order ID and price
+        }
     }
 }
 
-// Calculates the total revenue from all completed orders
+// Returns the total revenue from all completed orders
 double CompletedOrdersStack::calculateTotalRevenue() const {
-    double totalPrice = 0;  // Initialize total revenue
-    if (isEmpty()) {
-        return 0;  // Return 0 if the stack is empty
+    lock_guard<mutex> guard(stackLock);
+    return revenueCents / 100.0;  // Kept up to date by push and pop
+}
+
+// Returns the exact total revenue in cents
+long long CompletedOrdersStack::getTotalRevenueCents() const {
+    lock_guard<mutex> guard(stackLock);
+    return revenueCents;
+}
+
+// Returns the number of items in all completed orders
+long CompletedOrdersStack::getTotalItemCount() const {
+    lock_guard<mutex> guard(stackLock);
+    return itemCount;
+}
+
+// Returns the average revenue per completed order
+double CompletedOrdersStack::getAverageTicket() const {
+    lock_guard<mutex> guard(stackLock);
+    if (size == 0) {
+        return 0;
     }
-    NodePtr temp = firstOrder;  // Start from the first order
-    while (temp != NULL) {
-        totalPrice += temp->order.getTotalPrice();  // Accumulate order prices
-        temp = temp->next;  // Move to the next node
+    return revenueCents / 100.0 / size;
+}
+
+// Recomputes the total revenue by walking every completed order
+long long CompletedOrdersStack::recalculateTotalRevenueCents() const {
+    lock_guard<mutex> guard(stackLock);
+    long long totalCents = 0;  // Initialize total revenue
+    for (int c = 0; c * CHUNK_SIZE < size; ++c) {  // Walk the chunks from the first order
+        const Order* chunk = chunks[c].get();
+        int count = min(CHUNK_SIZE, size - c * CHUNK_SIZE);
+        for (int i = 0; i < count; ++i) {
+            totalCents += chunk[i].getTotalCents();  // Accumulate order totals
+        }
     }
-    return totalPrice;  // Return the total revenue
+    return totalCents;
 }
 
 // Displays all completed orders
 void CompletedOrdersStack::displayCompletedOrders() const {
-    if (isEmpty()) {
+    lock_guard<mutex> guard(stackLock);
+    if (size == 0) {
         cout << "No completed orders." << endl;  // Display message if the stack is empty
         return;
     }
-    NodePtr temp = firstOrder;  // Start from the first order
-    while (temp != NULL) {
-        cout << temp->order << endl;  // Display the order details
-        temp = temp->next;  // Move to the next node
+    for (int c = 0; c * CHUNK_SIZE < size; ++c) {  // Walk the chunks from the first order
+        const Order* chunk = chunks[c].get();
+        int count = min(CHUNK_SIZE, size - c * CHUNK_SIZE);
+        for (int i = 0; i < count; ++i) {
+            cout << chunk[i] << endl;  // Display the order details
+        }
     }
 }
 
 // Prints the current date to the provided output stream
-void CompletedOrdersStack::printTime(ostream& out) const {
+void CompletedOrdersStack::printTime(ostream& out) {
     time_t now = time(0);  // Get the current time
     tm* localTime = localtime(&now);  // Convert to local time
 
@@ -131,21 +258,224 @@ void CompletedOrdersStack::printTime(ostream& out) const {
 
 // Saves all completed orders to a file
 bool CompletedOrdersStack::saveCompletedOrdersToFile(const string& filename) const {
+    STATS_TIMER(timer, STAT_SAVE_COMPLETED);
     ofstream file(filename.c_str());  // Open the file
     if (!file) {
-        cerr << "Error opening file: " << filename << endl;  // Display error message if file can't be opened
-        return false;
+        return false;  // The caller reports the error
     }
 
+    lock_guard<mutex> guard(stackLock);
     printTime(file);  // Print the date to the file
     file << "--- Completed Orders ---\n";  // Write a header to the file
-    NodePtr temp = firstOrder;  // Start from the first order
-    while (temp != NULL) {
-        file << temp->order << endl;  // Write each order to the file
-        temp = temp->next;  // Move to the next node
+    for (int c = 0; c * CHUNK_SIZE < size; ++c) {  // Walk the chunks from the first order
+        const Order* chunk = chunks[c].get();
+        int count = min(CHUNK_SIZE, size - c * CHUNK_SIZE);
+        for (int i = 0; i < count; ++i) {
+            file << chunk[i] << '\n';  // Write each order to the file
+        }
     }
 
+    STATS_ADD_BYTES(timer, file.tellp());
     file.close();  // Close the file
-    cout << "Orders have been saved to " << filename << endl;  // Display success message
-    return true;  // Return true on success
+    return true;  // The caller reports the result
+}
+
+// Attaches the binary log that receives pushed orders
+void CompletedOrdersStack::setOrderLog(AppendOnlyLog* log) {
+    lock_guard<mutex> guard(stackLock);
+    orderLog = log;
+}
+
+// Writes the text report of every order in a binary log
+bool CompletedOrdersStack::saveLogReportToFile(const string& logFile, const string& reportFile,
+                                               const DynamicArrayList* menu) {
+    STATS_TIMER(timer, STAT_SAVE_LOG_REPORT);
+    vector<string> records;
+    if (!AppendOnlyLog::readRecords(logFile, records)) {
+        return false;  // The caller reports the error
+    }
+    ofstream file(reportFile.c_str());
+    if (!file) {
+        return false;
+    }
+
+    vector<size_t> live;
+    findLiveRecords(records, live);
+
+    printTime(file);  // Same layout as saveCompletedOrdersToFile
+    file << "--- Completed Orders ---\n";
+    Order order;
+    for (size_t i = 0; i < live.size(); ++i) {
+        BinaryReader reader(records[live[i]]);
+        if (order.readBinary(reader, menu)) {
+            file << order << '\n';
+        }
+    }
+
+    STATS_ADD_BYTES(timer, file.tellp());
+    file.close();
+    return true;  // The caller reports the result
+}
+
+// Collects the IDs of the orders a binary log still holds
+bool CompletedOrdersStack::readLoggedOrderIds(const string& logFile, unordered_set<int>& ids) {
+    vector<string> records;
+    if (!AppendOnlyLog::readRecords(logFile, records)) {
+        return false;
+    }
+    vector<size_t> live;
+    findLiveRecords(records, live);
+    Order order;  // Reused, so its line buffer is allocated once
+    for (size_t i = 0; i < live.size(); ++i) {
+        BinaryReader reader(records[live[i]]);
+        if (order.readBinary(reader, NULL)) {
+            ids.insert(order.getOrderId());
+        }
+    }
+    return true;
+}
+
+// Replays the pushes and pops of a log to find the orders it still holds
+void CompletedOrdersStack::findLiveRecords(const vector<string>& records, vector<size_t>& live) {
+    for (size_t i = 0; i < records.size(); ++i) {
+        BinaryReader reader(records[i]);
+        int32_t tag = 0;
+        if (records[i].size() == POP_RECORD_SIZE && reader.readInt32(tag) && tag == POP_RECORD) {
+            if (!live.empty()) {
+                live.pop_back();  // pop always removes the newest order
+            }
+        } else {
+            live.push_back(i);
+        }
+    }
+}
+
+// Appends every order to a binary snapshot buffer
+void CompletedOrdersStack::writeBinary(string& out) const {
+    lock_guard<mutex> guard(stackLock);
+    writeChunks(chunks, size, out);
+}
+
+// Returns the orders now in the stack, sharing their chunks instead of copying them
+CompletedOrdersStack::Frozen CompletedOrdersStack::freeze() const {
+    lock_guard<mutex> guard(stackLock);
+    Frozen frozen;
+    frozen.chunks.assign(chunks, chunks + (size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    frozen.size = size;
+    frozen.releaseCounter = &freezesReleased;
+    freezeGeneration++;  // Every chunk now counts as shared until this copy is released
+    return frozen;
+}
+
+// Appends the frozen orders in the format of CompletedOrdersStack::writeBinary
+void CompletedOrdersStack::Frozen::writeBinary(string& out) const {
+    writeChunks(chunks.data(), size, out);
+}
+
+// Returns the number of frozen orders
+int CompletedOrdersStack::Frozen::getSize() const {
+    return size;
+}
+
+// Writes the order count and the first `count` orders of a chunk table
+void CompletedOrdersStack::writeChunks(const Chunk* table, int count, string& out) {
+    appendInt32(out, count);
+    for (int c = 0; c * CHUNK_SIZE < count; ++c) {  // Walk the chunks from the first order
+        const Order* chunk = table[c].get();
+        int inChunk = min(CHUNK_SIZE, count - c * CHUNK_SIZE);
+        for (int i = 0; i < inChunk; ++i) {
+            chunk[i].writeBinary(out);
+        }
+    }
+}
+
+// Replaces the stack with one read from a binary snapshot
+bool CompletedOrdersStack::readBinary(BinaryReader& in, const DynamicArrayList* menu) {
+    int32_t count;
+    if (!in.readInt32(count) || count < 0
+        || static_cast<size_t>(count) > in.remaining() / Order::MIN_BINARY_SIZE) {
+        return false;  // More orders than the remaining bytes could hold
+    }
+
+    // Decode straight into a new chunk table, adding chunks as orders decode; orders are never copied
+    int newChunkCapacity = max((count + CHUNK_SIZE - 1) / CHUNK_SIZE, 4);  // Only pointers up front
+    Chunk* newChunks = new Chunk[newChunkCapacity];
+    int newChunkCount = 0;
+    long long newRevenue = 0;
+    long newItems = 0;
+    int decoded = 0;
+    while (decoded < count) {
+        if (decoded == newChunkCount * CHUNK_SIZE) {
+            newChunks[newChunkCount++] = Chunk(new Order[CHUNK_SIZE]);
+        }
+        Order& order = newChunks[decoded / CHUNK_SIZE][decoded % CHUNK_SIZE];
+        if (!order.readBinary(in, menu)) {
+            break;
+        }
+        newRevenue += order.getTotalCents();
+        newItems += order.getItemCount();
+        decoded++;
+    }
+    if (decoded < count) {
+        delete[] newChunks;  // Incomplete snapshot: keep the current stack
+        return false;
+    }
+
+    // Only swapping the decoded chunks in needs the lock
+    lock_guard<mutex> guard(stackLock);
+    delete[] chunks;  // A frozen copy keeps the old chunks it shares
+    chunks = newChunks;
+    chunkCount = newChunkCount;
+    chunkStamps.assign(newChunkCount, freezeGeneration);  // The new chunks are not shared
+    chunkCapacity = newChunkCapacity;
+    size = count;
+    revenueCents = newRevenue;
+    itemCount = newItems;
+    recountTicketStats();
+    return true;
+}
+
+// Exchanges the orders of two stacks; the logs and ticket targets stay put
+void CompletedOrdersStack::swap(CompletedOrdersStack& other) {
+    lock(stackLock, other.stackLock);  // Both at once, so two swapping threads cannot deadlock
+    lock_guard<mutex> guard(stackLock, adopt_lock);
+    lock_guard<mutex> otherGuard(other.stackLock, adopt_lock);
+    assert(freezesReleased.load() == freezeGeneration);  // No frozen copy shares the chunks
+    assert(other.freezesReleased.load() == other.freezeGeneration);
+    std::swap(chunks, other.chunks);
+    std::swap(chunkCount, other.chunkCount);
+    chunkStamps.swap(other.chunkStamps);
+    chunkStamps.assign(chunkCount, freezeGeneration);  // Nothing is shared, so only the counts matter
+    other.chunkStamps.assign(other.chunkCount, other.freezeGeneration);
+    std::swap(chunkCapacity, other.chunkCapacity);
+    std::swap(size, other.size);
+    std::swap(revenueCents, other.revenueCents);
+    std::swap(itemCount, other.itemCount);
+    recountTicketStats();
+    other.recountTicketStats();
+}
+
+// Returns a copy of the ticket-time statistics, taken under the lock
+TicketStats CompletedOrdersStack::getTicketStats() const {
+    lock_guard<mutex> guard(stackLock);
+    return ticketStats;
+}
+
+// Sets the target ticket time and recounts the late orders
+void CompletedOrdersStack::setTicketTargetMillis(long long millis) {
+    lock_guard<mutex> guard(stackLock);
+    ticketStats.setTargetMillis(millis);
+    recountTicketStats();
+}
+
+// Rebuilds the ticket statistics by walking every order
+void CompletedOrdersStack::recountTicketStats() {
+    ticketStats.clear();
+    for (int c = 0; c * CHUNK_SIZE < size; ++c) {  // Walk the chunks from the first order
+        const Order* chunk = chunks[c].get();
+        int count = min(CHUNK_SIZE, size - c * CHUNK_SIZE);
+        for (int i = 0; i < count; ++i) {
+            ticketStats.record(chunk[i]);
+        }
+    }
 }
@@ -7,28 +7,84 @@
    the most recently completed order is always at the top of the stack. The stack follows
    the LIFO (Last-In-First-Out) principle, providing efficient management of completed
    orders.
+   Orders are stored in fixed-size chunks of contiguous Order objects. Push and pop
+   work at the end of the last chunk, so both take constant time, and growing the
+   stack never moves orders that are already stored. Traversals walk each chunk
+   sequentially, which keeps memory access predictable.
+   Running totals (revenue in cents and item count) are updated on every push
+   and pop, so revenue queries take constant time however many orders the day
+   has accumulated.
+   An AppendOnlyLog can be attached with setOrderLog. Every pushed order is then
+   appended to it in binary form, and every pop as a short removal record, so
+   persisting completed orders costs time in proportion to the changes only.
+   saveLogReportToFile turns such a log back into the same text report
+   saveCompletedOrdersToFile writes.
+   Every pushed order is stamped as completed, if it is not already, and its
+   wait, cook and ticket times are added to a TicketStats, so ticket-time
+   percentiles are available at any moment without walking the stack.
+   Every public method holds the stack's mutex while it runs, so kitchen
+   worker threads can push completed orders while the main thread reads the
+   totals or saves a report.
+   Chunks are reference counted. freeze returns the orders of the moment as a
+   Frozen copy that shares the chunks instead of copying the orders, so a
+   snapshot can encode them on another thread. A chunk still shared with a
+   frozen copy is copied before push or pop changes it (copy-on-write).
+   Whether a chunk is shared is decided by generation counters, not by the
+   reference count: freeze counts a new generation under the lock, and the
+   frozen copy releases it, with release ordering, once it is done reading.
 
    Basic operations:
      - Constructor: Constructs an empty CompletedOrdersStack.
      - Destructor:  Releases all dynamically allocated memory used by the stack.
      - getSize:     Returns the total number of orders in the stack.
-     - push:        Adds a new order to the top of the stack.
-     - pop:         Removes and retrieves the order at the top of the stack.
+     - push:        Adds a new order to the top of the stack; a temporary order
+                    is moved in instead of copied.
+     - restoreOrder: Pushes a recovered order keeping its stamps; an unset completion stays unset.
+                    An order the attached log already holds is not appended again.
+     - pop:         Removes the order at the top of the stack and moves it out to the caller.
      - isEmpty:     Checks if the stack contains any orders.
-     - calculateTotalRevenue: Computes the total revenue generated from all completed orders.
+     - calculateTotalRevenue: Returns the total revenue generated from all completed orders.
+     - getTotalRevenueCents: Returns the exact total revenue in cents.
+     - getTotalItemCount: Returns the number of items in all completed orders.
+     - getAverageTicket: Returns the average revenue per completed order.
+     - recalculateTotalRevenueCents: Recomputes the revenue by walking every order.
      - displayCompletedOrders: Displays all orders in the stack with their details.
      - displayOrderPrice: Displays the price of each order in the stack.
      - printTime:   Outputs the completion times of all orders.
      - saveCompletedOrdersToFile: Saves all completed orders to a specified file for record-keeping.
+     - setOrderLog: Attaches a binary log that receives every push and pop.
+     - saveLogReportToFile: Writes the text report of every order in a binary log.
+     - readLoggedOrderIds: Collects the IDs of the orders a binary log still holds.
+     - writeBinary: Appends every order to a binary snapshot buffer.
+     - readBinary:  Replaces the stack with one written by writeBinary.
+     - swap:        Exchanges the orders of two stacks.
+     - freeze:      Returns the orders now in the stack as a Frozen copy sharing its chunks.
+     - getTicketStats: Returns a copy of the ticket-time statistics of the stack.
+     - setTicketTargetMillis: Sets the target ticket time and recounts late orders.
 
    Private utility:
-     - Node: Represents a single node in the stack, storing an Order object and a pointer
-             to the next node in the sequence.
+     - CHUNK_SIZE: The number of orders held by each chunk.
+     - Chunk:      A reference-counted array of CHUNK_SIZE orders.
+     - nextSlot:   Returns the slot above the top order, adding a chunk if needed.
+     - writableSlot: Returns a slot, copying its chunk first if a frozen copy shares it.
+     - writeChunks: Encodes the first orders of a chunk table.
+     - recordPush: Updates the running totals and the log for a pushed order.
+     - findLiveRecords: Replays the pushes and pops of a log to find the orders it still holds.
+     - recountTicketStats: Rebuilds the ticket-time statistics from every order.
 
    Data members:
-     - firstOrder: Pointer to the first order in the stack (used for traversal if needed).
-     - top:        Pointer to the top node of the stack (most recently added order).
-     - size:       Tracks the total number of orders currently in the stack.
+     - chunks:        Table of the chunks of orders, oldest first.
+     - chunkCount:    The number of chunks currently allocated.
+     - chunkCapacity: The number of entries in the chunk table.
+     - chunkStamps:   The freeze generation at which each chunk became the stack's own.
+     - freezeGeneration: The number of frozen copies handed out.
+     - freezesReleased:  The number of frozen copies released.
+     - size:          Tracks the total number of orders currently in the stack.
+     - revenueCents:  Running total of the revenue of all orders, in cents.
+     - itemCount:     Running total of the items in all orders.
+     - orderLog:      Binary log receiving pushed and popped orders, or NULL.
+     - ticketStats:   Wait, cook and ticket times of the orders in the stack.
+     - stackLock:     Serializes every public method.
 
    Overloaded operators:
      - ostream& operator<<: Overloads the `<<` operator for printing order details, ensuring
@@ -38,18 +94,85 @@
 
 #ifndef COMPLETEDORDERSSTACK_H
 #define COMPLETEDORDERSSTACK_H
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include "AppendOnlyLog.h"
 #include "Order.h"
+#include "TicketStats.h"
 using namespace std;
 
 class CompletedOrdersStack{
 public:
+    // The orders of a stack at one moment, sharing the stack's chunks.
+    class Frozen {
+    public:
+        Frozen();
+        /*------------------------------------------------------------------------
+            Purpose:       Constructs an empty frozen copy.
+
+            Precondition:  None.
+            Postcondition: getSize returns 0.
+        ------------------------------------------------------------------------*/
+        Frozen(Frozen&&) noexcept;
+        /*------------------------------------------------------------------------
+            Purpose:       Moves a frozen copy, for example onto a writer thread.
+
+            Precondition:  None.
+            Postcondition: This copy holds the orders and must release them;
+                           `other` is empty and released.
+        ------------------------------------------------------------------------*/
+        ~Frozen();
+        /*------------------------------------------------------------------------
+            Purpose:       Destructor: Releases the copy if release was not called.
+
+            Precondition:  The stack it was frozen from still exists.
+            Postcondition: The chunks are no longer shared by this copy.
+        ------------------------------------------------------------------------*/
+        void release();
+        /*------------------------------------------------------------------------
+            Purpose:       Ends the copy's use of the stack's chunks.
+
+            Precondition:  Called on the thread that read the copy, after its
+                           last read. The stack still exists.
+            Postcondition: The copy is empty. Once every frozen copy is
+                           released, push and pop stop copying chunks.
+        ------------------------------------------------------------------------*/
+        void writeBinary(string&) const;
+        /*------------------------------------------------------------------------
+            Purpose:       Serializes the frozen orders for a binary snapshot.
+
+            Precondition:  None. Safe to call on any thread while the stack
+                           keeps changing.
+            Postcondition: The buffer holds what CompletedOrdersStack::writeBinary
+                           would have appended when the copy was frozen.
+        ------------------------------------------------------------------------*/
+        int getSize() const;
+        /*------------------------------------------------------------------------
+            Purpose:       Returns the number of frozen orders.
+
+            Precondition:  None.
+            Postcondition: Returns the stack size when the copy was frozen.
+        ------------------------------------------------------------------------*/
+    private:
+        friend class CompletedOrdersStack;
+        Frozen(const Frozen&);               // Not copyable: each copy is released once.
+        Frozen& operator=(const Frozen&);
+
+        vector<shared_ptr<Order[]> > chunks; // The shared chunks holding the orders.
+        int size;                            // Number of orders frozen.
+        atomic<int>* releaseCounter;         // The stack's freezesReleased, or NULL once released.
+    };
+
     CompletedOrdersStack();
     /*------------------------------------------------------------------------
         Purpose:       Constructs an empty CompletedOrdersStack.
 
         Precondition:  None.
-        Postcondition: An empty stack has been created, with `top` set to nullptr
+        Postcondition: An empty stack has been created with no chunks allocated
                      and `size` initialized to 0.
     ------------------------------------------------------------------------*/
     ~CompletedOrdersStack();
@@ -57,7 +180,7 @@ public:
         Purpose:       Destructor: Destroys the stack and releases all allocated memory.
 
         Precondition:  The stack exists.
-        Postcondition: All nodes in the stack have been deallocated, and the
+        Postcondition: All chunks in the stack have been deallocated, and the
                         stack is empty.
        ------------------------------------------------------------------------*/
     int getSize()const;
@@ -73,15 +196,41 @@ public:
 
          Precondition:  A valid Order object `newOrder` is provided.
          Postcondition: `newOrder` is added to the top of the stack, and `size`
-                        is incremented by 1.
+                        is incremented by 1. The stored order is stamped as
+                        completed now unless it already was, and its times
+                        are added to the ticket statistics. If an order log
+                        is attached, the order is appended to it.
+       ------------------------------------------------------------------------*/
+    void push(Order&&);
+    /*------------------------------------------------------------------------
+         Purpose:       Moves a new order to the top of the stack.
+
+         Precondition:  A valid Order object `newOrder` is provided.
+         Postcondition: Same as push(const Order&), but the order's data has
+                        been moved into the stack without copying its line
+                        items or strings; newOrder is left empty.
+       ------------------------------------------------------------------------*/
+    void restoreOrder(Order&&, bool logged = false);
+    /*------------------------------------------------------------------------
+         Purpose:       Moves a recovered order to the top of the stack.
+
+         Precondition:  The order carries the stamps of its original run, for
+                        example from a write-ahead log. `logged` is true if
+                        the attached order log already holds the order.
+         Postcondition: Same as push(Order&&), except that the order is not
+                        stamped as completed now: a completion time it lacks
+                        stays unset and is left out of the ticket statistics.
+                        A logged order is not appended to the log again.
        ------------------------------------------------------------------------*/
-    const Order& pop();
+    Order pop();
     /*------------------------------------------------------------------------
           Purpose:       Removes and returns the order at the top of the stack.
 
           Precondition:  The stack is not empty.
-          Postcondition: The top order is removed, `size` is decremented by 1,
-                         and the removed order is returned.
+          Postcondition: The top order is moved out of the stack and returned,
+                         `size` is decremented by 1 and the order no longer
+                         counts in the ticket statistics. If an order log is
+                         attached, a removal record is appended to it.
         ------------------------------------------------------------------------*/
     bool isEmpty()const;
     /*------------------------------------------------------------------------
@@ -96,7 +245,40 @@ public:
         Purpose:       Calculates the total revenue generated by all completed orders.
 
         Precondition:  None.
-        Postcondition: Returns the sum of the prices of all orders in the stack.
+        Postcondition: Returns the sum of the prices of all orders in the stack,
+                       taken from the running total in constant time.
+    ------------------------------------------------------------------------*/
+    long long getTotalRevenueCents() const;
+    /*------------------------------------------------------------------------
+        Purpose:       Returns the exact total revenue in cents.
+
+        Precondition:  None.
+        Postcondition: Returns the running total of Order::getTotalCents over
+                       all orders in the stack.
+    ------------------------------------------------------------------------*/
+    long getTotalItemCount() const;
+    /*------------------------------------------------------------------------
+        Purpose:       Returns the number of items in all completed orders.
+
+        Precondition:  None.
+        Postcondition: Returns the running total of Order::getItemCount over
+                       all orders in the stack.
+    ------------------------------------------------------------------------*/
+    double getAverageTicket() const;
+    /*------------------------------------------------------------------------
+        Purpose:       Returns the average revenue per completed order.
+
+        Precondition:  None.
+        Postcondition: Returns the total revenue divided by the number of
+                       orders, or 0 if the stack is empty.
+    ------------------------------------------------------------------------*/
+    long long recalculateTotalRevenueCents() const;
+    /*------------------------------------------------------------------------
+        Purpose:       Recomputes the total revenue by walking every order.
+
+        Precondition:  None.
+        Postcondition: Returns the revenue in cents without using the running
+                       total. Intended for verifying the running total.
     ------------------------------------------------------------------------*/
     void displayCompletedOrders()const;
     /*------------------------------------------------------------------------
@@ -113,12 +295,12 @@ public:
          Precondition:  None.
          Postcondition: Outputs the price of each order to the console.
        ------------------------------------------------------------------------*/
-    void printTime(ostream&)const;
+    static void printTime(ostream&);
     /*------------------------------------------------------------------------
-          Purpose:       Prints the timestamps of all completed orders.
+          Purpose:       Prints the current date as the header of a report.
 
           Precondition:  The provided ostream `out` is open.
-          Postcondition: The completion times of all orders are output to `out`.
+          Postcondition: The date is output to `out`.
         ------------------------------------------------------------------------*/
     bool saveCompletedOrdersToFile(const string&) const;
     /*------------------------------------------------------------------------
@@ -127,29 +309,171 @@ public:
           Precondition:  A valid file path is provided.
           Postcondition: Writes the details of all orders to the specified file
                          in a readable format. Returns true if successful, and false
-                         if an error occurs.
+                         if an error occurs. Nothing is printed; the caller
+                         reports the result.
+        ------------------------------------------------------------------------*/
+    void setOrderLog(AppendOnlyLog*);
+    /*------------------------------------------------------------------------
+          Purpose:      Attaches a binary log that receives every pushed order.
+
+          Precondition:  The log is open and outlives the stack, or is NULL.
+          Postcondition: Later pushes append the order to the log and later
+                         pops a removal record. Passing NULL detaches the log.
+        ------------------------------------------------------------------------*/
+    static bool saveLogReportToFile(const string&, const string&, const DynamicArrayList*);
+    /*------------------------------------------------------------------------
+          Purpose:      Writes the text report of every order in a binary log.
+
+          Precondition:  logFile was written through setOrderLog. `menu` is
+                         used to resolve item names and may be NULL.
+          Postcondition: reportFile has the same layout as the file written by
+                         saveCompletedOrdersToFile, with the orders in the order
+                         they were completed. Popped orders are left out. Returns false if either file
+                         cannot be opened. Nothing is printed.
+        ------------------------------------------------------------------------*/
+    static bool readLoggedOrderIds(const string&, unordered_set<int>&);
+    /*------------------------------------------------------------------------
+          Purpose:      Collects the IDs of the orders a binary log still holds.
+
+          Precondition:  logFile was written through setOrderLog.
+          Postcondition: The ID of every order in the log that was not popped
+                         again is added to `ids`. Returns false, leaving
+                         `ids` unchanged, if the log is missing or cannot be
+                         read.
+        ------------------------------------------------------------------------*/
+    void writeBinary(string&) const;
+    /*------------------------------------------------------------------------
+          Purpose:      Serializes the stack for a binary snapshot.
+
+          Precondition:  None.
+          Postcondition: The number of orders and every order, bottom first,
+                         are appended to the buffer.
+        ------------------------------------------------------------------------*/
+    bool readBinary(BinaryReader&, const DynamicArrayList*);
+    /*------------------------------------------------------------------------
+          Purpose:      Restores a stack written by writeBinary.
+
+          Precondition:  The reader is positioned at the start of a stack.
+                         `menu` is used to display item names and may be NULL.
+          Postcondition: The stack holds the decoded orders in their original
+                         order and the running totals and ticket statistics
+                         are recomputed. The orders are not appended to the
+                         order log, which already has them. Returns false, leaving the stack
+                         unchanged, if the data is incomplete or its count is
+                         larger than the remaining bytes could hold. Chunks
+                         are added as orders decode.
+        ------------------------------------------------------------------------*/
+    void swap(CompletedOrdersStack&);
+    /*------------------------------------------------------------------------
+          Purpose:      Exchanges the orders of two stacks.
+
+          Precondition:  The stacks are different objects, and every frozen
+                         copy of either has been released.
+          Postcondition: Each stack holds the orders and running totals the
+                         other had; its ticket statistics are recounted for
+                         them. Each keeps its order log, which is not written
+                         to, and its ticket target.
+        ------------------------------------------------------------------------*/
+    Frozen freeze() const;
+    /*------------------------------------------------------------------------
+          Purpose:      Returns the orders now in the stack without copying them.
+
+          Precondition:  None.
+          Postcondition: The frozen copy shares the chunks that hold the orders.
+                         Later pushes and pops leave it unchanged: until it is
+                         released, they copy a shared chunk before changing it.
+                         The copy must be released before the stack is
+                         destroyed or swapped.
+        ------------------------------------------------------------------------*/
+    TicketStats getTicketStats() const;
+    /*------------------------------------------------------------------------
+          Purpose:      Returns the ticket-time statistics of the stack.
+
+          Precondition:  None.
+          Postcondition: Returns a copy taken under the lock, covering exactly
+                         the stamped orders in the stack at that moment.
+        ------------------------------------------------------------------------*/
+    void setTicketTargetMillis(long long);
+    /*------------------------------------------------------------------------
+          Purpose:      Sets the target ticket time.
+
+          Precondition:  The target is in milliseconds; 0 means no target.
+          Postcondition: The late count is recounted over every order in
+                         the stack, which is the only time the orders are
+                         walked.
         ------------------------------------------------------------------------*/
 private:
-    class Node{
-    public:
-        Node(const Order&);
-        /*------------------------------------------------------------------------
-          Purpose:       Constructs a Node object containing an Order and a pointer to the next node.
+    static const int CHUNK_SIZE = 256; // Number of orders stored in each chunk.
+    typedef shared_ptr<Order[]> Chunk; // CHUNK_SIZE orders, shared with frozen copies.
+
+    Order& nextSlot();
+    /*------------------------------------------------------------------------
+          Purpose:      Returns the slot for the next pushed order.
 
-          Precondition:  A valid Order object is provided.
-          Postcondition: A Node is created with `order` set to the Order object and
-                         `next` set to nullptr.
+          Precondition:  stackLock is held.
+          Postcondition: A chunk (and a larger chunk table) has been added if
+                         every chunk was full, and the slot's chunk is not
+                         shared with a frozen copy. `size` is unchanged.
         ------------------------------------------------------------------------*/
-        Order order; // The order stored in the node.
-        Node* next; // Pointer to the next node in the queue.
-    };
-    typedef Node* NodePtr;
-    NodePtr firstOrder;     // Pointer to the first order.
-    NodePtr top;            // Pointer to the top order in the stack.
+    Order& writableSlot(int);
+    /*------------------------------------------------------------------------
+          Purpose:      Returns the slot at an index, ready to be changed.
+
+          Precondition:  stackLock is held and the slot's chunk is allocated.
+          Postcondition: If an unreleased frozen copy may share the chunk, the
+                         stack now has its own copy of it. The frozen copy is
+                         unchanged.
+        ------------------------------------------------------------------------*/
+    static void writeChunks(const Chunk*, int, string&);
+    /*------------------------------------------------------------------------
+          Purpose:      Encodes the first `count` orders of a chunk table.
+
+          Precondition:  The table holds at least `count` orders.
+          Postcondition: The count and the orders, bottom first, are appended
+                         to the buffer.
+        ------------------------------------------------------------------------*/
+    void recordPush(const Order&, bool logged = false);
+    /*------------------------------------------------------------------------
+          Purpose:      Accounts for an order just stored in nextSlot.
+
+          Precondition:  stackLock is held and the order is stored in the
+                         slot nextSlot returned.
+          Postcondition: `size`, the running totals and the ticket statistics
+                         include the order, and the order has been appended
+                         to the attached log unless it is already `logged`.
+        ------------------------------------------------------------------------*/
+    static void findLiveRecords(const vector<string>&, vector<size_t>&);
+    /*------------------------------------------------------------------------
+          Purpose:      Finds the orders a binary log still holds.
+
+          Precondition:  The records were read from a log written through
+                         setOrderLog.
+          Postcondition: `live` holds the indices of the order records that
+                         were not popped again, oldest first.
+        ------------------------------------------------------------------------*/
+    void recountTicketStats();
+    /*------------------------------------------------------------------------
+          Purpose:      Rebuilds the ticket statistics from every order.
+
+          Precondition:  stackLock is held.
+          Postcondition: ticketStats covers the orders now in the stack.
+        ------------------------------------------------------------------------*/
+
+    Chunk* chunks;          // Table of chunks, each holds CHUNK_SIZE orders.
+    int chunkCount;         // Number of chunks allocated.
+    int chunkCapacity;      // Number of entries in the chunk table.
+    vector<int> chunkStamps; // freezeGeneration when each chunk became the stack's own.
+    mutable int freezeGeneration;   // Frozen copies handed out; changed under stackLock.
+    mutable atomic<int> freezesReleased; // Frozen copies released; stored by their threads.
     int size;               // Current number of orders in the stack.
+    long long revenueCents; // Running total revenue of the stack, in cents.
+    long itemCount;         // Running total of items in the stack.
+    AppendOnlyLog* orderLog; // Log receiving pushed and popped orders, or NULL.
+    TicketStats ticketStats; // Wait, cook and ticket times of the orders.
+    mutable mutex stackLock; // Held by every public method.
 
 };
-// Overloaded output operator to display MenuItem details.
+// Overloaded output operator to display Order details.
 ostream& operator<<(ostream&, const Order&);
 
 #endif /* COMPLETEDORDERSSTACK_H */
@@ -0,0 +1,120 @@
+// This is the implementation file for the ConcurrentOrdersQueue class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, ConcurrentOrdersQueue.h, provides the class structure and function declarations.
+
+//
+//  ConcurrentOrdersQueue.cpp
+//
+
+#include "ConcurrentOrdersQueue.h"
+#include <utility>
+
+// Constructor for the dummy node
+ConcurrentOrdersQueue::Node::Node() : next(NULL) {
+}
+
+// Constructor for Node class, initializes the order data and next pointer
+ConcurrentOrdersQueue::Node::Node(const Order& data) : data(data), next(NULL) {
+}
+
+// Constructor for Node class, moves the order data in
+ConcurrentOrdersQueue::Node::Node(Order&& data) : data(std::move(data)), next(NULL) {
+}
+
+// Constructor for ConcurrentOrdersQueue class, starts with only the dummy node
+ConcurrentOrdersQueue::ConcurrentOrdersQueue() : size(0), nextOrderId(1) {
+    myFront = myBack = new Node();
+}
+
+// Destructor for ConcurrentOrdersQueue class, frees every node including the dummy
+ConcurrentOrdersQueue::~ConcurrentOrdersQueue() {
+    while (myFront != NULL) {
+        NodePtr temp = myFront;
+        myFront = myFront->next.load(memory_order_relaxed);
+        delete temp;
+    }
+}
+
+// Enqueue method to add a copy of a new order to the back of the queue
+int ConcurrentOrdersQueue::enqueue(const Order& newOrder) {
+    // Build the node before taking the lock so the critical section stays short
+    return enqueueNode(new Node(newOrder));
+}
+
+// Enqueue method to move a new order to the back of the queue
+int ConcurrentOrdersQueue::enqueue(Order&& newOrder) {
+    return enqueueNode(new Node(std::move(newOrder)));
+}
+
+// Moves an order that keeps its ID and stamps to the back of the queue
+void ConcurrentOrdersQueue::restoreOrder(Order&& order) {
+    NodePtr newNode = new Node(std::move(order));
+    int orderId = newNode->data.getOrderId();
+    int next = nextOrderId.load(memory_order_relaxed);
+    while (orderId >= next && !nextOrderId.compare_exchange_weak(next, orderId + 1, memory_order_relaxed)) {
+        // next was reloaded by compare_exchange_weak; never hand out this ID again
+    }
+    publishNode(newNode);
+}
+
+// Gives a new node its ID and publishes it at the back
+int ConcurrentOrdersQueue::enqueueNode(NodePtr newNode) {
+    int orderId = nextOrderId.fetch_add(1, memory_order_relaxed);
+    newNode->data.setOrderId(orderId);
+    newNode->data.markPlaced();  // Starts the ticket clock
+    publishNode(newNode);
+    return orderId;
+}
+
+// Stamps the enqueue time of a node and links it at the back
+void ConcurrentOrdersQueue::publishNode(NodePtr newNode) {
+    newNode->enqueuedAt = chrono::steady_clock::now();
+
+    // Count the order before publishing it so the size never goes negative
+    size.fetch_add(1, memory_order_relaxed);
+    {
+        lock_guard<mutex> guard(backLock);
+        // Publish the node; the release pairs with the acquire in dequeue
+        myBack->next.store(newNode, memory_order_release);
+        myBack = newNode;
+    }
+}
+
+// Dequeue method to remove and return the front order from the queue
+bool ConcurrentOrdersQueue::dequeue(Order& processedOrder) {
+    long long waitMicros;
+    return dequeue(processedOrder, waitMicros);
+}
+
+// Dequeue method that also reports how long the order waited in the queue
+bool ConcurrentOrdersQueue::dequeue(Order& processedOrder, long long& waitMicros) {
+    NodePtr oldFront;
+    chrono::steady_clock::time_point enqueuedAt;
+    {
+        lock_guard<mutex> guard(frontLock);
+        oldFront = myFront;
+        NodePtr first = oldFront->next.load(memory_order_acquire);
+        if (first == NULL) {
+            return false;  // Only the dummy node is left: the queue is empty
+        }
+        processedOrder = std::move(first->data);  // Move the order out of the node
+        enqueuedAt = first->enqueuedAt;
+        myFront = first;   // The dequeued node becomes the new dummy
+    }
+    size.fetch_sub(1, memory_order_relaxed);
+    delete oldFront;       // Free the old dummy outside the lock
+    processedOrder.markStarted();  // The kitchen picks it up now
+    waitMicros = chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - enqueuedAt).count();
+    return true;
+}
+
+// Helper method to check if the queue is empty
+bool ConcurrentOrdersQueue::isEmpty() const {
+    return size.load(memory_order_relaxed) == 0;
+}
+
+// Returns the current size of the queue
+int ConcurrentOrdersQueue::getSize() const {
+    return size.load(memory_order_relaxed);
+}
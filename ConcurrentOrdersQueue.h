@@ -0,0 +1,188 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the ConcurrentOrdersQueue class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   ConcurrentOrdersQueue.cpp where the logic of each method is fully defined.
+   ConcurrentOrdersQueue.h contains the declaration of the ConcurrentOrdersQueue class.
+   This class is a thread-safe version of ActiveOrdersQueue for several POS
+   terminals (producers) and several kitchen workers (consumers) sharing one
+   queue of active orders. It keeps the enqueue/dequeue/getSize interface of
+   ActiveOrdersQueue and follows the same FIFO principle.
+
+   The queue is the two-lock linked queue of Michael and Scott. The list always
+   starts with a dummy node. Producers only take the tail lock and consumers
+   only take the head lock, so producers never wait for consumers or the
+   other way round. Each lock is held only for a few pointer updates. Order IDs
+   come from an atomic counter, so they are unique across all producers.
+
+   Basic operations:
+     - Constructor: Constructs an empty ConcurrentOrdersQueue.
+     - Destructor:  Releases all dynamically allocated memory used by the queue.
+     - enqueue:     Adds a new order to the back of the queue. Safe to call from any thread.
+                    A temporary order is moved into its node instead of copied.
+     - restoreOrder: Adds an order keeping the ID and stamps it carries. Safe to call from any thread.
+     - dequeue:     Removes the order at the front of the queue. Safe to call from any thread.
+                    An overload also reports how long the order waited in the queue.
+     - isEmpty:     Checks if the queue contains any orders.
+     - getSize:     Retrieves the number of orders currently in the queue.
+
+   Private utility:
+     - Node: Represents a single node in the queue, storing an Order object, the time
+             it was enqueued and an atomic pointer to the next node in the sequence.
+     - enqueueNode: Gives a new node its order ID and publishes it.
+     - publishNode: Links a node that already has its ID at the back of the queue.
+
+   Data members:
+     - myFront:     Pointer to the dummy node in front of the first order.
+     - myBack:      Pointer to the back node of the queue (last order).
+     - frontLock:   Mutex taken by consumers.
+     - backLock:    Mutex taken by producers.
+     - size:        Number of orders currently in the queue.
+     - nextOrderId: Counter for assigning unique order IDs.
+
+--------------------------------------------------------------------------*/
+
+#ifndef CONCURRENTORDERSQUEUE_H
+#define CONCURRENTORDERSQUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include "Order.h"
+using namespace std;
+
+class ConcurrentOrdersQueue {
+public:
+    ConcurrentOrdersQueue();
+    /*------------------------------------------------------------------------
+      Purpose:       Construct an empty ConcurrentOrdersQueue object.
+
+      Precondition:  None.
+      Postcondition: An empty queue holding only the dummy node has been
+                     created, size is 0 and nextOrderId is 1.
+     -----------------------------------------------------------------------*/
+    ~ConcurrentOrdersQueue();
+    /*------------------------------------------------------------------------
+      Purpose:       Destructor for ConcurrentOrdersQueue.
+
+      Precondition:  No other thread is using the queue.
+      Postcondition: All memory allocated for the queue has been released.
+     -----------------------------------------------------------------------*/
+    int enqueue(const Order&);
+    /*------------------------------------------------------------------------
+      Purpose:       Add a new order to the back of the queue.
+
+      Precondition:  newOrder is a valid Order object.
+      Postcondition: The order has been added to the back of the queue with
+                     the next unused order ID, which is returned, and stamped
+                     as placed now.
+     -----------------------------------------------------------------------*/
+    int enqueue(Order&&);
+    /*------------------------------------------------------------------------
+      Purpose:       Move a new order to the back of the queue.
+
+      Precondition:  newOrder is a valid Order object.
+      Postcondition: Same as enqueue(const Order&), but the order's data has
+                     been moved into the queue; newOrder is left empty.
+     -----------------------------------------------------------------------*/
+    void restoreOrder(Order&&);
+    /*------------------------------------------------------------------------
+      Purpose:       Move an order that already has its ID to the back of the queue.
+
+      Precondition:  The order's ID is positive and not in the queue.
+      Postcondition: The order has been added with its own ID and its own
+                     lifecycle stamps, and nextOrderId has been moved past
+                     that ID. The argument is left empty.
+     -----------------------------------------------------------------------*/
+    bool dequeue(Order&);
+    /*------------------------------------------------------------------------
+      Purpose:       Remove the order from the front of the queue.
+
+      Precondition:  None.
+      Postcondition: If the queue was not empty, the front order has been
+                     removed, moved into processedOrder and stamped as
+                     started, and true is returned. Returns false if the
+                     queue was empty.
+     -----------------------------------------------------------------------*/
+    bool dequeue(Order&, long long&);
+    /*------------------------------------------------------------------------
+      Purpose:       Remove the order from the front of the queue and report
+                     how long it waited.
+
+      Precondition:  None.
+      Postcondition: Same as dequeue(Order&); on success waitMicros is set to
+                     the time in microseconds between enqueue and dequeue.
+     -----------------------------------------------------------------------*/
+    bool isEmpty() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Check whether the queue is empty.
+
+      Precondition:  None.
+      Postcondition: Returns true if the queue held no orders at the time of
+                     the call. Other threads may change this immediately.
+     -----------------------------------------------------------------------*/
+    int getSize() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Get the number of orders in the queue.
+
+      Precondition:  None.
+      Postcondition: Returns the size of the queue at the time of the call.
+     -----------------------------------------------------------------------*/
+
+private:
+    ConcurrentOrdersQueue(const ConcurrentOrdersQueue&);            // Not copyable.
+    ConcurrentOrdersQueue& operator=(const ConcurrentOrdersQueue&);
+
+    class Node {
+    public:
+        Node();
+        /*------------------------------------------------------------------------
+          Purpose:       Constructs the dummy Node.
+
+          Precondition:  None.
+          Postcondition: A Node is created with an empty order and `next` set to nullptr.
+        ------------------------------------------------------------------------*/
+        Node(const Order&);
+        /*------------------------------------------------------------------------
+          Purpose:       Constructs a Node object containing an Order.
+
+          Precondition:  A valid Order object is provided.
+          Postcondition: A Node is created with `data` set to the Order object and
+                         `next` set to nullptr.
+        ------------------------------------------------------------------------*/
+        Node(Order&&);
+        /*------------------------------------------------------------------------
+          Purpose:       Constructs a Node that takes over the data of an Order.
+
+          Precondition:  A valid Order object is provided.
+          Postcondition: Same as Node(const Order&); the order has been moved in.
+        ------------------------------------------------------------------------*/
+        Order data;               // The order stored in the node.
+        chrono::steady_clock::time_point enqueuedAt; // When the order entered the queue.
+        atomic<Node*> next;       // Pointer to the next node in the queue.
+    };
+    typedef Node* NodePtr;
+
+    int enqueueNode(NodePtr);
+    /*------------------------------------------------------------------------
+      Purpose:       Give a new node its order ID, then publish it.
+
+      Precondition:  The node is not in the queue.
+      Postcondition: The node is the back of the queue. Returns its order ID.
+     -----------------------------------------------------------------------*/
+    void publishNode(NodePtr);
+    /*------------------------------------------------------------------------
+      Purpose:       Stamp the enqueue time of a node and link it at the back.
+
+      Precondition:  The node has its order ID and is not in the queue.
+      Postcondition: The node is the back of the queue and counted in size.
+     -----------------------------------------------------------------------*/
+
+    alignas(64) NodePtr myFront;  // Dummy node in front of the first order (consumer side).
+    mutex frontLock;              // Lock held by consumers.
+    alignas(64) NodePtr myBack;   // Last node of the queue (producer side).
+    mutex backLock;               // Lock held by producers.
+    alignas(64) atomic<int> size; // Number of orders in the queue.
+    atomic<int> nextOrderId;      // Identifier for the next order.
+};
+#endif /* CONCURRENTORDERSQUEUE_H */
@@ -7,6 +7,18 @@
 //
 
 #include "DynamicArrayList.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "OperationStats.h"
+
+static const int32_t STATION_ITEMS = -1;  // Binary tag: every item carries its station
+static const size_t MIN_ITEM_BYTES = 4 + 4 + 4 + 8;  // ID, two empty strings and the price
 
 // Constructor: Initializes the dynamic array with a specified capacity.
 DynamicArrayList::DynamicArrayList(int capacity) {
@@ -14,17 +26,44 @@ DynamicArrayList::DynamicArrayList(int capacity) {
     this->size = 0;                 // Start with zero items.
     this->nextItemId = 1;           // Item IDs start at 1.
     items = new MenuItem[capacity]; // Allocate memory for the array.
+    syncedMtime = 0;                // Not in sync with any file yet.
+    syncedFileSize = 0;
+    reloadCount = 0;
+    reloadsAvoided = 0;
 }
 
 // Copy constructor: Creates a deep copy of another DynamicArrayList object.
 DynamicArrayList::DynamicArrayList(const DynamicArrayList& other) {
     capacity = other.capacity;                  // Copy the capacity.
     size = other.size;                          // Copy the size.
+    nextItemId = other.nextItemId;              // Copy the next item ID.
     items = new MenuItem[capacity];             // Allocate memory for the new array.
 
     for (int i = 0; i < size; ++i) {
         items[i] = other.items[i];              // Copy each menu item.
     }
+    indexById = other.indexById;                // Slots are identical, so the index can be copied.
+    syncedFile = other.syncedFile;              // The copy is in sync with the same file.
+    syncedMtime = other.syncedMtime;
+    syncedFileSize = other.syncedFileSize;
+    reloadCount = 0;                            // Counters start fresh for the copy.
+    reloadsAvoided = 0;
+}
+
+// Move constructor: Takes over the item array of another DynamicArrayList object.
+DynamicArrayList::DynamicArrayList(DynamicArrayList&& other) noexcept
+    : items(other.items), capacity(other.capacity), size(other.size), nextItemId(other.nextItemId),
+      indexById(std::move(other.indexById)), searchIndex(std::move(other.searchIndex)),
+      priceIndex(std::move(other.priceIndex)),
+      syncedFile(std::move(other.syncedFile)),
+      syncedMtime(other.syncedMtime), syncedFileSize(other.syncedFileSize),
+      reloadCount(other.reloadCount), reloadsAvoided(other.reloadsAvoided) {
+    other.items = NULL;                         // `other` no longer owns the array.
+    other.capacity = 0;
+    other.size = 0;
+    other.indexById.clear();
+    other.searchIndex.clear();
+    other.priceIndex.clear();
 }
 
 // Destructor: Releases the dynamically allocated memory.
@@ -48,37 +87,201 @@ int DynamicArrayList::getCapacity() const {
 }
 
 // Loads menu items from a file into the dynamic array.
+// The file is memory-mapped and parsed in place: the lines are counted first so
+// the array is allocated once at its final size, and each item is built directly
+// in its slot.
 bool DynamicArrayList::loadMenuFromFile(const string& fileName) {
-    ifstream file(fileName.c_str()); // Open the file for reading.
-    if (!file.is_open()) {
+    STATS_TIMER(timer, STAT_LOAD_MENU);
+    int fd = open(fileName.c_str(), O_RDONLY); // Open the file for reading.
+    if (fd < 0) {
         cerr << "Failed to open file" << endl; // Handle file open failure.
         return false;
     }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        cerr << "Failed to open file" << endl;
+        return false;
+    }
+    size_t length = info.st_size;
+    STATS_ADD_BYTES(timer, length);
+    const char* data = NULL;
+    if (length > 0) {
+        void* mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close(fd);
+            cerr << "Failed to read file" << endl;
+            return false;
+        }
+        data = static_cast<const char*>(mapped);
+        madvise(mapped, length, MADV_SEQUENTIAL); // The file is read front to back once.
+    }
+    close(fd); // The mapping stays valid after the descriptor is closed.
+
+    const char* end = data + length;
+    int lineCount = 0;
+    for (const char* p = data; p < end; ++lineCount) {
+        const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+        p = newline ? newline + 1 : end;
+    }
 
     delete[] items;                  // Clear any existing menu items.
-    items = new MenuItem[10];        // Allocate memory for a default capacity of 10.
+    capacity = lineCount > 10 ? lineCount : 10; // One allocation for the whole file.
+    items = new MenuItem[capacity];
     nextItemId = 1;                  // Reset the next item ID to 1.
     size = 0;                        // Reset the size.
+    indexById.clear();               // Drop the index of the old items.
+    searchIndex.clear();             // Rebuilt by the next search.
+    priceIndex.clear();              // Rebuilt by the next price query.
+    indexById.reserve(capacity);
+
+    const char* p = data;
+    while (p < end) {
+        // Skip blank lines and leading whitespace, as `file >> id` did.
+        while (p < end && isspace(static_cast<unsigned char>(*p))) {
+            ++p;
+        }
+        if (p == end) {
+            break;
+        }
+
+        // Read the ID; stop at the first line that does not start with one.
+        bool negative = false;
+        if (*p == '-' || *p == '+') {
+            negative = *p == '-';
+            ++p;
+        }
+        if (p == end || !isdigit(static_cast<unsigned char>(*p))) {
+            break;
+        }
+        long id = 0;
+        while (p < end && isdigit(static_cast<unsigned char>(*p))) {
+            id = id * 10 + (*p - '0');
+            ++p;
+        }
+        if (negative) {
+            id = -id;
+        }
+        if (p < end) {
+            ++p;                     // Skip the delimiter after the ID.
+        }
+
+        // The name and description run up to the next comma.
+        const char* name = p;
+        while (p < end && *p != ',') {
+            ++p;
+        }
+        const char* nameEnd = p;
+        if (p < end) {
+            ++p;
+        }
+        const char* desc = p;
+        while (p < end && *p != ',') {
+            ++p;
+        }
+        const char* descEnd = p;
+        if (p < end) {
+            ++p;
+        }
+
+        // Copy the price field into a terminated buffer for strtod.
+        char priceText[64];
+        int priceLength = 0;
+        while (p < end && *p != '\n' && *p != ',' && priceLength < 63) {
+            priceText[priceLength++] = *p++;
+        }
+        priceText[priceLength] = '\0';
+
+        // An optional station field follows the price.
+        PrepStation station = STATION_LINE;
+        if (p < end && *p == ',') {
+            const char* stationStart = ++p;
+            while (p < end && *p != '\n' && *p != '\r') {
+                ++p;
+            }
+            MenuItem::parseStation(string(stationStart, p - stationStart), station);
+        }
+        while (p < end && *p != '\n') {
+            ++p;                     // Ignore remaining characters on the line.
+        }
+
+        MenuItem& item = items[size];  // Build the item in its slot.
+        item.setName(string(name, nameEnd - name));
+        item.setDesc(string(desc, descEnd - desc));
+        item.setPrice(strtod(priceText, NULL));
+        item.setStation(station);
+        if (id > 0 && indexById.find(id) == indexById.end()) {
+            item.setId(id);          // Keep the ID stored in the file.
+        } else {
+            item.setId(nextItemId);  // Missing or duplicate ID: assign a new one.
+        }
+        indexById[item.getId()] = size;
+        if (item.getId() >= nextItemId) {
+            nextItemId = item.getId() + 1;
+        }
+        size++;
+    }
+
+    if (length > 0) {
+        munmap(const_cast<char*>(data), length);
+    }
+    rememberFile(fileName);          // The menu now matches this file.
+    return true;
+}
 
-    int id;
-    string name, description;
-    double price;
+// Reloads the menu only if the file changed since it was last read or written.
+bool DynamicArrayList::reloadIfChanged(const string& fileName) {
+    if (!hasFileChanged(fileName)) {
+        reloadsAvoided++;            // The menu in memory is already current.
+        return true;
+    }
+    reloadCount++;
+    return loadMenuFromFile(fileName);
+}
 
-    // Read items from the file and add them to the list.
-    while (file >> id) {
-        file.ignore();               // Ignore whitespace or delimiters.
-        getline(file, name, ',');    // Read the name.
-        getline(file, description, ','); // Read the description.
-        file >> price;               // Read the price.
-        file.ignore();               // Ignore remaining characters on the line.
-        MenuItem item(name, description, price);
-        addMenuItem(item);           // Add the item to the list.
+// Checks whether a file differs from the version the menu holds.
+bool DynamicArrayList::hasFileChanged(const string& fileName) const {
+    long long mtime, fileSize;
+    if (fileName != syncedFile || !readFileStamp(fileName, mtime, fileSize)) {
+        return true;
     }
+    return mtime != syncedMtime || fileSize != syncedFileSize;
+}
 
-    file.close(); // Close the file.
+// Returns how many times reloadIfChanged read the file.
+int DynamicArrayList::getReloadCount() const {
+    return reloadCount;
+}
+
+// Returns how many times reloadIfChanged skipped reading the file.
+int DynamicArrayList::getReloadsAvoided() const {
+    return reloadsAvoided;
+}
+
+// Reads the modification time (in nanoseconds) and size of a file.
+bool DynamicArrayList::readFileStamp(const string& fileName, long long& mtime, long long& fileSize) {
+    struct stat info;
+    if (stat(fileName.c_str(), &info) != 0) {
+        return false;
+    }
+#ifdef __APPLE__
+    mtime = (long long)info.st_mtimespec.tv_sec * 1000000000LL + info.st_mtimespec.tv_nsec;
+#else
+    mtime = (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+#endif
+    fileSize = info.st_size;
     return true;
 }
 
+// Records that the menu is in sync with a file.
+void DynamicArrayList::rememberFile(const string& fileName) {
+    if (readFileStamp(fileName, syncedMtime, syncedFileSize)) {
+        syncedFile = fileName;
+    } else {
+        syncedFile.clear();          // Unknown state: the next check reloads.
+    }
+}
+
 // Saves the current menu items to a file.
 bool DynamicArrayList::saveMenuToFile(const string& fileName) {
     ofstream file(fileName.c_str()); // Open the file for writing.
@@ -87,52 +290,184 @@ bool DynamicArrayList::saveMenuToFile(const string& fileName) {
         return false;
     }
 
-    // Write each item to the file.
-    for (int i = 0; i < size; ++i) {
-        file << items[i].getId() << ','
-             << items[i].getName() << ','
-             << items[i].getDesc() << ','
-             << items[i].getPrice() << '\n';
-    }
+    writeMenu(file); // Write each item to the file.
 
     file.close(); // Close the file.
+    rememberFile(fileName); // Our own write is not a change to reload.
     cout << "Data saved successfully to " << fileName << endl;
     return true;
 }
 
-// Adds a new menu item to the list, resizing the array if needed.
-void DynamicArrayList::addMenuItem(const MenuItem& item) {
+// Writes each menu item to a stream in the menu file format.
+void DynamicArrayList::writeMenu(ostream& out) const {
+    for (int i = 0; i < size; ++i) {
+        out << items[i].getId() << ','
+            << items[i].getName() << ','
+            << items[i].getDesc() << ','
+            << items[i].getPrice();
+        if (items[i].getStation() != STATION_LINE) {
+            out << ',' << MenuItem::getStationName(items[i].getStation());
+        }
+        out << '\n';
+    }
+}
+
+// Adds a new menu item to the list and assigns it the next available ID.
+int DynamicArrayList::addMenuItem(MenuItem item) {
+    int id = nextItemId;
+    item.setId(id);                        // Assign the next available ID.
+    insertItem(std::move(item));           // Add the item; this also advances nextItemId.
+    searchIndex.addItem(items[size - 1]);  // Only if a search has built the index.
+    priceIndex.addItem(items[size - 1]);   // Likewise for a price query.
+    return id;
+}
+
+// Appends the menu to a binary snapshot buffer.
+void DynamicArrayList::writeBinary(string& out) const {
+    appendInt32(out, nextItemId);
+    appendString(out, syncedFile);
+    appendInt64(out, syncedMtime);
+    appendInt64(out, syncedFileSize);
+    appendInt32(out, STATION_ITEMS);       // Tells the item format apart from the older one
+    appendInt32(out, size);
+    for (int i = 0; i < size; i++) {
+        appendInt32(out, items[i].getId());
+        appendString(out, items[i].getName());
+        appendString(out, items[i].getDesc());
+        appendDouble(out, items[i].getPrice());
+        appendInt32(out, items[i].getStation());
+    }
+}
+
+// Replaces the menu with one read from a binary snapshot.
+bool DynamicArrayList::readBinary(BinaryReader& in) {
+    int32_t nextId, count;
+    string fileName;
+    int64_t mtime, fileSize;
+    if (!in.readInt32(nextId) || !in.readString(fileName) || !in.readInt64(mtime)
+        || !in.readInt64(fileSize) || !in.readInt32(count)) {
+        return false;
+    }
+    bool hasStations = count == STATION_ITEMS;  // Snapshots before stations have the count here
+    if ((hasStations && !in.readInt32(count)) || count < 0
+        || static_cast<size_t>(count) > in.remaining() / MIN_ITEM_BYTES) {
+        return false;                        // More items than the remaining bytes could hold.
+    }
+    int newCapacity = count > 10 ? count : 10; // One allocation for the whole menu.
+    MenuItem* decoded = new MenuItem[newCapacity];
+    unordered_map<int, int> index;
+    index.reserve(newCapacity);
+    for (int i = 0; i < count; i++) {
+        int32_t id;
+        string name, description;
+        double price;
+        int32_t station = STATION_LINE;
+        if (!in.readInt32(id) || !in.readString(name) || !in.readString(description)
+            || !in.readDouble(price) || (hasStations && !in.readInt32(station))) {
+            delete[] decoded;                // Incomplete snapshot: keep the current menu.
+            return false;
+        }
+        decoded[i].setId(id);
+        decoded[i].setName(std::move(name));
+        decoded[i].setDesc(std::move(description));
+        decoded[i].setPrice(price);
+        decoded[i].setStation(station >= 0 && station < STATION_COUNT
+                              ? static_cast<PrepStation>(station) : STATION_LINE);
+        index[id] = i;
+    }
+
+    delete[] items;                          // Replace the current menu.
+    items = decoded;
+    capacity = newCapacity;
+    size = count;
+    nextItemId = nextId;
+    indexById.swap(index);
+    searchIndex.clear();
+    priceIndex.clear();
+    syncedFile = fileName;
+    syncedMtime = mtime;
+    syncedFileSize = fileSize;
+    return true;
+}
+
+// Adds or replaces a menu item, keeping the ID it carries.
+void DynamicArrayList::restoreMenuItem(MenuItem item) {
+    searchIndex.clear();                   // The ID may have been indexed with other text.
+    unordered_map<int, int>::iterator found = indexById.find(item.getId());
+    if (found != indexById.end()) {
+        priceIndex.removeItem(items[found->second]); // Under its old price and station.
+        items[found->second] = std::move(item); // Replace the existing item in its slot.
+        priceIndex.addItem(items[found->second]);
+        return;
+    }
+    insertItem(std::move(item));           // New ID: append it.
+    priceIndex.addItem(items[size - 1]);
+}
+
+// Changes the price of the menu item with the specified ID.
+bool DynamicArrayList::updateMenuItemPrice(int id, double price) {
+    MenuItem* item = findMenuItem(id);
+    if (item == NULL) {
+        return false;
+    }
+    priceIndex.removeItem(*item);          // Re-indexed under the new price.
+    item->setPrice(price);
+    priceIndex.addItem(*item);
+    return true;
+}
+
+// Changes the prep station of the menu item with the specified ID.
+bool DynamicArrayList::updateMenuItemStation(int id, PrepStation station) {
+    MenuItem* item = findMenuItem(id);
+    if (item == NULL) {
+        return false;
+    }
+    priceIndex.removeItem(*item);          // Moves to the new station's price list.
+    item->setStation(station);
+    priceIndex.addItem(*item);
+    return true;
+}
+
+// Appends an item that already carries its ID, resizing the array if needed.
+void DynamicArrayList::insertItem(MenuItem&& item) {
     if (size == capacity) {                // Check if resizing is needed.
-        capacity *= 2;                     // Double the capacity.
+        capacity = capacity > 0 ? capacity * 2 : 10; // Double the capacity.
         MenuItem* temp = new MenuItem[capacity]; // Allocate a new larger array.
         for (int i = 0; i < size; i++) {
-            temp[i] = items[i];            // Copy existing items to the new array.
+            temp[i] = std::move(items[i]); // Move existing items to the new array.
         }
         delete[] items;                    // Free the old array.
         items = temp;                      // Update the pointer to the new array.
     }
 
-    MenuItem newItem = item;               // Copy the new item.
-    newItem.setId(nextItemId);             // Assign the next available ID.
-    items[size++] = newItem;               // Add the item and increment the size.
-    nextItemId++;                          // Increment the next available ID.
+    int id = item.getId();
+    indexById[id] = size;                  // Record the slot of the new item.
+    items[size++] = std::move(item);       // Add the item and increment the size.
+    if (id >= nextItemId) {
+        nextItemId = id + 1;               // Never hand out an ID that is already taken.
+    }
 }
 
-// Deletes a menu item at the specified index.
-bool DynamicArrayList::deleteMenuItem(int index) {
+// Deletes the menu item with the specified ID.
+bool DynamicArrayList::deleteMenuItem(int id) {
     if (size == 0) {                       // Check if the list is empty.
         cout << "Menu is Empty" << endl;
         return false;
     }
 
-    if (index < 0 || index > size) {       // Check for index out of bounds.
-        cout << "Index out of bounds!" << endl;
+    unordered_map<int, int>::iterator found = indexById.find(id);
+    if (found == indexById.end()) {        // Check that the ID exists.
         return false;
     }
-
-    // Shift items to fill the gap left by the deleted item.
-    for (int i = index - 1; i < size - 1; i++) {
-        items[i] = items[i + 1];
+    int slot = found->second;
+    indexById.erase(found);
+    searchIndex.removeItem(id);
+    priceIndex.removeItem(items[slot]);
+
+    // Shift items to fill the gap left by the deleted item and update their slots.
+    for (int i = slot; i < size - 1; i++) {
+        items[i] = std::move(items[i + 1]);
+        indexById[items[i].getId()] = i;
     }
 
     size--;                                // Decrement the size.
@@ -143,8 +478,12 @@ bool DynamicArrayList::deleteMenuItem(int index) {
 bool DynamicArrayList::resetMenu(const string& fileName) {
     delete[] items;                        // Clear the current items.
     items = new MenuItem[10];              // Allocate memory for a default capacity of 10.
+    capacity = 10;                         // Reset the capacity to match the new array.
     nextItemId = 1;                        // Reset the next item ID.
     size = 0;                              // Reset the size.
+    indexById.clear();                     // Drop the index of the old items.
+    searchIndex.clear();
+    priceIndex.clear();
 
     ofstream file(fileName, ios::trunc);   // Open the file in truncation mode.
     if (!file.is_open()) {
@@ -154,11 +493,52 @@ bool DynamicArrayList::resetMenu(const string& fileName) {
 
     // No need to write anything, truncation clears the file.
     file.close();                          // Close the file.
+    rememberFile(fileName);                // The empty menu matches the empty file.
 
     cout << "All menu items cleared from file and memory." << endl;
     return true;
 }
 
+// Finds menu items by part of their name or description.
+int DynamicArrayList::searchMenu(const string& query, vector<int>& ids, int limit) {
+    STATS_TIMER(timer, STAT_SEARCH_MENU);
+    if (!searchIndex.isBuilt()) {
+        searchIndex.build(items, size);    // First search since the menu was loaded.
+    }
+    return searchIndex.search(query, ids, limit);
+}
+
+// Finds the items priced from minPrice to maxPrice, cheapest first.
+int DynamicArrayList::findItemsByPrice(double minPrice, double maxPrice, vector<int>& ids,
+                                       PrepStation station) {
+    STATS_TIMER(timer, STAT_PRICE_QUERY);
+    if (!priceIndex.isBuilt()) {
+        priceIndex.build(items, size);     // First price query since the menu was loaded.
+    }
+    priceIndex.findRange(MenuPriceIndex::toCents(minPrice), MenuPriceIndex::toCents(maxPrice), station, ids);
+    return static_cast<int>(ids.size());
+}
+
+// Finds the count cheapest items.
+int DynamicArrayList::findCheapestItems(int count, vector<int>& ids, PrepStation station) {
+    STATS_TIMER(timer, STAT_PRICE_QUERY);
+    if (!priceIndex.isBuilt()) {
+        priceIndex.build(items, size);
+    }
+    priceIndex.findCheapest(count, station, ids);
+    return static_cast<int>(ids.size());
+}
+
+// Finds the count most expensive items.
+int DynamicArrayList::findPriciestItems(int count, vector<int>& ids, PrepStation station) {
+    STATS_TIMER(timer, STAT_PRICE_QUERY);
+    if (!priceIndex.isBuilt()) {
+        priceIndex.build(items, size);
+    }
+    priceIndex.findPriciest(count, station, ids);
+    return static_cast<int>(ids.size());
+}
+
 // Displays the current menu items to the console.
 void DynamicArrayList::displayMenu() {
     cout << "--- Menu Items ---" << endl;
@@ -169,12 +549,22 @@ void DynamicArrayList::displayMenu() {
 
 // Finds a menu item by its ID.
 MenuItem* DynamicArrayList::findMenuItem(int id) {
-    for (int i = 0; i < size; ++i) {
-        if (items[i].getId() == id) {      // Check for a matching ID.
-            return &items[i];              // Return a pointer to the matching item.
-        }
+    STATS_TIMER(timer, STAT_FIND_MENU_ITEM);
+    unordered_map<int, int>::const_iterator found = indexById.find(id);
+    if (found == indexById.end()) {
+        return NULL;                       // Return NULL if not found.
     }
-    return NULL;                           // Return NULL if not found.
+    return &items[found->second];          // Return a pointer to the matching item.
+}
+
+// Finds a menu item by its ID (read-only).
+const MenuItem* DynamicArrayList::findMenuItem(int id) const {
+    STATS_TIMER(timer, STAT_FIND_MENU_ITEM);
+    unordered_map<int, int>::const_iterator found = indexById.find(id);
+    if (found == indexById.end()) {
+        return NULL;                       // Return NULL if not found.
+    }
+    return &items[found->second];          // Return a pointer to the matching item.
 }
 
 // Assignment operator: Deep copies another DynamicArrayList object.
@@ -184,11 +574,44 @@ DynamicArrayList& DynamicArrayList::operator=(const DynamicArrayList& other) {
 
         capacity = other.capacity;         // Copy the capacity.
         size = other.size;                 // Copy the size.
+        nextItemId = other.nextItemId;     // Copy the next item ID.
         items = new MenuItem[capacity];    // Allocate memory for the new array.
 
         for (int i = 0; i < size; ++i) {
             items[i] = other.items[i];     // Copy each item.
         }
+        indexById = other.indexById;       // Slots are identical, so the index can be copied.
+        searchIndex.clear();               // Built again by the first search of the copy.
+        priceIndex.clear();
+        syncedFile = other.syncedFile;     // Now in sync with the same file as `other`.
+        syncedMtime = other.syncedMtime;
+        syncedFileSize = other.syncedFileSize;
+    }
+    return *this;
+}
+
+// Move assignment operator: Takes over the item array of another DynamicArrayList.
+DynamicArrayList& DynamicArrayList::operator=(DynamicArrayList&& other) noexcept {
+    if (this != &other) {                  // Check for self-assignment.
+        delete[] items;                    // Clear the current items.
+
+        items = other.items;               // Take over the array and the index.
+        capacity = other.capacity;
+        size = other.size;
+        nextItemId = other.nextItemId;
+        indexById = std::move(other.indexById);
+        searchIndex = std::move(other.searchIndex);
+        priceIndex = std::move(other.priceIndex);
+        syncedFile = std::move(other.syncedFile);
+        syncedMtime = other.syncedMtime;
+        syncedFileSize = other.syncedFileSize;
+
+        other.items = NULL;                // `other` no longer owns the array.
+        other.capacity = 0;
+        other.size = 0;
+        other.indexById.clear();
+        other.searchIndex.clear();
+        other.priceIndex.clear();
     }
     return *this;
 }
@@ -7,31 +7,68 @@
    a collection of menu items efficiently. It supports operations such as
    addition, deletion, searching, and file handling for menu persistence.
 
+   The menu file has one item per line: id,name,description,price and, for
+   items not made on the line, a fifth field naming their prep station.
+   Files without station fields load with every item on the line.
+
    Basic operations:
      - Constructor: Constructs an empty DynamicArrayList with a specified capacity.
      - Copy Constructor: Creates a deep copy of an existing DynamicArrayList.
+     - Move Constructor: Takes over the items of an existing DynamicArrayList.
      - Destructor:  Releases dynamically allocated memory associated with the array.
      - getSize:     Returns the current number of menu items in the list.
      - setCapacity: Adjusts the capacity of the array as needed.
      - getCapacity: Returns the maximum number of items the array can hold.
-     - loadMenuFromFile: Loads menu data from a file into the dynamic array.
+     - loadMenuFromFile: Loads menu data from a memory-mapped file into the dynamic array.
      - saveMenuToFile:  Saves the current menu items to a file for future use.
+     - writeMenu:   Writes the menu items to a stream in the menu file format.
+     - reloadIfChanged: Reloads the menu only if its file changed since it was last read or written.
+     - hasFileChanged:  Checks whether a file differs from the version the menu holds.
+     - getReloadCount / getReloadsAvoided: Counters for reloadIfChanged.
+     - rememberFile: Records the file the menu is in sync with.
      - addMenuItem: Adds a new menu item to the dynamic array.
+     - restoreMenuItem: Adds or replaces a menu item keeping its ID.
+     - updateMenuItemPrice: Changes the price of a menu item.
+     - updateMenuItemStation: Changes the prep station of a menu item.
      - deleteMenuItem: Deletes a menu item by its unique ID.
      - resetMenu: Clears the menu, removing all menu items.
      - displayMenu: Displays all menu items currently in the array.
-     - findMenuItem: Searches for a menu item by ID and returns a pointer to it.
+     - findMenuItem: Searches for a menu item by ID and returns a pointer to it
+                     using the ID index (constant time on average).
+                     A const overload is provided for read-only lookups.
+     - searchMenu:  Finds items by part of their name or description, best match first.
+     - findItemsByPrice: Finds the items within a price range, cheapest first.
+     - findCheapestItems / findPriciestItems: Finds the N cheapest or most expensive items,
+                    optionally of one prep station.
+     - writeBinary: Appends the whole menu, its ID counter and file sync state to a binary buffer.
+     - readBinary:  Replaces the menu with one written by writeBinary.
      - Assignment Operator: Overloads the `=` operator for deep copying DynamicArrayList objects.
+     - Move Assignment Operator: Takes over the items of another DynamicArrayList.
 
    Private utility:
      - The class uses dynamic memory allocation to resize the array when the
-       current capacity is exceeded, ensuring efficient use of memory.
+       current capacity is exceeded, ensuring efficient use of memory. Items are
+       moved, not copied, into the larger array and when deletion closes a gap.
+     - insertItem: Appends an item that already carries its ID.
+     - readFileStamp: Reads the modification time and size of a file.
 
    Data members:
      - items: A dynamically allocated array storing MenuItem objects.
      - capacity: The current maximum capacity of the array.
      - size: The number of items currently stored in the array.
      - nextItemId: A counter used to assign unique IDs to new menu items.
+     - indexById: A hash index mapping each menu item ID to its slot in `items`.
+     - searchIndex: Trigram index over item names and descriptions. It is built by the
+       first search, kept up to date by addMenuItem and deleteMenuItem, and dropped by
+       operations that replace many items at once (loads, reset, restoring an item);
+       copies of the list start without one.
+     - priceIndex: Items sorted by price, overall and per station. It is built by the first
+       price query and kept up to date by every add, delete, restore and price or station
+       change; like searchIndex, it is dropped by loads and reset and not copied.
+     - syncedFile, syncedMtime, syncedFileSize: The file the menu was last loaded from or
+       saved to, and its modification time (nanoseconds) and size at that moment.
+     - reloadCount, reloadsAvoided: How often reloadIfChanged had to read the file and how
+       often it could skip it.
 
 --------------------------------------------------------------------------*/
 
@@ -42,7 +79,12 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include "BinaryIO.h"
 #include "MenuItem.h"
+#include "MenuPriceIndex.h"
+#include "MenuSearchIndex.h"
 using namespace std;
 
 class DynamicArrayList {
@@ -64,6 +106,15 @@ public:
       Postcondition: A new list is created with the same capacity, size, and
                      elements as `other`.
     ------------------------------------------------------------------------*/
+
+    DynamicArrayList(DynamicArrayList&&) noexcept;
+    /*------------------------------------------------------------------------
+      Purpose:       Move constructor: Takes over the items of another list.
+
+      Precondition:  The other Object is a valid DynamicArrayList object.
+      Postcondition: This list owns the item array, index and file sync state
+                     of `other`, which is left as an empty list with no array.
+    ------------------------------------------------------------------------*/
     
     ~DynamicArrayList();
     /*------------------------------------------------------------------------
@@ -106,6 +157,11 @@ public:
 
           Precondition:  the filename is a valid file path.
           Postcondition: Reads menu item data from the file and populates the list.
+                         The file is memory-mapped and parsed in place, and the
+                         array is sized once from the number of lines in the file.
+                         Items keep the IDs stored in the file, so orders that
+                         refer to an item by ID stay valid across reloads. An item
+                         with a missing or duplicate ID gets the next free ID.
                          Returns true if successful, false if an error occurs (e.g., file
                          not found or invalid format).
         ------------------------------------------------------------------------*/
@@ -119,18 +175,107 @@ public:
                      structured format. Returns true if successful, false otherwise.
     ------------------------------------------------------------------------*/
     
-    void addMenuItem(const MenuItem&);
+    bool reloadIfChanged(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Makes sure the menu matches a file, reading it only when needed.
+
+      Precondition:  the filename is a valid file path.
+      Postcondition: If the file is the one the menu was last loaded from or
+                     saved to, and its modification time and size are unchanged,
+                     nothing is read and the reloads-avoided counter is
+                     incremented. Otherwise the file is loaded with
+                     loadMenuFromFile and the reload counter is incremented.
+                     Returns true if the menu is in sync with the file.
+    ------------------------------------------------------------------------*/
+
+    bool hasFileChanged(const string&) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Checks whether a file differs from what the menu holds.
+
+      Precondition:  None.
+      Postcondition: Returns false only if the file is the one the menu was
+                     last loaded from or saved to and its modification time and
+                     size have not changed since.
+    ------------------------------------------------------------------------*/
+
+    int getReloadCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns how many times reloadIfChanged read the file.
+
+      Precondition:  None.
+      Postcondition: Returns the reload counter.
+    ------------------------------------------------------------------------*/
+
+    int getReloadsAvoided() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns how many times reloadIfChanged skipped reading the file.
+
+      Precondition:  None.
+      Postcondition: Returns the reloads-avoided counter.
+    ------------------------------------------------------------------------*/
+
+    void rememberFile(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Records that the menu is now in sync with a file.
+
+      Precondition:  The menu was just loaded from or written to the file, or
+                     the file was written from an exact copy of this menu.
+      Postcondition: The file name, modification time and size are stored,
+                     so hasFileChanged reports false until the file changes.
+    ------------------------------------------------------------------------*/
+
+    void writeMenu(ostream&) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Writes all menu items to a stream in the menu file format.
+
+      Precondition:  The stream is open for writing.
+      Postcondition: One "id,name,description,price" line per item has been
+                     written to the stream. Nothing is printed to the console.
+    ------------------------------------------------------------------------*/
+
+    int addMenuItem(MenuItem);
     /*------------------------------------------------------------------------
       Purpose:       Adds a new menu item to the list.
 
       Precondition:  The list is not at capacity, and the new item is valid.
       Postcondition: New Item is added to the end of the list, and `size`
                      is incremented by 1. If necessary, the list is resized.
+                     Returns the ID assigned to the new item. A temporary
+                     item is moved into its slot without copying its strings.
+    ------------------------------------------------------------------------*/
+
+    void restoreMenuItem(MenuItem);
+    /*------------------------------------------------------------------------
+      Purpose:       Puts a menu item back into the list with the ID it carries.
+
+      Precondition:  The item's ID is positive.
+      Postcondition: If an item with that ID exists it is replaced, otherwise
+                     the item is added to the end of the list. `nextItemId`
+                     is moved past the item's ID. Used to replay saved edits.
+    ------------------------------------------------------------------------*/
+
+    bool updateMenuItemPrice(int, double);
+    /*------------------------------------------------------------------------
+      Purpose:       Changes the price of a menu item.
+
+      Precondition:  Item Id corresponds to an existing menu item.
+      Postcondition: The item's price is set to the new price. Returns true
+                     if the item was found, false otherwise.
     ------------------------------------------------------------------------*/
     
+    bool updateMenuItemStation(int, PrepStation);
+    /*------------------------------------------------------------------------
+      Purpose:       Changes the prep station of a menu item.
+
+      Precondition:  Item Id corresponds to an existing menu item.
+      Postcondition: The item is prepared at the new station. Returns true
+                     if the item was found, false otherwise.
+    ------------------------------------------------------------------------*/
+
     bool deleteMenuItem(int);
     /*------------------------------------------------------------------------
       Purpose:       Deletes a menu item from the list based on its ID.
+                     The slot is found through the ID index.
 
       Precondition:  Item Id corresponds to an existing menu item.
       Postcondition: The item is removed, and the remaining items are shifted
@@ -158,7 +303,76 @@ public:
 
       Precondition:  Item Id corresponds to an existing menu item.
       Postcondition: Returns a pointer to the menu item if found, or nullptr
-                     if no item with the given ID exists.
+                     if no item with the given ID exists. The lookup goes
+                     through the ID index and does not scan the array.
+    ------------------------------------------------------------------------*/
+    const MenuItem* findMenuItem(int) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Finds a menu item by ID without allowing it to be modified.
+
+      Precondition:  None.
+      Postcondition: Returns a const pointer to the menu item if found, or
+                     nullptr if no item with the given ID exists.
+    ------------------------------------------------------------------------*/
+    int searchMenu(const string&, vector<int>&, int limit = 20);
+    /*------------------------------------------------------------------------
+      Purpose:       Finds menu items by part of their name or description.
+
+      Precondition:  limit is positive.
+      Postcondition: ids holds the IDs of up to `limit` items containing the
+                     query, ranked as described in MenuSearchIndex.h; one- or
+                     two-character queries match the start of words only.
+                     Returns the number of matching items. Builds the search
+                     index first if the menu has none.
+    ------------------------------------------------------------------------*/
+    int findItemsByPrice(double, double, vector<int>&, PrepStation station = STATION_COUNT);
+    /*------------------------------------------------------------------------
+      Purpose:       Finds the menu items within a price range.
+
+      Precondition:  None. A station of STATION_COUNT means every station.
+      Postcondition: ids holds the IDs of the items of that station priced
+                     from minPrice to maxPrice inclusive (compared in whole
+                     cents), cheapest first and by ID within a price. Returns
+                     their number. Builds the price index first if the menu
+                     has none.
+    ------------------------------------------------------------------------*/
+    int findCheapestItems(int, vector<int>&, PrepStation station = STATION_COUNT);
+    /*------------------------------------------------------------------------
+      Purpose:       Finds the cheapest menu items.
+
+      Precondition:  None. A station of STATION_COUNT means every station.
+      Postcondition: ids holds the IDs of up to count items of that station,
+                     cheapest first. Returns their number.
+    ------------------------------------------------------------------------*/
+    int findPriciestItems(int, vector<int>&, PrepStation station = STATION_COUNT);
+    /*------------------------------------------------------------------------
+      Purpose:       Finds the most expensive menu items.
+
+      Precondition:  None. A station of STATION_COUNT means every station.
+      Postcondition: ids holds the IDs of up to count items of that station,
+                     most expensive first and by ID within a price. Returns
+                     their number.
+    ------------------------------------------------------------------------*/
+    void writeBinary(string&) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Serializes the menu for a binary snapshot.
+
+      Precondition:  None.
+      Postcondition: nextItemId, the file sync state (syncedFile and its
+                     stamp) and every item with its station are appended to
+                     the buffer.
+    ------------------------------------------------------------------------*/
+    bool readBinary(BinaryReader&);
+    /*------------------------------------------------------------------------
+      Purpose:       Restores a menu written by writeBinary.
+
+      Precondition:  The reader is positioned at the start of a menu.
+      Postcondition: The list holds the decoded items with their IDs, the ID
+                     counter and the sync state, so reloadIfChanged skips the
+                     file if it has not changed since. Menus written before
+                     stations existed load with every item on the line.
+                     Returns false, leaving the list unchanged, if the data
+                     is incomplete or holds more items than it has bytes for.
     ------------------------------------------------------------------------*/
     DynamicArrayList& operator=(const DynamicArrayList&);
     /*------------------------------------------------------------------------
@@ -168,11 +382,46 @@ public:
       Postcondition: The current list is replaced with a deep copy of `other`.
                      Any previously allocated memory is released.
     ------------------------------------------------------------------------*/
+    DynamicArrayList& operator=(DynamicArrayList&&) noexcept;
+    /*------------------------------------------------------------------------
+      Purpose:       Moves one DynamicArrayList into another.
+
+      Precondition:  The other Object is a valid DynamicArrayList object.
+      Postcondition: The current items are released and this list owns the
+                     items of `other`, which is left empty with no array.
+    ------------------------------------------------------------------------*/
 private:
+    void insertItem(MenuItem&&);
+    /*------------------------------------------------------------------------
+      Purpose:       Appends an item that already has its ID set.
+
+      Precondition:  The item's ID is positive and not used by another item.
+      Postcondition: The item is added to the end of the list and indexed, the
+                     array is resized if necessary, and `nextItemId` is moved
+                     past the item's ID.
+    ------------------------------------------------------------------------*/
+
+    static bool readFileStamp(const string&, long long&, long long&);
+    /*------------------------------------------------------------------------
+      Purpose:       Reads the modification time and size of a file.
+
+      Precondition:  None.
+      Postcondition: Sets mtime (in nanoseconds) and size and returns true, or
+                     returns false if the file cannot be examined.
+    ------------------------------------------------------------------------*/
+
     MenuItem* items;  // Pointer to the dynamically allocated array of menu items.
     int capacity;     // Maximum number of items the list can hold.
     int size;         // Current number of items in the list.
     int nextItemId;   // ID to assign to the next menu item.
+    unordered_map<int, int> indexById; // Maps a menu item ID to its slot in `items`.
+    MenuSearchIndex searchIndex; // Text index for searchMenu, built on first use.
+    MenuPriceIndex priceIndex;   // Price index for the price queries, built on first use.
+    string syncedFile;         // File the menu was last loaded from or saved to.
+    long long syncedMtime;     // Modification time of syncedFile at that moment, in nanoseconds.
+    long long syncedFileSize;  // Size of syncedFile at that moment.
+    int reloadCount;           // Times reloadIfChanged had to read the file.
+    int reloadsAvoided;        // Times reloadIfChanged found the file unchanged.
 };
 
 #endif /* DYNAMICARRAYLIST_H */
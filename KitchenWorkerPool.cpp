@@ -0,0 +1,172 @@
+// This is the implementation file for the KitchenWorkerPool class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, KitchenWorkerPool.h, provides the class structure and function declarations.
+
+//
+//  KitchenWorkerPool.cpp
+//
+
+#include "KitchenWorkerPool.h"
+#include <utility>
+
+// Constructor, binds the pool to its queue and stack without starting threads
+KitchenWorkerPool::KitchenWorkerPool(ConcurrentOrdersQueue& activeOrders, CompletedOrdersStack& completedOrders,
+                                     int workerCount, int prepMicrosPerItem)
+    : activeOrders(activeOrders), completedOrders(&completedOrders), router(NULL), orderWal(NULL),
+      stopping(false), busyWorkers(0), ordersTaken(0), ordersCompleted(0), itemsPrepared(0), totalWaitMicros(0),
+      maxWaitMicros(0) {
+    this->workerCount = workerCount > 0 ? workerCount : 1;
+    this->prepMicrosPerItem = prepMicrosPerItem > 0 ? prepMicrosPerItem : 0;
+}
+
+// Constructor, binds the pool to its queue and a router without starting threads
+KitchenWorkerPool::KitchenWorkerPool(ConcurrentOrdersQueue& activeOrders, StationRouter& router, int workerCount)
+    : activeOrders(activeOrders), completedOrders(NULL), router(&router), orderWal(NULL),
+      stopping(false), busyWorkers(0), ordersTaken(0), ordersCompleted(0), itemsPrepared(0), totalWaitMicros(0),
+      maxWaitMicros(0) {
+    this->workerCount = workerCount > 0 ? workerCount : 1;
+    this->prepMicrosPerItem = 0;  // The stations prepare the items
+}
+
+// Destructor, makes sure no worker outlives the pool
+KitchenWorkerPool::~KitchenWorkerPool() {
+    shutdown();
+}
+
+// Starts the worker threads
+void KitchenWorkerPool::start() {
+    if (isRunning()) {
+        return;  // Already running
+    }
+    stopping.store(false);
+    startTime = chrono::steady_clock::now();
+    for (int i = 0; i < workerCount; ++i) {
+        workers.push_back(thread(&KitchenWorkerPool::workerLoop, this));
+    }
+}
+
+// Queues an order that keeps its ID and wakes a worker, or splits it into station tickets at once
+void KitchenWorkerPool::submit(Order&& order) {
+    if (router != NULL) {
+        router->dispatch(std::move(order));  // Never waits in the queue as a whole order
+        return;
+    }
+    activeOrders.restoreOrder(std::move(order));
+    idleSignal.notify_one();  // A worker that misses it wakes on its timeout
+}
+
+// Polls until the queue is empty and no worker holds an order
+void KitchenWorkerPool::waitUntilIdle() {
+    // A worker counts itself busy before it dequeues, so an order is always
+    // either in the queue, counted in busyWorkers or on the completed stack
+    while (isRunning() && (!activeOrders.isEmpty() || busyWorkers.load() > 0)) {
+        this_thread::sleep_for(chrono::microseconds(50));
+    }
+    if (router != NULL) {
+        router->waitUntilIdle();  // Every dispatched order is open there until it is pushed
+    }
+}
+
+// Asks the workers to finish the remaining orders and waits for them
+void KitchenWorkerPool::shutdown() {
+    if (!isRunning()) {
+        return;
+    }
+    {
+        lock_guard<mutex> guard(idleLock);
+        stopping.store(true);
+    }
+    idleSignal.notify_all();  // Wake workers that are waiting for orders
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+    workers.clear();
+    if (router != NULL) {
+        router->waitUntilIdle();
+    }
+    stopTime = chrono::steady_clock::now();
+}
+
+// Returns true while worker threads exist
+bool KitchenWorkerPool::isRunning() const {
+    return !workers.empty();
+}
+
+// Sets the write-ahead log; with a router the stations complete the orders, so it goes there
+void KitchenWorkerPool::setOrderWAL(OrderWAL* log) {
+    orderWal = log;
+    if (router != NULL) {
+        router->setOrderWAL(log);
+    }
+}
+
+// Returns throughput and queue-wait statistics
+KitchenStats KitchenWorkerPool::getStats() const {
+    KitchenStats stats;
+    if (router != NULL) {
+        StationStats stations = router->getStats();  // Orders complete when their last ticket is done
+        stats.ordersCompleted = stations.ordersCompleted;
+        stats.itemsPrepared = stations.itemsPrepared;
+    } else {
+        stats.ordersCompleted = ordersCompleted.load();
+        stats.itemsPrepared = itemsPrepared.load();
+    }
+    long taken = ordersTaken.load();
+    chrono::steady_clock::time_point end = isRunning() ? chrono::steady_clock::now() : stopTime;
+    stats.elapsedSeconds = chrono::duration<double>(end - startTime).count();
+    stats.ordersPerSecond = stats.elapsedSeconds > 0 ? stats.ordersCompleted / stats.elapsedSeconds : 0;
+    stats.averageWaitMicros = taken > 0 ? (double)totalWaitMicros.load() / taken : 0;
+    stats.maxWaitMicros = maxWaitMicros.load();
+    return stats;
+}
+
+// The body of each worker thread
+void KitchenWorkerPool::workerLoop() {
+    Order order;
+    long long waitMicros;
+    while (true) {
+        busyWorkers.fetch_add(1);  // Before the dequeue, so waitUntilIdle never misses a taken order
+        bool taken = activeOrders.dequeue(order, waitMicros);
+        if (taken && router != NULL) {
+            recordWait(waitMicros);
+            router->dispatch(std::move(order));  // The stations prepare, count and push it
+        } else if (taken) {
+            recordWait(waitMicros);
+            if (prepMicrosPerItem > 0) {  // Simulate preparing the items
+                this_thread::sleep_for(chrono::microseconds((long long)prepMicrosPerItem * order.getItemCount()));
+            }
+            order.setStatus("completed");
+            order.markCompleted();  // Logged with the same time the stack keeps
+            if (orderWal != NULL) {
+                orderWal->recordProcess(order);
+            }
+            itemsPrepared.fetch_add(order.getItemCount());
+            completedOrders->push(std::move(order));  // Locks the stack itself; the next dequeue refills order
+            ordersCompleted.fetch_add(1);
+        }
+        busyWorkers.fetch_sub(1);
+        if (taken) {
+            continue;
+        } else if (stopping.load()) {
+            // Re-check after seeing the stop flag: an order enqueued just before
+            // shutdown may have arrived after the failed dequeue above
+            if (activeOrders.isEmpty()) {
+                return;  // Shutdown requested and nothing left to drain
+            }
+        } else {
+            // Nothing to do: sleep briefly, or until shutdown is requested
+            unique_lock<mutex> lock(idleLock);
+            idleSignal.wait_for(lock, chrono::microseconds(200));
+        }
+    }
+}
+
+// Adds one queue-wait measurement to the statistics
+void KitchenWorkerPool::recordWait(long long waitMicros) {
+    ordersTaken.fetch_add(1);
+    totalWaitMicros.fetch_add(waitMicros);
+    long long currentMax = maxWaitMicros.load();
+    while (waitMicros > currentMax && !maxWaitMicros.compare_exchange_weak(currentMax, waitMicros)) {
+        // currentMax was reloaded by compare_exchange_weak; try again
+    }
+}
@@ -0,0 +1,214 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the KitchenWorkerPool class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   KitchenWorkerPool.cpp where the logic of each method is fully defined.
+   KitchenWorkerPool.h contains the declaration of the KitchenWorkerPool class.
+   This class is the kitchen execution engine. A configurable number of worker
+   threads take orders from a ConcurrentOrdersQueue, prepare them (simulated by
+   a fixed preparation time per item), mark them "completed" and push them onto
+   a CompletedOrdersStack. main.cpp and BatchRunner hand the orders they
+   process to it with submit, so the preparation runs in parallel with the
+   next command. The stack locks itself, so it may be read while the pool is
+   running; waitUntilIdle lets a reader see every submitted order first.
+
+   A pool can instead be bound to a StationRouter, as main.cpp and
+   BatchRunner use it. submit then splits each order into station tickets
+   right away, on the calling thread, so no order waits in a queue as a
+   whole; the stations prepare and push it. The workers dispatch orders that
+   other producers put on the queue directly. Since routing reads the menu,
+   the menu must not change until waitUntilIdle has returned.
+
+   Basic operations:
+     - Constructor: Creates a pool bound to an active queue and a completed stack,
+                    or to an active queue and a station router.
+     - Destructor:  Shuts the pool down if it is still running.
+     - start:       Starts the worker threads.
+     - submit:      Hands an order that already has its ID to the workers.
+     - waitUntilIdle: Waits until every submitted order has been completed.
+     - shutdown:    Lets the workers drain the queue, then stops and joins them.
+     - isRunning:   Checks whether the worker threads are running.
+     - getStats:    Returns throughput and queue-wait statistics.
+     - setOrderWAL: Logs each order's process record when it completes.
+
+   Private utility:
+     - workerLoop: The body of each worker thread.
+     - recordWait: Adds one queue-wait measurement to the statistics.
+
+   Data members:
+     - activeOrders:    The queue the workers take orders from.
+     - completedOrders: The stack completed orders are pushed onto, or NULL.
+     - router:          The router orders are dispatched to, or NULL.
+     - orderWal:        Write-ahead log receiving completed orders, or NULL.
+     - workerCount:     Number of worker threads.
+     - prepMicrosPerItem: Simulated preparation time per item, in microseconds.
+     - workers:         The worker threads.
+     - stopping:        Set by shutdown; workers exit once the queue is empty.
+     - busyWorkers:     Workers between taking an order and pushing it.
+     - idleLock, idleSignal: Let idle workers sleep until shutdown or a timeout.
+     - ordersTaken:     Orders taken from the queue; the wait average is over them.
+     - ordersCompleted, itemsPrepared, totalWaitMicros, maxWaitMicros: Counters.
+                        With a router, completions are counted by the router.
+     - startTime, stopTime: When the pool was started and shut down.
+
+--------------------------------------------------------------------------*/
+
+#ifndef KITCHENWORKERPOOL_H
+#define KITCHENWORKERPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CompletedOrdersStack.h"
+#include "ConcurrentOrdersQueue.h"
+#include "Order.h"
+#include "OrderWAL.h"
+#include "StationRouter.h"
+using namespace std;
+
+// Throughput and latency figures reported by KitchenWorkerPool::getStats.
+struct KitchenStats {
+    long ordersCompleted;     // Orders pushed onto the completed stack (by the stations, with a router).
+    long itemsPrepared;       // Items in those orders.
+    double elapsedSeconds;    // Time since start (or between start and shutdown).
+    double ordersPerSecond;   // ordersCompleted / elapsedSeconds.
+    double averageWaitMicros; // Mean time an order taken from the queue waited there.
+    long long maxWaitMicros;  // Longest time an order waited in the queue.
+};
+
+class KitchenWorkerPool {
+public:
+    KitchenWorkerPool(ConcurrentOrdersQueue&, CompletedOrdersStack&, int workerCount, int prepMicrosPerItem = 0);
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a pool of kitchen workers.
+
+      Precondition:  workerCount is a positive integer and prepMicrosPerItem
+                     is zero or positive. The queue and stack outlive the pool.
+      Postcondition: The pool is created but no threads are running.
+     -----------------------------------------------------------------------*/
+    KitchenWorkerPool(ConcurrentOrdersQueue&, StationRouter&, int workerCount);
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a pool of workers that dispatch orders to a router.
+
+      Precondition:  workerCount is a positive integer. The queue and router
+                     outlive the pool, and the router is started by its owner.
+      Postcondition: The pool is created but no threads are running. submit
+                     and the workers will pass each order to
+                     StationRouter::dispatch.
+     -----------------------------------------------------------------------*/
+    ~KitchenWorkerPool();
+    /*------------------------------------------------------------------------
+      Purpose:       Destructor: Shuts the pool down if it is still running.
+
+      Precondition:  None.
+      Postcondition: All worker threads have been joined.
+     -----------------------------------------------------------------------*/
+    void start();
+    /*------------------------------------------------------------------------
+      Purpose:       Starts the worker threads.
+
+      Precondition:  The pool is not running.
+      Postcondition: workerCount threads are processing orders.
+     -----------------------------------------------------------------------*/
+    void submit(Order&&);
+    /*------------------------------------------------------------------------
+      Purpose:       Hands an order to the kitchen.
+
+      Precondition:  The order has its ID and placed stamp, for example from
+                     ActiveOrdersQueue::dequeue. With a router, the menu is
+                     not being changed.
+      Postcondition: The order has been moved to the back of the queue with
+                     its ID and stamps, and an idle worker has been woken.
+                     With a router, it has instead been split into station
+                     tickets on the stations' queues.
+     -----------------------------------------------------------------------*/
+    void waitUntilIdle();
+    /*------------------------------------------------------------------------
+      Purpose:       Waits until the kitchen has nothing left to do.
+
+      Precondition:  No other thread submits orders meanwhile.
+      Postcondition: If the pool is running, the queue is empty and every
+                     order taken by a worker has been pushed onto the
+                     completed stack. With a router, the router is idle too.
+     -----------------------------------------------------------------------*/
+    void shutdown();
+    /*------------------------------------------------------------------------
+      Purpose:       Stops the pool after the queue has been drained.
+
+      Precondition:  Producers have stopped adding orders, otherwise the
+                     workers keep going as long as orders keep arriving.
+      Postcondition: Every order that was in the queue has been completed and
+                     all worker threads have been joined. With a router, the
+                     router has completed them too; it keeps running.
+     -----------------------------------------------------------------------*/
+    bool isRunning() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Checks whether the worker threads are running.
+
+      Precondition:  None.
+      Postcondition: Returns true between start and shutdown.
+     -----------------------------------------------------------------------*/
+    void setOrderWAL(OrderWAL*);
+    /*------------------------------------------------------------------------
+      Purpose:       Sets the write-ahead log completed orders are recorded in.
+
+      Precondition:  The pool (and its router) is not running, and the log
+                     outlives it. NULL turns logging off.
+      Postcondition: Each order is logged with OrderWAL::recordProcess when
+                     it is completed, before it is pushed. With a router the
+                     log is passed on to it, since the stations complete the
+                     orders.
+     -----------------------------------------------------------------------*/
+    KitchenStats getStats() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the throughput and queue-wait statistics.
+
+      Precondition:  None.
+      Postcondition: Returns the figures accumulated since start. With a
+                     router, ordersCompleted and itemsPrepared are the
+                     router's: an order counts once its last station ticket
+                     is done, not when it is dispatched.
+     -----------------------------------------------------------------------*/
+
+private:
+    KitchenWorkerPool(const KitchenWorkerPool&);            // Not copyable.
+    KitchenWorkerPool& operator=(const KitchenWorkerPool&);
+
+    void workerLoop();
+    /*------------------------------------------------------------------------
+      Purpose:       Runs one worker: dequeue, prepare, complete, repeat.
+
+      Precondition:  Called on a worker thread.
+      Postcondition: Returns once shutdown was requested and the queue is empty.
+     -----------------------------------------------------------------------*/
+    void recordWait(long long);
+    /*------------------------------------------------------------------------
+      Purpose:       Adds one queue-wait measurement to the statistics.
+
+      Precondition:  waitMicros is zero or positive.
+      Postcondition: ordersTaken, the total and the maximum wait have been updated.
+     -----------------------------------------------------------------------*/
+
+    ConcurrentOrdersQueue& activeOrders;   // Queue of orders waiting for the kitchen.
+    CompletedOrdersStack* completedOrders; // Stack of finished orders, or NULL.
+    StationRouter* router;                 // Router orders are dispatched to, or NULL.
+    OrderWAL* orderWal;                    // Log of completed orders, or NULL.
+    int workerCount;                       // Number of worker threads.
+    int prepMicrosPerItem;                 // Simulated preparation time per item.
+    vector<thread> workers;                // The worker threads.
+    atomic<bool> stopping;                 // True once shutdown has been requested.
+    atomic<int> busyWorkers;               // Workers holding an order not pushed yet.
+    mutex idleLock;                        // Used with idleSignal by idle workers.
+    condition_variable idleSignal;         // Wakes idle workers on shutdown.
+    atomic<long> ordersTaken;              // Orders taken from the queue since start.
+    atomic<long> ordersCompleted;          // Orders completed since start, without a router.
+    atomic<long> itemsPrepared;            // Items prepared since start, without a router.
+    atomic<long long> totalWaitMicros;     // Sum of queue waits.
+    atomic<long long> maxWaitMicros;       // Longest queue wait.
+    chrono::steady_clock::time_point startTime; // When start was called.
+    chrono::steady_clock::time_point stopTime;  // When shutdown finished.
+};
+
+#endif /* KITCHENWORKERPOOL_H */
@@ -0,0 +1,187 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the LatencyHistogram class.
+   LatencyHistogram is small and called on hot paths, so the whole
+   implementation lives in this header.
+   This class keeps a streaming histogram of non-negative durations in the
+   style of an HDR histogram: values below 16 have their own bucket, and
+   every power of two above that is split into 16 equal buckets. Recording a
+   value is a few instructions, memory is fixed (BUCKET_COUNT counters), and
+   any percentile can be read at any time to within 1/16 (6%) of the true
+   value, from single units up to 2^42. The unit is the caller's choice;
+   OperationStats records nanoseconds and TicketStats milliseconds.
+
+   Basic operations:
+     - Constructor:   Constructs an empty histogram.
+     - record:        Adds one value.
+     - remove:        Takes back a value added earlier.
+     - clear:         Removes every value.
+     - getCount:      Returns the number of values.
+     - getMean:       Returns the exact mean of the values.
+     - getMax:        Returns the largest value recorded.
+     - getPercentile: Returns a percentile of the values.
+     - bucketOf:      Maps a value to its bucket (static).
+     - bucketUpper:   Returns the largest value of a bucket (static).
+
+   Data members:
+     - counts:   Number of values in each bucket.
+     - count:    Number of values.
+     - total:    Sum of the values.
+     - maxValue: Largest value recorded.
+
+--------------------------------------------------------------------------*/
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKETS = 16;  // Buckets per power of two.
+    static const int MAX_BITS = 42;     // Values up to 2^42.
+    static const int BUCKET_COUNT = SUB_BUCKETS + (MAX_BITS - 4) * SUB_BUCKETS;
+
+    LatencyHistogram() {
+        clear();
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Constructs an empty histogram.
+
+      Precondition:  None.
+      Postcondition: getCount returns 0.
+     -----------------------------------------------------------------------*/
+    void record(long long value) {
+        counts[bucketOf(value)]++;
+        count++;
+        total += value;
+        if (value > maxValue) {
+            maxValue = value;
+        }
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Adds one value.
+
+      Precondition:  None; negative values count as 0 in the buckets.
+      Postcondition: The value is included in the count, mean, max and
+                     percentiles.
+     -----------------------------------------------------------------------*/
+    void remove(long long value) {
+        int bucket = bucketOf(value);
+        if (counts[bucket] > 0) {
+            counts[bucket]--;
+            count--;
+            total -= value;
+        }
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Takes back a value added earlier.
+
+      Precondition:  The value was recorded and not removed since.
+      Postcondition: The count, mean and percentiles no longer include it.
+                     The max stays the largest value ever recorded.
+     -----------------------------------------------------------------------*/
+    void clear() {
+        for (int b = 0; b < BUCKET_COUNT; ++b) {
+            counts[b] = 0;
+        }
+        count = 0;
+        total = 0;
+        maxValue = 0;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Removes every value.
+
+      Precondition:  None.
+      Postcondition: The histogram is empty.
+     -----------------------------------------------------------------------*/
+    long long getCount() const {
+        return count;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the number of values.
+
+      Precondition:  None.
+      Postcondition: Returns the count.
+     -----------------------------------------------------------------------*/
+    double getMean() const {
+        return count > 0 ? static_cast<double>(total) / count : 0;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the mean of the values.
+
+      Precondition:  None.
+      Postcondition: The mean is exact, not bucketed; 0 if empty.
+     -----------------------------------------------------------------------*/
+    long long getMax() const {
+        return maxValue;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the largest value recorded.
+
+      Precondition:  None.
+      Postcondition: Returns 0 if nothing was recorded.
+     -----------------------------------------------------------------------*/
+    long long getPercentile(double fraction) const {
+        if (count == 0) {
+            return 0;
+        }
+        long long rank = static_cast<long long>(fraction * count + 0.5);
+        if (rank < 1) {
+            rank = 1;
+        }
+        long long seen = 0;
+        for (int b = 0; b < BUCKET_COUNT; ++b) {
+            seen += counts[b];
+            if (seen >= rank) {
+                long long upper = bucketUpper(b);
+                return upper < maxValue ? upper : maxValue;
+            }
+        }
+        return maxValue;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Returns a percentile of the values.
+
+      Precondition:  fraction is between 0 and 1, e.g. 0.99 for p99.
+      Postcondition: Returns the upper bound of the bucket holding that share
+                     of the values, capped at the max; 0 if empty.
+     -----------------------------------------------------------------------*/
+
+    static int bucketOf(long long value) {
+        if (value < SUB_BUCKETS) {
+            return value < 0 ? 0 : static_cast<int>(value);
+        }
+        int bit = 63 - __builtin_clzll(static_cast<unsigned long long>(value));  // Highest set bit, 4 or more.
+        if (bit >= MAX_BITS) {
+            return BUCKET_COUNT - 1;
+        }
+        return (bit - 3) * SUB_BUCKETS + static_cast<int>((value >> (bit - 4)) & (SUB_BUCKETS - 1));
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Maps a value to its bucket.
+
+      Precondition:  None.
+      Postcondition: Returns a bucket below BUCKET_COUNT; values beyond the
+                     range go to the last bucket.
+     -----------------------------------------------------------------------*/
+    static long long bucketUpper(int bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        int bit = bucket / SUB_BUCKETS + 3;  // Highest set bit of the bucket's values
+        long long width = 1LL << (bit - 4);
+        return (SUB_BUCKETS + bucket % SUB_BUCKETS) * width + width - 1;
+    }
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the largest value that falls in a bucket.
+
+      Precondition:  The bucket is below BUCKET_COUNT.
+      Postcondition: bucketOf of the returned value is the bucket.
+     -----------------------------------------------------------------------*/
+
+private:
+    long long counts[BUCKET_COUNT];  // Values in each bucket.
+    long long count;                 // Number of values.
+    long long total;                 // Sum of the values.
+    long long maxValue;              // Largest value recorded.
+};
+
+#endif /* LATENCYHISTOGRAM_H */
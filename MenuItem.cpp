@@ -7,6 +7,9 @@
 //
 
 #include "MenuItem.h"
+#include <utility>
+
+static const char* const STATION_NAMES[STATION_COUNT] = {"line", "grill", "fryer", "cold", "bar"};
 
 // Default constructor: Initializes a menu item with default values.
 MenuItem::MenuItem() {
@@ -14,14 +17,16 @@ MenuItem::MenuItem() {
     name = "unknown";           // Default name is "unknown".
     desc = "no description";    // Default description is "no description".
     price = 0.0;                // Default price is 0.0.
+    station = STATION_LINE;     // Untagged items are made on the line.
 }
 
 // Parameterized constructor: Initializes a menu item with specified values.
-MenuItem::MenuItem(string name, string desc, double price) {
+MenuItem::MenuItem(string name, string desc, double price, PrepStation station) {
     this->id = 0;               // ID is set to 0 by default; it will be assigned later.
-    this->name = name;          // Assign the name.
-    this->desc = desc;          // Assign the description.
+    this->name = std::move(name);  // Take over the name; the parameter is already a copy.
+    this->desc = std::move(desc);  // Take over the description.
     this->price = price;        // Assign the price.
+    this->station = station;    // Assign the prep station.
 }
 
 // Sets the ID of the menu item.
@@ -31,12 +36,12 @@ void MenuItem::setId(int id) {
 
 // Sets the name of the menu item.
 void MenuItem::setName(string name) {
-    this->name = name;
+    this->name = std::move(name);  // The parameter is already a copy, so take it over.
 }
 
 // Sets the description of the menu item.
 void MenuItem::setDesc(string desc) {
-    this->desc = desc;
+    this->desc = std::move(desc);  // The parameter is already a copy, so take it over.
 }
 
 // Sets the price of the menu item.
@@ -44,6 +49,11 @@ void MenuItem::setPrice(double price) {
     this->price = price;
 }
 
+// Sets the prep station of the menu item.
+void MenuItem::setStation(PrepStation station) {
+    this->station = station;
+}
+
 // Returns the ID of the menu item.
 int MenuItem::getId() const {
     return id;
@@ -64,13 +74,37 @@ double MenuItem::getPrice() const {
     return price;
 }
 
+// Returns the prep station of the menu item.
+PrepStation MenuItem::getStation() const {
+    return station;
+}
+
+// Returns the name of a prep station.
+const char* MenuItem::getStationName(PrepStation station) {
+    return station >= 0 && station < STATION_COUNT ? STATION_NAMES[station] : "unknown";
+}
+
+// Reads a prep station from its name or number.
+bool MenuItem::parseStation(const string& text, PrepStation& station) {
+    for (int i = 0; i < STATION_COUNT; ++i) {
+        if (text == STATION_NAMES[i] || (text.size() == 1 && text[0] == '0' + i)) {
+            station = static_cast<PrepStation>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
 // Displays the menu item's details to the provided output stream.
 void MenuItem::display(ostream& out) const {
     out << "ID: " << id
         << ", Name: " << name
         << ", Description: " << desc
-        << ", Price: $" << price
-        << endl;
+        << ", Price: $" << price;
+    if (station != STATION_LINE) {
+        out << ", Station: " << STATION_NAMES[station];
+    }
+    out << endl;
 }
 
 // Overloaded << operator: Outputs the menu item's details.
@@ -7,17 +7,28 @@
    its unique identifier, name, description, and price. It provides functionality
    to access, modify, and display details of a menu item.
 
+   Each item is prepared at one kitchen station (line, grill, fryer, cold or
+   bar), which lets the kitchen split an order into one ticket per station.
+   Items that were never tagged belong to the line.
+
    Basic operations:
      - Default Constructor: Initializes a menu item with default values.
-     - Parameterized Constructor: Creates a menu item with specified name, description, and price.
+     - Parameterized Constructor: Creates a menu item with specified name, description, price
+       and, optionally, station.
+     - Copy and move constructors and assignment: Member-wise; moving takes over
+       the name and description strings instead of copying them.
      - setId:    Sets the unique ID of the menu item.
      - setName:  Sets the name of the menu item.
      - setDesc:  Sets the description of the menu item.
      - setPrice: Sets the price of the menu item.
+     - setStation: Sets the prep station of the menu item.
      - getId:    Retrieves the unique ID of the menu item.
      - getName:  Retrieves the name of the menu item.
      - getDesc:  Retrieves the description of the menu item.
      - getPrice: Retrieves the price of the menu item.
+     - getStation: Retrieves the prep station of the menu item.
+     - getStationName: Returns the name of a prep station (static).
+     - parseStation: Reads a prep station from its name or number (static).
      - display:  Outputs all details of the menu item in a formatted manner.
 
    Overloaded operators:
@@ -26,6 +37,7 @@
 
    Data members:
      - id:    A unique identifier for the menu item.
+     - station: The kitchen station that prepares the item.
      - name:  The name of the menu item.
      - desc:  A brief description of the menu item.
      - price: The price of the menu item.
@@ -39,6 +51,16 @@
 #include <string>
 using namespace std;
 
+// Kitchen stations a menu item can be prepared at.
+enum PrepStation {
+    STATION_LINE,       // The main line; the default for untagged items.
+    STATION_GRILL,      // Grilled meat and fish.
+    STATION_FRYER,      // Fries and anything battered.
+    STATION_COLD,       // Salads and desserts.
+    STATION_BAR,        // Drinks.
+    STATION_COUNT
+};
+
 class MenuItem {
 public:
     MenuItem();
@@ -49,14 +71,27 @@ public:
         Postcondition: A MenuItem object is created with default values (unknown name,
                        no description, and price set to 0).
     ------------------------------------------------------------------------*/
-    MenuItem( string, string, double);
+    MenuItem( string, string, double, PrepStation = STATION_LINE);
     /*------------------------------------------------------------------------
-         Purpose:       Constructs a MenuItem with the given name, description, and price.
+         Purpose:       Constructs a MenuItem with the given name, description, price
+                        and station.
 
          Precondition:  A valid name (string), description (string), and price (double)
                         are provided.
          Postcondition: A MenuItem object is created with the given name, description,
-                        and price set.
+                        price and station set. The strings are moved in from the parameters.
+       ------------------------------------------------------------------------*/
+    MenuItem(const MenuItem&) = default;
+    MenuItem(MenuItem&&) noexcept = default;
+    MenuItem& operator=(const MenuItem&) = default;
+    MenuItem& operator=(MenuItem&&) noexcept = default;
+    /*------------------------------------------------------------------------
+         Purpose:       Copy and move a MenuItem.
+
+         Precondition:  A valid MenuItem object is provided.
+         Postcondition: This item has the ID, name, description, price and station
+                        of `other`. A moved-from item keeps its ID, price and station, and
+                        its strings are left valid but unspecified.
        ------------------------------------------------------------------------*/
     void setId(int);
     /*------------------------------------------------------------------------
@@ -86,6 +121,13 @@ public:
           Precondition:  A valid price (double) is provided.
           Postcondition: The price of the MenuItem is updated with the provided value.
         ------------------------------------------------------------------------*/
+    void setStation(PrepStation);
+    /*------------------------------------------------------------------------
+          Purpose:       Sets the prep station of the menu item.
+
+          Precondition:  A valid station below STATION_COUNT is provided.
+          Postcondition: The item is prepared at the given station.
+        ------------------------------------------------------------------------*/
     int getId() const;
     /*------------------------------------------------------------------------
           Purpose:       Returns the ID of the menu item.
@@ -114,6 +156,30 @@ public:
          Precondition:  None.
          Postcondition: Returns the price of the MenuItem object.
        ------------------------------------------------------------------------*/
+    PrepStation getStation() const;
+    /*------------------------------------------------------------------------
+         Purpose:       Returns the prep station of the menu item.
+
+         Precondition:  None.
+         Postcondition: Returns the station the item is prepared at.
+       ------------------------------------------------------------------------*/
+    static const char* getStationName(PrepStation);
+    /*------------------------------------------------------------------------
+         Purpose:       Returns the name of a prep station.
+
+         Precondition:  None.
+         Postcondition: Returns "line", "grill", "fryer", "cold" or "bar", or
+                        "unknown" for a value outside the enum.
+       ------------------------------------------------------------------------*/
+    static bool parseStation(const string&, PrepStation&);
+    /*------------------------------------------------------------------------
+         Purpose:       Reads a prep station from its name or its number.
+
+         Precondition:  None.
+         Postcondition: If the text is a station name or a number from 0 to
+                        STATION_COUNT - 1, station is set and true is returned;
+                        otherwise station is unchanged and false is returned.
+       ------------------------------------------------------------------------*/
     void display(ostream&) const;
     /*------------------------------------------------------------------------
           Purpose:       Displays the details of the menu item (ID, name, description, and price) to
@@ -124,6 +190,7 @@ public:
         ------------------------------------------------------------------------*/
 private:
     int id;           // The ID of the menu item.
+    PrepStation station; // The kitchen station that prepares the item; fills the padding after id.
     string name;      // The name of the menu item.
     string desc;      // The description of the menu item.
     double price;     // The price of the menu item.
@@ -0,0 +1,269 @@
+// This is the implementation file for the MenuJournal class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, MenuJournal.h, provides the class structure and function declarations.
+
+//
+//  MenuJournal.cpp
+//
+
+#include "MenuJournal.h"
+#include <cstdio>
+#include <sstream>
+
+// Writes a menu to a temporary file and renames it over the snapshot
+static bool writeSnapshotFile(const DynamicArrayList& menu, const string& snapshotFile) {
+    string tempFile = snapshotFile + ".tmp";
+    ofstream out(tempFile.c_str(), ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    menu.writeMenu(out);
+    out.close();
+    if (out.fail()) {
+        remove(tempFile.c_str());
+        return false;
+    }
+    // rename replaces the old snapshot in one step, so readers never see half a file
+    return rename(tempFile.c_str(), snapshotFile.c_str()) == 0;
+}
+
+// Checks whether a file exists and can be opened
+static bool fileExists(const string& fileName) {
+    ifstream in(fileName.c_str());
+    return in.is_open();
+}
+
+// Constructor, binds the journal to a menu and its snapshot file
+MenuJournal::MenuJournal(DynamicArrayList& menu, const string& snapshotFile, int compactEvery)
+    : menu(menu), compactionDone(true), compactionSucceeded(false) {
+    this->snapshotFile = snapshotFile;
+    journalFile = snapshotFile + ".journal";
+    compactingFile = snapshotFile + ".journal.compacting";
+    this->compactEvery = compactEvery > 0 ? compactEvery : 1;
+    pendingRecords = 0;
+    compactions = 0;
+}
+
+// Destructor, finishes a running compaction before the menu can go away
+MenuJournal::~MenuJournal() {
+    finishCompaction(true);
+    journal.close();
+}
+
+// Rebuilds the menu from the snapshot plus any journal records
+bool MenuJournal::recover() {
+    finishCompaction(true);  // The snapshot must not change while it is read
+
+    if (!fileExists(snapshotFile)) {
+        ofstream create(snapshotFile.c_str(), ios::app);  // No snapshot yet: start from an empty menu
+    }
+    if (!menu.reloadIfChanged(snapshotFile)) {
+        return false;
+    }
+
+    bool leftover = fileExists(compactingFile);
+    replayFile(compactingFile);  // Left behind by a compaction that did not finish
+    replayFile(journalFile);
+
+    if (leftover) {
+        // Fold everything into a new snapshot now so the next compaction starts clean
+        journal.close();
+        if (writeSnapshotFile(menu, snapshotFile)) {
+            remove(compactingFile.c_str());
+            ofstream truncate(journalFile.c_str(), ios::trunc);
+            menu.rememberFile(snapshotFile);
+            pendingRecords = 0;
+        }
+    }
+    if (!journal.is_open()) {
+        journal.open(journalFile.c_str(), ios::app);
+    }
+    return true;
+}
+
+// Recovers again only if the snapshot was changed outside this journal
+bool MenuJournal::refresh() {
+    finishCompaction(false);
+    if (compactor.joinable()) {
+        return true;  // Our own compaction is rewriting the snapshot; memory is current
+    }
+    if (menu.hasFileChanged(snapshotFile)) {
+        return recover();
+    }
+    return menu.reloadIfChanged(snapshotFile);  // Unchanged: counted as an avoided reload
+}
+
+// Appends an "item added" record
+bool MenuJournal::recordAdd(const MenuItem& item) {
+    ostringstream line;
+    line << "A," << item.getId() << ',' << item.getName() << ','
+         << item.getDesc() << ',' << item.getPrice();
+    if (item.getStation() != STATION_LINE) {
+        line << ',' << MenuItem::getStationName(item.getStation());
+    }
+    return appendRecord(line.str());
+}
+
+// Appends an "item deleted" record
+bool MenuJournal::recordDelete(int id) {
+    ostringstream line;
+    line << "D," << id;
+    return appendRecord(line.str());
+}
+
+// Appends a "price changed" record
+bool MenuJournal::recordPriceChange(int id, double price) {
+    ostringstream line;
+    line << "P," << id << ',' << price;
+    return appendRecord(line.str());
+}
+
+// Appends a "station changed" record
+bool MenuJournal::recordStationChange(int id, PrepStation station) {
+    ostringstream line;
+    line << "S," << id << ',' << MenuItem::getStationName(station);
+    return appendRecord(line.str());
+}
+
+// Resets the menu and its snapshot file and discards all journal records
+bool MenuJournal::reset() {
+    finishCompaction(true);  // A compaction finishing later would bring the old menu back
+    bool cleared = menu.resetMenu(snapshotFile);
+    journal.close();
+    remove(compactingFile.c_str());
+    journal.open(journalFile.c_str(), ios::out | ios::trunc);
+    pendingRecords = 0;
+    return cleared;
+}
+
+// Starts a background compaction of the journal into the snapshot
+bool MenuJournal::compact() {
+    finishCompaction(false);
+    if (compactor.joinable()) {
+        return false;  // A compaction is still running
+    }
+
+    journal.close();
+    if (fileExists(compactingFile)) {
+        // An earlier compaction failed: keep its records by appending the journal to them
+        ifstream in(journalFile.c_str());
+        ofstream out(compactingFile.c_str(), ios::app);
+        out << in.rdbuf();
+        in.close();
+        out.close();
+        remove(journalFile.c_str());
+    } else {
+        rename(journalFile.c_str(), compactingFile.c_str());
+    }
+    journal.open(journalFile.c_str(), ios::out | ios::trunc);  // Fresh journal for new edits
+
+    pendingRecords = 0;
+    compactions++;
+    DynamicArrayList* copy = new DynamicArrayList(menu);  // The thread owns this copy
+    compactionDone = false;
+    compactor = thread(&MenuJournal::writeSnapshot, this, copy);
+    return true;
+}
+
+// Waits until a running compaction has finished
+void MenuJournal::waitForCompaction() {
+    finishCompaction(true);
+}
+
+// Returns the number of records since the last compaction
+int MenuJournal::getPendingRecords() const {
+    return pendingRecords;
+}
+
+// Returns the number of compactions started
+int MenuJournal::getCompactionCount() const {
+    return compactions;
+}
+
+// Writes one record line to the journal and starts a compaction when due
+bool MenuJournal::appendRecord(const string& line) {
+    if (!journal.is_open()) {
+        journal.open(journalFile.c_str(), ios::app);
+    }
+    journal << line << '\n';
+    journal.flush();  // The edit is in the file before the caller continues
+    if (journal.fail()) {
+        journal.clear();
+        return false;
+    }
+    pendingRecords++;
+    if (pendingRecords >= compactEvery) {
+        compact();
+    }
+    return true;
+}
+
+// Applies every record of a journal file to the menu
+void MenuJournal::replayFile(const string& fileName) {
+    ifstream in(fileName.c_str());
+    string line;
+    while (getline(in, line)) {
+        if (line.size() < 3 || line[1] != ',') {
+            continue;  // Blank or torn line
+        }
+        istringstream fields(line.substr(2));
+        int id;
+        double price;
+        if (!(fields >> id)) {
+            continue;
+        }
+        fields.ignore();  // The comma after the ID
+        if (line[0] == 'A') {
+            string name, description;
+            getline(fields, name, ',');
+            getline(fields, description, ',');
+            if (fields >> price) {
+                PrepStation station = STATION_LINE;
+                string stationName;
+                if (fields.get() == ',' && getline(fields, stationName)) {
+                    MenuItem::parseStation(stationName, station);
+                }
+                MenuItem item(name, description, price, station);
+                item.setId(id);
+                menu.restoreMenuItem(item);
+            }
+        } else if (line[0] == 'D') {
+            if (menu.findMenuItem(id) != NULL) {
+                menu.deleteMenuItem(id);
+            }
+        } else if (line[0] == 'P') {
+            if (fields >> price) {
+                menu.updateMenuItemPrice(id, price);
+            }
+        } else if (line[0] == 'S') {
+            string stationName;
+            PrepStation station;
+            if (getline(fields, stationName) && MenuItem::parseStation(stationName, station)) {
+                menu.updateMenuItemStation(id, station);
+            }
+        }
+    }
+}
+
+// Joins the compaction thread, optionally waiting for it
+void MenuJournal::finishCompaction(bool wait) {
+    if (!compactor.joinable() || (!wait && !compactionDone)) {
+        return;
+    }
+    compactor.join();
+    if (compactionSucceeded) {
+        // The snapshot plus the current journal equal the menu in memory
+        menu.rememberFile(snapshotFile);
+    }
+}
+
+// Body of the compaction thread
+void MenuJournal::writeSnapshot(DynamicArrayList* copy) {
+    bool written = writeSnapshotFile(*copy, snapshotFile);
+    if (written) {
+        remove(compactingFile.c_str());  // Its records are now in the snapshot
+    }
+    delete copy;
+    compactionSucceeded = written;
+    compactionDone = true;
+}
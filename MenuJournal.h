@@ -0,0 +1,226 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the MenuJournal class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   MenuJournal.cpp where the logic of each method is fully defined.
+   MenuJournal.h contains the declaration of the MenuJournal class.
+   This class persists menu edits without rewriting the whole menu file. The
+   menu file acts as a snapshot. Each add, delete, price or station change is appended
+   as one line to a journal file next to it ("<menu file>.journal"), so the
+   cost of an edit does not depend on the size of the menu.
+
+   Journal lines use the same comma-separated style as the menu file:
+     A,id,name,description,price[,station] - an item was added (or replaced)
+     D,id                          - an item was deleted
+     P,id,price                    - an item's price changed
+     S,id,station                  - an item's prep station changed
+   Every record sets state rather than changing it relative to the old state,
+   so replaying a record that is already part of the snapshot is harmless.
+
+   After a configurable number of records the journal is compacted. The current
+   journal is renamed to "<menu file>.journal.compacting" and a fresh journal
+   is started. A background thread then writes a copy of the menu to a
+   temporary file, renames it over the snapshot and deletes the compacting
+   file. Startup (recover) loads the snapshot and replays the compacting file,
+   if one was left behind, and then the journal.
+
+   Basic operations:
+     - Constructor: Binds the journal to a menu and its snapshot file.
+     - Destructor:  Waits for a running compaction and closes the journal.
+     - recover:     Rebuilds the menu from the snapshot plus the journal.
+     - refresh:     Recovers again only if the snapshot was changed by someone else.
+     - recordAdd, recordDelete, recordPriceChange, recordStationChange: Append one
+                   edit to the journal.
+     - reset:       Empties the menu, its snapshot and the journal.
+     - compact:     Starts a background compaction now.
+     - waitForCompaction: Waits for a running compaction to finish.
+     - getPendingRecords, getCompactionCount: Journal statistics.
+
+   Private utility:
+     - appendRecord:   Writes one line to the journal and flushes it.
+     - replayFile:     Applies every record in a journal file to the menu.
+     - finishCompaction: Joins a finished compaction thread.
+     - writeSnapshot:  Body of the compaction thread.
+
+   Data members:
+     - menu:           The menu being journaled.
+     - snapshotFile, journalFile, compactingFile: File names.
+     - journal:        Output stream of the journal file.
+     - compactEvery:   Number of records after which a compaction starts.
+     - pendingRecords: Records written since the last compaction started.
+     - compactions:    Number of compactions started.
+     - compactor:      The background compaction thread.
+     - compactionDone: Set by the compaction thread when it has finished.
+     - compactionSucceeded: Whether the last compaction wrote the snapshot.
+
+--------------------------------------------------------------------------*/
+
+#ifndef MENUJOURNAL_H
+#define MENUJOURNAL_H
+
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+using namespace std;
+
+class MenuJournal {
+public:
+    MenuJournal(DynamicArrayList&, const string&, int compactEvery = 1000);
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a journal for a menu stored in a snapshot file.
+
+      Precondition:  The menu outlives the journal. compactEvery is positive.
+      Postcondition: The journal is ready; call recover to load the menu.
+     -----------------------------------------------------------------------*/
+    ~MenuJournal();
+    /*------------------------------------------------------------------------
+      Purpose:       Destructor: Finishes any running compaction.
+
+      Precondition:  None.
+      Postcondition: The compaction thread has been joined and the journal closed.
+     -----------------------------------------------------------------------*/
+    bool recover();
+    /*------------------------------------------------------------------------
+      Purpose:       Rebuilds the menu from the snapshot and the journal.
+
+      Precondition:  None.
+      Postcondition: The menu holds the snapshot (empty if it does not exist)
+                     with the compacting file and the journal replayed on top.
+                     Returns false if the snapshot exists but cannot be read.
+     -----------------------------------------------------------------------*/
+    bool refresh();
+    /*------------------------------------------------------------------------
+      Purpose:       Makes sure the menu reflects outside changes to the snapshot.
+
+      Precondition:  None.
+      Postcondition: If the snapshot file was changed by something other than
+                     this journal, the menu is recovered again. Otherwise the
+                     in-memory menu is kept as is. Returns true on success.
+     -----------------------------------------------------------------------*/
+    bool recordAdd(const MenuItem&);
+    /*------------------------------------------------------------------------
+      Purpose:       Appends an "item added" record.
+
+      Precondition:  The item has already been added to the menu with its ID.
+      Postcondition: The record is in the journal; a compaction may start.
+                     Returns false if the journal could not be written.
+     -----------------------------------------------------------------------*/
+    bool recordDelete(int);
+    /*------------------------------------------------------------------------
+      Purpose:       Appends an "item deleted" record.
+
+      Precondition:  The item has already been deleted from the menu.
+      Postcondition: The record is in the journal; a compaction may start.
+                     Returns false if the journal could not be written.
+     -----------------------------------------------------------------------*/
+    bool recordPriceChange(int, double);
+    /*------------------------------------------------------------------------
+      Purpose:       Appends a "price changed" record.
+
+      Precondition:  The price has already been changed in the menu.
+      Postcondition: The record is in the journal; a compaction may start.
+                     Returns false if the journal could not be written.
+     -----------------------------------------------------------------------*/
+    bool recordStationChange(int, PrepStation);
+    /*------------------------------------------------------------------------
+      Purpose:       Appends a "station changed" record.
+
+      Precondition:  The station has already been changed in the menu.
+      Postcondition: The record is in the journal; a compaction may start.
+                     Returns false if the journal could not be written.
+     -----------------------------------------------------------------------*/
+    bool reset();
+    /*------------------------------------------------------------------------
+      Purpose:       Resets the menu and discards all journal records.
+
+      Precondition:  None.
+      Postcondition: A running compaction has finished first, so it cannot
+                     write the old menu back. The menu and its snapshot file
+                     are empty, and the journal and any compacting file are
+                     empty or removed. Returns false if the snapshot file
+                     could not be truncated.
+     -----------------------------------------------------------------------*/
+    bool compact();
+    /*------------------------------------------------------------------------
+      Purpose:       Starts a background compaction of the journal.
+
+      Precondition:  None.
+      Postcondition: Returns true if a compaction was started. Returns false
+                     if one is already running.
+     -----------------------------------------------------------------------*/
+    void waitForCompaction();
+    /*------------------------------------------------------------------------
+      Purpose:       Waits until a running compaction has finished.
+
+      Precondition:  None.
+      Postcondition: No compaction thread is running.
+     -----------------------------------------------------------------------*/
+    int getPendingRecords() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the number of records since the last compaction.
+
+      Precondition:  None.
+      Postcondition: Returns the pending record counter.
+     -----------------------------------------------------------------------*/
+    int getCompactionCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the number of compactions started.
+
+      Precondition:  None.
+      Postcondition: Returns the compaction counter.
+     -----------------------------------------------------------------------*/
+
+private:
+    MenuJournal(const MenuJournal&);            // Not copyable.
+    MenuJournal& operator=(const MenuJournal&);
+
+    bool appendRecord(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Writes one record line to the journal.
+
+      Precondition:  The line has no trailing newline.
+      Postcondition: The line is written and flushed, the pending counter is
+                     incremented and a compaction is started when due.
+     -----------------------------------------------------------------------*/
+    void replayFile(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Applies every record in a journal file to the menu.
+
+      Precondition:  None.
+      Postcondition: The records have been applied; a missing file is ignored.
+     -----------------------------------------------------------------------*/
+    void finishCompaction(bool);
+    /*------------------------------------------------------------------------
+      Purpose:       Joins the compaction thread.
+
+      Precondition:  None.
+      Postcondition: If wait is true, blocks until the thread is done;
+                     otherwise only joins a thread that has already finished.
+                     After a successful compaction the menu is marked in sync
+                     with the new snapshot.
+     -----------------------------------------------------------------------*/
+    void writeSnapshot(DynamicArrayList*);
+    /*------------------------------------------------------------------------
+      Purpose:       Writes a copy of the menu as the new snapshot.
+
+      Precondition:  Runs on the compaction thread, which owns the copy.
+      Postcondition: The snapshot has been replaced, the compacting file
+                     removed and the copy deleted.
+     -----------------------------------------------------------------------*/
+
+    DynamicArrayList& menu;   // The menu being journaled.
+    string snapshotFile;      // The menu file.
+    string journalFile;       // Journal of edits since the snapshot.
+    string compactingFile;    // Journal being folded into the snapshot.
+    ofstream journal;         // Open journal stream.
+    int compactEvery;         // Records between compactions.
+    int pendingRecords;       // Records since the last compaction started.
+    int compactions;          // Compactions started.
+    thread compactor;         // Background compaction thread.
+    atomic<bool> compactionDone;      // Set when the compaction thread is done.
+    atomic<bool> compactionSucceeded; // Whether the snapshot was written.
+};
+
+#endif /* MENUJOURNAL_H */
@@ -0,0 +1,123 @@
+// This is the implementation file for the MenuPriceIndex class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, MenuPriceIndex.h, provides the class structure and function declarations.
+
+//
+//  MenuPriceIndex.cpp
+//
+
+#include "MenuPriceIndex.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+// Constructor, starts empty and unbuilt
+MenuPriceIndex::MenuPriceIndex() {
+    built = false;
+}
+
+// Indexes every item of a menu
+void MenuPriceIndex::build(const MenuItem* items, int count) {
+    clear();
+    vector<pair<long long, int> > entries(count);
+    for (int i = 0; i < count; ++i) {
+        entries[i] = make_pair(toCents(items[i].getPrice()), i);  // Slot for now, ID below
+    }
+    sort(entries.begin(), entries.end());
+
+    // Sorted input with an end hint inserts in constant time per item
+    for (int i = 0; i < count; ++i) {
+        const MenuItem& item = items[entries[i].second];
+        pair<long long, int> entry(entries[i].first, item.getId());
+        allItems.insert(allItems.end(), entry);
+        byStation[item.getStation()].insert(byStation[item.getStation()].end(), entry);
+    }
+    built = true;
+}
+
+// Drops the index and its memory
+void MenuPriceIndex::clear() {
+    allItems.clear();
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        byStation[s].clear();
+    }
+    built = false;
+}
+
+// Returns true between build and the next clear
+bool MenuPriceIndex::isBuilt() const {
+    return built;
+}
+
+// Indexes one item under its current price and station
+void MenuPriceIndex::addItem(const MenuItem& item) {
+    if (!built) {
+        return;  // The next build picks the item up
+    }
+    pair<long long, int> entry(toCents(item.getPrice()), item.getId());
+    allItems.insert(entry);
+    byStation[item.getStation()].insert(entry);
+}
+
+// Removes one item under the price and station it was indexed with
+void MenuPriceIndex::removeItem(const MenuItem& item) {
+    if (!built) {
+        return;
+    }
+    pair<long long, int> entry(toCents(item.getPrice()), item.getId());
+    allItems.erase(entry);
+    byStation[item.getStation()].erase(entry);
+}
+
+// Collects the items priced from minCents to maxCents, cheapest first
+void MenuPriceIndex::findRange(long long minCents, long long maxCents, PrepStation station,
+                               vector<int>& ids) const {
+    ids.clear();
+    const PriceSet& prices = setFor(station);
+    PriceSet::const_iterator it = prices.lower_bound(make_pair(minCents, INT_MIN));
+    for (; it != prices.end() && it->first <= maxCents; ++it) {
+        ids.push_back(it->second);
+    }
+}
+
+// Collects the first count items of the set
+void MenuPriceIndex::findCheapest(int count, PrepStation station, vector<int>& ids) const {
+    ids.clear();
+    const PriceSet& prices = setFor(station);
+    size_t wanted = count > 0 ? count : 0;
+    for (PriceSet::const_iterator it = prices.begin(); it != prices.end() && ids.size() < wanted; ++it) {
+        ids.push_back(it->second);
+    }
+}
+
+// Collects the last count items of the set, one price at a time so equal prices go by ID
+void MenuPriceIndex::findPriciest(int count, PrepStation station, vector<int>& ids) const {
+    ids.clear();
+    const PriceSet& prices = setFor(station);
+    size_t wanted = count > 0 ? count : 0;
+    PriceSet::const_iterator groupEnd = prices.end();
+    while (groupEnd != prices.begin() && ids.size() < wanted) {
+        PriceSet::const_iterator last = groupEnd;
+        --last;
+        PriceSet::const_iterator groupStart = prices.lower_bound(make_pair(last->first, INT_MIN));
+        for (PriceSet::const_iterator it = groupStart; it != groupEnd && ids.size() < wanted; ++it) {
+            ids.push_back(it->second);
+        }
+        groupEnd = groupStart;  // On to the next lower price
+    }
+}
+
+// Returns the number of indexed items
+int MenuPriceIndex::getItemCount() const {
+    return static_cast<int>(allItems.size());
+}
+
+// Rounds a price to whole cents
+long long MenuPriceIndex::toCents(double price) {
+    return llround(price * 100);
+}
+
+// Returns the set of one station, or of the whole menu
+const MenuPriceIndex::PriceSet& MenuPriceIndex::setFor(PrepStation station) const {
+    return station >= 0 && station < STATION_COUNT ? byStation[station] : allItems;
+}
@@ -0,0 +1,160 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the MenuPriceIndex class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   MenuPriceIndex.cpp where the logic of each method is fully defined.
+   MenuPriceIndex.h contains the declaration of the MenuPriceIndex class.
+   This class keeps the menu items sorted by price, so questions like "every
+   item between $8 and $12" or "the 20 cheapest cold dishes" are answered
+   without scanning the menu.
+
+   Items are kept in ordered sets of (price in cents, item ID) pairs: one
+   for the whole menu and one per prep station. A price range starts with a
+   logarithmic search for its lower bound and then walks the set, so its cost
+   grows with the number of items returned, not the size of the menu. The N
+   cheapest or priciest items are the first or last N entries of a set.
+   Prices are compared in whole cents, and items of equal price are listed
+   by ID, lowest first.
+
+   Like MenuSearchIndex, the index is built by its owner on first use and
+   then kept up to date item by item: add an item after it joins the menu,
+   remove it before it leaves, and remove and add it again around a change
+   of price or station.
+
+   Basic operations:
+     - Constructor: Creates an empty index that is not built.
+     - build:     Indexes every item of a menu.
+     - clear:     Drops the index; it must be built again before a query.
+     - isBuilt:   Checks whether the index reflects the menu.
+     - addItem:   Indexes one item.
+     - removeItem: Removes one item, under the price and station it was indexed with.
+     - findRange: Returns the IDs of the items within a price range.
+     - findCheapest, findPriciest: Return the IDs of the N cheapest or priciest items.
+     - getItemCount: Number of indexed items.
+     - toCents:   Rounds a price to whole cents the way the index does (static).
+
+   Private utility:
+     - PriceSet:  An ordered set of (cents, ID) pairs.
+     - setFor:    The set of one station, or of the whole menu.
+
+   Data members:
+     - allItems:  Every indexed item, by price.
+     - byStation: The indexed items of each prep station, by price.
+     - built:     True while the index reflects the menu.
+
+--------------------------------------------------------------------------*/
+
+#ifndef MENUPRICEINDEX_H
+#define MENUPRICEINDEX_H
+
+#include <set>
+#include <utility>
+#include <vector>
+#include "MenuItem.h"
+using namespace std;
+
+class MenuPriceIndex {
+public:
+    MenuPriceIndex();
+    /*------------------------------------------------------------------------
+      Purpose:       Creates an empty index.
+
+      Precondition:  None.
+      Postcondition: The index holds nothing and is not built.
+     -----------------------------------------------------------------------*/
+    void build(const MenuItem*, int);
+    /*------------------------------------------------------------------------
+      Purpose:       Indexes every item of a menu.
+
+      Precondition:  items points to count menu items with distinct IDs.
+      Postcondition: Any previous contents are replaced; the index is built.
+     -----------------------------------------------------------------------*/
+    void clear();
+    /*------------------------------------------------------------------------
+      Purpose:       Drops the index and frees its memory.
+
+      Precondition:  None.
+      Postcondition: The index is empty and not built.
+     -----------------------------------------------------------------------*/
+    bool isBuilt() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Checks whether the index reflects the menu.
+
+      Precondition:  None.
+      Postcondition: Returns true between build and the next clear.
+     -----------------------------------------------------------------------*/
+    void addItem(const MenuItem&);
+    /*------------------------------------------------------------------------
+      Purpose:       Indexes one item under its current price and station.
+
+      Precondition:  The item's ID is not indexed.
+      Postcondition: If the index is built, the item can be found; otherwise
+                     nothing changes, as the next build will index it.
+     -----------------------------------------------------------------------*/
+    void removeItem(const MenuItem&);
+    /*------------------------------------------------------------------------
+      Purpose:       Removes one item from the index.
+
+      Precondition:  The item has the price and station it was indexed with.
+      Postcondition: The item is no longer found. Nothing changes if the index
+                     is not built.
+     -----------------------------------------------------------------------*/
+    void findRange(long long, long long, PrepStation, vector<int>&) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Finds the items priced within a range.
+
+      Precondition:  The index is built. Prices are in cents. A station of
+                     STATION_COUNT means every station.
+      Postcondition: ids holds the IDs of the items of that station priced
+                     from minCents to maxCents inclusive, cheapest first.
+     -----------------------------------------------------------------------*/
+    void findCheapest(int, PrepStation, vector<int>&) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Finds the cheapest items.
+
+      Precondition:  The index is built. A station of STATION_COUNT means
+                     every station.
+      Postcondition: ids holds the IDs of up to count items of that station,
+                     cheapest first.
+     -----------------------------------------------------------------------*/
+    void findPriciest(int, PrepStation, vector<int>&) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Finds the most expensive items.
+
+      Precondition:  The index is built. A station of STATION_COUNT means
+                     every station.
+      Postcondition: ids holds the IDs of up to count items of that station,
+                     most expensive first; items of equal price still go by
+                     ID, lowest first.
+     -----------------------------------------------------------------------*/
+    int getItemCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the number of indexed items.
+
+      Precondition:  None.
+      Postcondition: Returns the number of items in the index.
+     -----------------------------------------------------------------------*/
+    static long long toCents(double);
+    /*------------------------------------------------------------------------
+      Purpose:       Converts a price to the whole cents the index compares.
+
+      Precondition:  None.
+      Postcondition: Returns the price times 100, rounded to the nearest cent.
+     -----------------------------------------------------------------------*/
+
+private:
+    typedef set<pair<long long, int> > PriceSet;  // (cents, item ID), cheapest first.
+
+    const PriceSet& setFor(PrepStation) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Picks the set a query reads.
+
+      Precondition:  station is a prep station or STATION_COUNT.
+      Postcondition: Returns the station's set, or allItems for STATION_COUNT.
+     -----------------------------------------------------------------------*/
+
+    PriceSet allItems;                  // Every indexed item, by price.
+    PriceSet byStation[STATION_COUNT];  // The items of each station, by price.
+    bool built;                         // True while the index reflects the menu.
+};
+
+#endif /* MENUPRICEINDEX_H */
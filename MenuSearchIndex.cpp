@@ -0,0 +1,244 @@
+// This is the implementation file for the MenuSearchIndex class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, MenuSearchIndex.h, provides the class structure and function declarations.
+
+//
+//  MenuSearchIndex.cpp
+//
+
+#include "MenuSearchIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+// Packs three folded characters into one key
+static uint32_t makeKey(char a, char b, char c) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(a)) << 16)
+           | (static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8)
+           | static_cast<unsigned char>(c);
+}
+
+// One ranked search result
+struct SearchMatch {
+    int rank;        // Where the query was found, 0 is best.
+    int nameLength;  // Length of the folded name, shorter is better.
+    int id;          // Menu item ID, the final tie-break.
+
+    bool operator<(const SearchMatch& other) const {
+        if (rank != other.rank) {
+            return rank < other.rank;
+        }
+        if (nameLength != other.nameLength) {
+            return nameLength < other.nameLength;
+        }
+        return id < other.id;
+    }
+};
+
+// Constructor, starts empty and unbuilt
+MenuSearchIndex::MenuSearchIndex() {
+    liveEntries = 0;
+    staleEntries = 0;
+    built = false;
+}
+
+// Indexes every item of a menu
+void MenuSearchIndex::build(const MenuItem* items, int count) {
+    clear();
+    spans.reserve(count);
+    numberOfId.reserve(count);
+    built = true;
+    for (int i = 0; i < count; ++i) {
+        addItem(items[i]);
+    }
+}
+
+// Drops the index and its memory
+void MenuSearchIndex::clear() {
+    unordered_map<uint32_t, vector<int> >().swap(postings);
+    string().swap(textBuffer);
+    vector<TextSpan>().swap(spans);
+    unordered_map<int, int>().swap(numberOfId);
+    liveEntries = 0;
+    staleEntries = 0;
+    built = false;
+}
+
+// Returns true while the index reflects the menu
+bool MenuSearchIndex::isBuilt() const {
+    return built;
+}
+
+// Indexes one item
+void MenuSearchIndex::addItem(const MenuItem& item) {
+    if (!built) {
+        return;  // The next build picks it up
+    }
+    string name = fold(item.getName());
+    string desc = fold(item.getDesc());
+    vector<uint32_t> keys;
+    appendKeys(name, keys);
+    appendKeys(desc, keys);
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());  // One entry per key and item
+    int number = static_cast<int>(spans.size());
+    for (size_t k = 0; k < keys.size(); ++k) {
+        postings[keys[k]].push_back(number);  // Numbers only grow, so the lists stay sorted
+    }
+    liveEntries += keys.size();
+
+    TextSpan span = {item.getId(), static_cast<uint32_t>(textBuffer.size()),
+                     static_cast<uint32_t>(name.size() + 1 + desc.size()),
+                     static_cast<uint32_t>(name.size())};
+    spans.push_back(span);
+    textBuffer += name;
+    textBuffer += '\n';
+    textBuffer += desc;
+    numberOfId[item.getId()] = number;
+}
+
+// Forgets one item; its posting entries become stale
+void MenuSearchIndex::removeItem(int id) {
+    unordered_map<int, int>::iterator found = numberOfId.find(id);
+    if (!built || found == numberOfId.end()) {
+        return;
+    }
+    TextSpan& span = spans[found->second];
+    vector<uint32_t> keys;
+    appendKeys(textBuffer.substr(span.start, span.nameLength), keys);
+    appendKeys(textBuffer.substr(span.start + span.nameLength + 1, span.length - span.nameLength - 1), keys);
+    sort(keys.begin(), keys.end());
+    long long entries = unique(keys.begin(), keys.end()) - keys.begin();
+    liveEntries -= entries;
+    staleEntries += entries;
+    span.id = -1;  // Its posting entries are skipped from now on
+    numberOfId.erase(found);
+    if (staleEntries > liveEntries) {
+        clear();  // Cheaper to rebuild than to keep skipping the stale entries
+    }
+}
+
+// Finds the best matches of a query
+int MenuSearchIndex::search(const string& query, vector<int>& ids, int limit) const {
+    ids.clear();
+    string folded = fold(query);
+    if (folded.size() <= 1) {
+        return 0;  // Nothing searchable in the query
+    }
+    string core = folded.substr(1);  // Without the word boundary in front
+
+    // Short queries look up the word starts; longer ones their rarest trigram
+    bool wordsOnly = core.size() < 3;
+    const vector<int>* candidates = NULL;
+    if (wordsOnly) {
+        unordered_map<uint32_t, vector<int> >::const_iterator found =
+            postings.find(makeKey(' ', core[0], core.size() == 2 ? core[1] : '\0'));
+        if (found == postings.end()) {
+            return 0;
+        }
+        candidates = &found->second;
+    } else {
+        for (size_t i = 0; i + 3 <= core.size(); ++i) {
+            unordered_map<uint32_t, vector<int> >::const_iterator found =
+                postings.find(makeKey(core[i], core[i + 1], core[i + 2]));
+            if (found == postings.end()) {
+                return 0;  // No item has this trigram, so none has the query
+            }
+            if (candidates == NULL || found->second.size() < candidates->size()) {
+                candidates = &found->second;
+            }
+        }
+    }
+
+    vector<SearchMatch> matches;
+    const char* buffer = textBuffer.data();
+    for (size_t c = 0; c < candidates->size(); ++c) {
+        const TextSpan& span = spans[(*candidates)[c]];
+        if (span.id < 0) {
+            continue;  // Stale entry of a deleted item
+        }
+        int rank = rankMatch(buffer + span.start, span.length, span.nameLength, core, wordsOnly);
+        if (rank >= 0) {
+            SearchMatch match = {rank, static_cast<int>(span.nameLength), span.id};
+            matches.push_back(match);
+        }
+    }
+
+    size_t shown = min(matches.size(), static_cast<size_t>(max(limit, 0)));
+    partial_sort(matches.begin(), matches.begin() + shown, matches.end());
+    for (size_t i = 0; i < shown; ++i) {
+        ids.push_back(matches[i].id);
+    }
+    return static_cast<int>(matches.size());
+}
+
+// Returns the number of indexed items
+int MenuSearchIndex::getItemCount() const {
+    return static_cast<int>(numberOfId.size());
+}
+
+// Returns the number of posting lists
+int MenuSearchIndex::getKeyCount() const {
+    return static_cast<int>(postings.size());
+}
+
+// Lowercases a text and reduces everything between words to one space
+string MenuSearchIndex::fold(const string& text) {
+    string folded(1, ' ');
+    folded.reserve(text.size() + 1);
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (isalnum(c) || c >= 0x80) {
+            folded += static_cast<char>(tolower(c));
+        } else if (folded[folded.size() - 1] != ' ') {
+            folded += ' ';
+        }
+    }
+    if (folded.size() > 1 && folded[folded.size() - 1] == ' ') {
+        folded.erase(folded.size() - 1);
+    }
+    return folded;
+}
+
+// Appends every trigram and every word's first letter
+void MenuSearchIndex::appendKeys(const string& folded, vector<uint32_t>& keys) {
+    for (size_t i = 0; i + 3 <= folded.size(); ++i) {
+        keys.push_back(makeKey(folded[i], folded[i + 1], folded[i + 2]));
+    }
+    for (size_t i = 0; i + 1 < folded.size(); ++i) {
+        if (folded[i] == ' ') {
+            keys.push_back(makeKey(' ', folded[i + 1], '\0'));
+        }
+    }
+}
+
+// Ranks the best occurrence of the query in a candidate's text
+int MenuSearchIndex::rankMatch(const char* data, size_t length, size_t nameLength, const string& query,
+                               bool wordsOnly) {
+    string_view text(data, length);
+    string_view pattern(query);
+    int best = -1;
+    for (size_t at = text.find(pattern); at != string_view::npos; at = text.find(pattern, at + 1)) {
+        bool wordStart = text[at - 1] == ' ';  // Folded texts start with a space
+        int rank;
+        if (at < nameLength) {
+            if (at == 1 && nameLength == query.size() + 1) {
+                rank = 0;  // The whole name
+            } else {
+                rank = at == 1 ? 1 : wordStart ? 2 : 3;
+            }
+        } else {
+            rank = wordStart ? 4 : 5;
+        }
+        if (wordsOnly && !wordStart) {
+            continue;
+        }
+        if (best < 0 || rank < best) {
+            best = rank;
+        }
+        if (best <= 1) {
+            break;  // Nothing later in the text ranks higher
+        }
+    }
+    return best;
+}
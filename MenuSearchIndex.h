@@ -0,0 +1,194 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the MenuSearchIndex class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   MenuSearchIndex.cpp where the logic of each method is fully defined.
+   MenuSearchIndex.h contains the declaration of the MenuSearchIndex class.
+   This class is a trigram index over the names and descriptions of the menu
+   items, so staff can find a dish by any part of its name or description
+   without scanning the menu.
+
+   Both texts are folded before indexing: letters are lowercased and every
+   run of other characters becomes one space, with a space in front, so
+   "Fish & Chips" is " fish chips". Every three consecutive characters of a
+   folded text (a trigram) is a key whose posting list holds the items
+   containing it. Each word also adds a key for its first letter alone.
+   Items are numbered in the order they are indexed, and the posting lists
+   hold these numbers, so every list is in ascending order. The folded texts
+   are stored back to back in one buffer in the same order. A search reads
+   the candidates' texts from front to back instead of jumping around memory.
+
+   A query of three or more characters is a substring query. The posting list
+   of the query trigram with the fewest items gives the candidates, and each
+   candidate is checked against its folded text, so only a few items are
+   looked at even on a large menu. A query of one or two characters is a
+   word-prefix query: its key is the space plus the query, which only word
+   starts contain. Matches are ranked by where the query was found: equal to
+   the name, start of the name, start of a word of the name, inside the name,
+   start of a word of the description, inside the description. Ties go to
+   the shorter name, then to the lower ID.
+
+   The index is kept up to date item by item. A deleted item leaves its
+   number in the posting lists and its text in the buffer; they are skipped
+   because the number no longer maps to an item ID. Once the stale entries
+   outnumber the live ones the index drops itself, and the owner rebuilds it
+   on the next search.
+
+   Basic operations:
+     - Constructor: Creates an empty index that is not built.
+     - build:     Indexes every item of a menu.
+     - clear:     Drops the index; it must be built again before a search.
+     - isBuilt:   Checks whether the index reflects the menu.
+     - addItem:   Indexes one new item.
+     - removeItem: Removes one item.
+     - search:    Returns the IDs of the best matches of a query.
+     - getItemCount, getKeyCount: Size of the index.
+     - fold:      Folds a text the way the index does (static).
+
+   Private utility:
+     - TextSpan:   Where an indexed item's text is in the buffer.
+     - appendKeys: Collects the keys of a folded text.
+     - rankMatch:  Ranks one match of the query in a candidate's text.
+
+   Data members:
+     - postings:     The item numbers of each key, ascending.
+     - textBuffer:   The folded "name\ndescription" of every indexed item, back to back.
+     - spans:        Where each item number's text is, and its item ID (-1 once deleted).
+     - numberOfId:   The item number of each live item ID.
+     - liveEntries:  Posting list entries of live items.
+     - staleEntries: Posting list entries left behind by deleted items.
+     - built:        True while the index reflects the menu.
+
+--------------------------------------------------------------------------*/
+
+#ifndef MENUSEARCHINDEX_H
+#define MENUSEARCHINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MenuItem.h"
+using namespace std;
+
+class MenuSearchIndex {
+public:
+    MenuSearchIndex();
+    /*------------------------------------------------------------------------
+      Purpose:       Creates an empty index.
+
+      Precondition:  None.
+      Postcondition: The index holds nothing and is not built.
+     -----------------------------------------------------------------------*/
+    void build(const MenuItem*, int);
+    /*------------------------------------------------------------------------
+      Purpose:       Indexes every item of a menu.
+
+      Precondition:  items points to count menu items with distinct IDs.
+      Postcondition: Any previous contents are replaced; the index is built.
+     -----------------------------------------------------------------------*/
+    void clear();
+    /*------------------------------------------------------------------------
+      Purpose:       Drops the index and frees its memory.
+
+      Precondition:  None.
+      Postcondition: The index is empty and not built.
+     -----------------------------------------------------------------------*/
+    bool isBuilt() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Checks whether the index reflects the menu.
+
+      Precondition:  None.
+      Postcondition: Returns true between build and the next clear.
+     -----------------------------------------------------------------------*/
+    void addItem(const MenuItem&);
+    /*------------------------------------------------------------------------
+      Purpose:       Indexes one item added to the menu.
+
+      Precondition:  The item's ID has not been indexed since the last build,
+                     not even for an item that was removed since.
+      Postcondition: If the index is built, the item can be found; otherwise
+                     nothing changes, as the next build will index it.
+     -----------------------------------------------------------------------*/
+    void removeItem(int);
+    /*------------------------------------------------------------------------
+      Purpose:       Removes one item deleted from the menu.
+
+      Precondition:  None.
+      Postcondition: The item is no longer found. If stale entries now
+                     outnumber live ones, the index is cleared instead.
+     -----------------------------------------------------------------------*/
+    int search(const string&, vector<int>&, int limit = 20) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Finds the items whose name or description contains a query.
+
+      Precondition:  The index is built. limit is positive.
+      Postcondition: ids holds the IDs of the best `limit` matches, best
+                     first (see the ranking above). Returns the number of
+                     matching items, which may be more than limit. A query
+                     that folds to nothing matches nothing.
+     -----------------------------------------------------------------------*/
+    int getItemCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the number of indexed items.
+
+      Precondition:  None.
+      Postcondition: Returns the number of live items in the index.
+     -----------------------------------------------------------------------*/
+    int getKeyCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the number of distinct keys.
+
+      Precondition:  None.
+      Postcondition: Returns the number of posting lists.
+     -----------------------------------------------------------------------*/
+    static string fold(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Folds a text for indexing or searching.
+
+      Precondition:  None.
+      Postcondition: Returns the text lowercased, with a space in front and
+                     every run of ASCII characters other than letters and
+                     digits replaced by one space. Bytes of UTF-8 characters
+                     are kept as they are. Trailing spaces are dropped.
+     -----------------------------------------------------------------------*/
+
+private:
+    static void appendKeys(const string&, vector<uint32_t>&);
+    /*------------------------------------------------------------------------
+      Purpose:       Collects the keys of a folded text.
+
+      Precondition:  The text was produced by fold.
+      Postcondition: Every trigram of the text and the first letter of every
+                     word have been appended as keys, duplicates included.
+     -----------------------------------------------------------------------*/
+    // Where one indexed item's folded text is in textBuffer.
+    struct TextSpan {
+        int id;             // The item's ID, or -1 once it was removed.
+        uint32_t start;     // Offset of the text in textBuffer.
+        uint32_t length;    // Length of "name\ndescription".
+        uint32_t nameLength; // Length of the folded name.
+    };
+
+    static int rankMatch(const char*, size_t, size_t, const string&, bool);
+    /*------------------------------------------------------------------------
+      Purpose:       Ranks where a folded query occurs in a candidate's text.
+
+      Precondition:  The text holds length characters: the folded name, '\n',
+                     the folded description, and nameLength is the length of
+                     the name part. The query is folded, without its leading
+                     space.
+      Postcondition: Returns 0 (best) to 5 as described above, or -1 if the
+                     query does not occur in the text. With wordsOnly, only
+                     occurrences at the start of a word count.
+     -----------------------------------------------------------------------*/
+
+    unordered_map<uint32_t, vector<int> > postings; // Item numbers of each key, ascending.
+    string textBuffer;                              // Folded texts of every indexed item.
+    vector<TextSpan> spans;                         // Text and ID of each item number.
+    unordered_map<int, int> numberOfId;             // Item number of each live item ID.
+    long long liveEntries;                          // Posting entries of live items.
+    long long staleEntries;                         // Posting entries of deleted items.
+    bool built;                                     // True while the index reflects the menu.
+};
+
+#endif /* MENUSEARCHINDEX_H */
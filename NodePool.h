@@ -0,0 +1,233 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the NodePool class template.
+   NodePool is a template, so the whole implementation lives in this header.
+   This class hands out raw storage for objects of type T from large blocks
+   (slabs) instead of calling new and delete for every object. New slots are
+   carved from the current block in order. Freed slots are kept on a freelist
+   and handed out again before any new slot is used, so once the
+   pool has warmed up, allocating and freeing a node never reaches the system
+   allocator. Memory is returned to the system only when the pool is destroyed.
+
+   The pool only manages storage. Callers construct objects with placement new
+   and must call the destructor themselves before releasing a slot.
+
+   Basic operations:
+     - Constructor: Constructs an empty pool with a given number of slots per block.
+     - Destructor:  Releases every block owned by the pool.
+     - allocate:    Returns storage for one T, reusing a freed slot when possible.
+     - deallocate:  Returns a slot to the freelist.
+     - setBlockSize: Changes the number of slots in blocks allocated from now on.
+     - swap:        Exchanges the blocks and slots of two pools.
+     - getStats:    Returns the allocation statistics of the pool.
+
+   Data members:
+     - blocks:    Linked list of the blocks owned by the pool.
+     - freeList:  Linked list of slots that were freed and can be reused.
+     - nextSlot:  The next never-used slot in the current block.
+     - endSlot:   One past the last slot of the current block.
+     - blockSize: Number of slots in each newly allocated block.
+     - stats:     Counters describing how the pool has been used.
+
+--------------------------------------------------------------------------*/
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Counters reported by NodePool::getStats.
+struct PoolStats {
+    long allocations;    // Number of calls to allocate.
+    long deallocations;  // Number of calls to deallocate.
+    long reuses;         // Allocations served from the freelist.
+    int blocks;          // Number of blocks obtained from the system.
+    int blockSize;       // Slots per block for new blocks.
+    long slots;          // Total number of slots owned by the pool.
+    long inUse;          // Slots currently handed out.
+};
+
+template <class T>
+class NodePool {
+public:
+    explicit NodePool(int blockSize = 256);
+    /*------------------------------------------------------------------------
+      Purpose:       Constructs an empty pool.
+
+      Precondition:  blockSize is a positive integer.
+      Postcondition: A pool with no blocks has been created; the first
+                     allocation obtains a block of `blockSize` slots.
+     -----------------------------------------------------------------------*/
+    ~NodePool();
+    /*------------------------------------------------------------------------
+      Purpose:       Destructor: Releases every block owned by the pool.
+
+      Precondition:  Every object constructed in the pool has been destroyed.
+      Postcondition: All memory obtained by the pool has been returned.
+     -----------------------------------------------------------------------*/
+    void* allocate();
+    /*------------------------------------------------------------------------
+      Purpose:       Returns uninitialized storage for one object of type T.
+
+      Precondition:  None.
+      Postcondition: A freed slot is reused if there is one; otherwise a new
+                     slot is taken from the current block, obtaining a new
+                     block when the current one is used up.
+     -----------------------------------------------------------------------*/
+    void deallocate(void*);
+    /*------------------------------------------------------------------------
+      Purpose:       Returns a slot to the pool.
+
+      Precondition:  The pointer was returned by allocate on this pool and the
+                     object in it has already been destroyed.
+      Postcondition: The slot is on the freelist and will be reused.
+     -----------------------------------------------------------------------*/
+    void setBlockSize(int);
+    /*------------------------------------------------------------------------
+      Purpose:       Sets the number of slots in blocks allocated from now on.
+
+      Precondition:  The new block size is a positive integer.
+      Postcondition: Existing blocks are unchanged; later blocks use the new size.
+     -----------------------------------------------------------------------*/
+    void swap(NodePool&);
+    /*------------------------------------------------------------------------
+      Purpose:       Exchanges the storage of two pools.
+
+      Precondition:  None.
+      Postcondition: Each pool owns the blocks, free slots and usage counters
+                     the other had, so objects allocated from one are now
+                     released to the other. Each pool keeps its block size.
+     -----------------------------------------------------------------------*/
+    PoolStats getStats() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the allocation statistics of the pool.
+
+      Precondition:  None.
+      Postcondition: Returns a copy of the current counters.
+     -----------------------------------------------------------------------*/
+
+private:
+    NodePool(const NodePool&);             // Pools own their memory and are not copied.
+    NodePool& operator=(const NodePool&);
+
+    // A slot either holds a live object or, while free, the next free slot.
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    // A block is a header followed by its slots in the same allocation.
+    struct Block {
+        Block* next;
+    };
+
+    void addBlock();
+    /*------------------------------------------------------------------------
+      Purpose:       Obtains a new block and makes it the current block.
+
+      Precondition:  The current block has no unused slots left.
+      Postcondition: `blockSize` new slots are available to allocate.
+     -----------------------------------------------------------------------*/
+
+    Block* blocks;    // Blocks owned by the pool, most recent first.
+    Slot* freeList;   // Freed slots, most recently freed first.
+    Slot* nextSlot;   // Next unused slot in the current block.
+    Slot* endSlot;    // End of the current block.
+    int blockSize;    // Slots per block for new blocks.
+    PoolStats stats;  // Usage counters.
+};
+
+template <class T>
+NodePool<T>::NodePool(int blockSize) {
+    blocks = NULL;
+    freeList = NULL;
+    nextSlot = NULL;
+    endSlot = NULL;
+    this->blockSize = blockSize > 0 ? blockSize : 1;
+    stats.allocations = 0;
+    stats.deallocations = 0;
+    stats.reuses = 0;
+    stats.blocks = 0;
+    stats.blockSize = this->blockSize;
+    stats.slots = 0;
+    stats.inUse = 0;
+}
+
+template <class T>
+NodePool<T>::~NodePool() {
+    while (blocks != NULL) {
+        Block* temp = blocks;
+        blocks = blocks->next;
+        ::operator delete(temp);
+    }
+}
+
+template <class T>
+void* NodePool<T>::allocate() {
+    Slot* slot;
+    if (freeList != NULL) {
+        slot = freeList;          // Reuse the most recently freed slot.
+        freeList = slot->next;
+        stats.reuses++;
+    } else {
+        if (nextSlot == endSlot) {
+            addBlock();
+        }
+        slot = nextSlot++;        // Carve a new slot from the current block.
+    }
+    stats.allocations++;
+    stats.inUse++;
+    return slot->storage;
+}
+
+template <class T>
+void NodePool<T>::deallocate(void* pointer) {
+    if (pointer == NULL) {
+        return;
+    }
+    Slot* slot = static_cast<Slot*>(pointer);
+    slot->next = freeList;
+    freeList = slot;
+    stats.deallocations++;
+    stats.inUse--;
+}
+
+template <class T>
+void NodePool<T>::setBlockSize(int blockSize) {
+    if (blockSize > 0) {
+        this->blockSize = blockSize;
+        stats.blockSize = blockSize;
+    }
+}
+
+template <class T>
+void NodePool<T>::swap(NodePool& other) {
+    std::swap(blocks, other.blocks);
+    std::swap(freeList, other.freeList);
+    std::swap(nextSlot, other.nextSlot);
+    std::swap(endSlot, other.endSlot);
+    std::swap(stats, other.stats);
+    std::swap(stats.blockSize, other.stats.blockSize);  // The block sizes stay with their pools
+}
+
+template <class T>
+PoolStats NodePool<T>::getStats() const {
+    return stats;
+}
+
+template <class T>
+void NodePool<T>::addBlock() {
+    // The slots start after the header, rounded up to the slot alignment.
+    size_t header = (sizeof(Block) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+    void* memory = ::operator new(header + sizeof(Slot) * blockSize);
+    Block* block = static_cast<Block*>(memory);
+    block->next = blocks;
+    blocks = block;
+
+    nextSlot = reinterpret_cast<Slot*>(static_cast<char*>(memory) + header);
+    endSlot = nextSlot + blockSize;
+    stats.blocks++;
+    stats.slots += blockSize;
+}
+
+#endif /* NODEPOOL_H */
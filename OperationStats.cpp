@@ -0,0 +1,159 @@
+// This is the implementation file for the OperationStats class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, OperationStats.h, provides the class structure and function declarations.
+
+//
+//  OperationStats.cpp
+//
+
+#include "OperationStats.h"
+#include <cstdio>
+#include <fstream>
+
+const int OperationStats::BUCKET_COUNT;
+const long long OperationStats::ALWAYS_TIMED;
+
+// After the first calls, in-memory operations are timed once per 16 or 64 calls
+const long long OperationStats::SAMPLE_MASKS[STAT_OP_COUNT] = {
+    15,  // enqueue
+    15,  // dequeue
+    15,  // delete_order
+    63,  // find_menu_item
+    0,   // search_menu
+    15,  // price_query
+    0,   // load_menu
+    0,   // save_completed
+    0    // save_log_report
+};
+
+static const char* const OPERATION_NAMES[STAT_OP_COUNT] = {
+    "enqueue", "dequeue", "delete_order", "find_menu_item",
+    "search_menu", "price_query", "load_menu", "save_completed", "save_log_report"
+};
+
+OperationStats::Counters OperationStats::counters[STAT_OP_COUNT];
+
+// Checks whether this build records statistics
+bool OperationStats::isEnabled() {
+#ifdef RMS_NO_STATS
+    return false;
+#else
+    return true;
+#endif
+}
+
+// Returns the name of an operation
+const char* OperationStats::getName(StatOp op) {
+    return OPERATION_NAMES[op];
+}
+
+// Returns the counters and percentiles of an operation
+StatSummary OperationStats::getSummary(StatOp op) {
+    const Counters& c = counters[op];
+    StatSummary summary;
+    summary.calls = c.calls.load(memory_order_relaxed);
+    summary.timed = c.timed.load(memory_order_relaxed);
+    summary.bytes = c.bytes.load(memory_order_relaxed);
+    summary.maxNs = c.maxNs.load(memory_order_relaxed);
+    summary.meanNs = summary.timed > 0
+                     ? static_cast<double>(c.totalNs.load(memory_order_relaxed)) / summary.timed : 0;
+    summary.p50Ns = percentileNs(c, summary.timed, 0.5);
+    summary.p90Ns = percentileNs(c, summary.timed, 0.9);
+    summary.p99Ns = percentileNs(c, summary.timed, 0.99);
+    summary.p999Ns = percentileNs(c, summary.timed, 0.999);
+    return summary;
+}
+
+// Writes a table of every operation
+void OperationStats::writeReport(ostream& out) {
+    if (!isEnabled()) {
+        out << "Statistics are disabled in this build (RMS_NO_STATS).\n";
+        return;
+    }
+    char line[160];
+    snprintf(line, sizeof(line), "%-16s %10s %8s %12s %9s %9s %9s %9s %9s\n", "operation",
+             "calls", "timed", "bytes", "mean us", "p50 us", "p99 us", "p999 us", "max us");
+    out << line;
+    for (int op = 0; op < STAT_OP_COUNT; ++op) {
+        StatSummary s = getSummary(static_cast<StatOp>(op));
+        snprintf(line, sizeof(line), "%-16s %10lld %8lld %12lld %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+                 OPERATION_NAMES[op], s.calls, s.timed, s.bytes, s.meanNs / 1000,
+                 s.p50Ns / 1000.0, s.p99Ns / 1000.0, s.p999Ns / 1000.0, s.maxNs / 1000.0);
+        out << line;
+    }
+}
+
+// Writes every operation, with its histogram, as JSON
+void OperationStats::writeJson(ostream& out) {
+    out << "{\"enabled\": " << (isEnabled() ? "true" : "false") << ", \"operations\": [";
+    for (int op = 0; op < STAT_OP_COUNT; ++op) {
+        StatSummary s = getSummary(static_cast<StatOp>(op));
+        char mean[32];
+        snprintf(mean, sizeof(mean), "%.1f", s.meanNs);
+        out << (op > 0 ? ", " : "") << "{\"name\": \"" << OPERATION_NAMES[op] << "\""
+            << ", \"calls\": " << s.calls << ", \"timed\": " << s.timed
+            << ", \"sample_every\": " << SAMPLE_MASKS[op] + 1 << ", \"bytes\": " << s.bytes
+            << ", \"mean_ns\": " << mean << ", \"p50_ns\": " << s.p50Ns
+            << ", \"p90_ns\": " << s.p90Ns << ", \"p99_ns\": " << s.p99Ns
+            << ", \"p999_ns\": " << s.p999Ns << ", \"max_ns\": " << s.maxNs
+            << ", \"histogram\": [";
+        bool first = true;
+        for (int b = 0; b < BUCKET_COUNT; ++b) {
+            long long count = counters[op].buckets[b].load(memory_order_relaxed);
+            if (count > 0) {
+                out << (first ? "" : ", ") << '[' << LatencyHistogram::bucketUpper(b) << ", " << count << ']';
+                first = false;
+            }
+        }
+        out << "]}";
+    }
+    out << "]}\n";
+}
+
+// Writes the JSON to a file
+bool OperationStats::saveJson(const string& fileName) {
+    ofstream file(fileName.c_str());
+    if (!file.is_open()) {
+        cerr << "Failed to open file" << endl;
+        return false;
+    }
+    writeJson(file);
+    file.close();
+    return !file.fail();
+}
+
+// Clears every counter and histogram
+void OperationStats::reset() {
+    for (int op = 0; op < STAT_OP_COUNT; ++op) {
+        Counters& c = counters[op];
+        c.calls.store(0, memory_order_relaxed);
+        c.timed.store(0, memory_order_relaxed);
+        c.totalNs.store(0, memory_order_relaxed);
+        c.maxNs.store(0, memory_order_relaxed);
+        c.bytes.store(0, memory_order_relaxed);
+        for (int b = 0; b < BUCKET_COUNT; ++b) {
+            c.buckets[b].store(0, memory_order_relaxed);
+        }
+    }
+}
+
+// Reads a percentile from a histogram
+long long OperationStats::percentileNs(const Counters& c, long long timed, double fraction) {
+    if (timed == 0) {
+        return 0;
+    }
+    long long rank = static_cast<long long>(fraction * timed + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    long long seen = 0;
+    for (int b = 0; b < BUCKET_COUNT; ++b) {
+        seen += c.buckets[b].load(memory_order_relaxed);
+        if (seen >= rank) {
+            long long upper = LatencyHistogram::bucketUpper(b);
+            long long slowest = c.maxNs.load(memory_order_relaxed);
+            return upper < slowest ? upper : slowest;
+        }
+    }
+    return c.maxNs.load(memory_order_relaxed);
+}
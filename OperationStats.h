@@ -0,0 +1,231 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the OperationStats class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   OperationStats.cpp where the logic of each method is fully defined.
+   OperationStats.h contains the declaration of the OperationStats and
+   StatTimer classes and the macros that instrument the core operations.
+   The recording path is inline in this header so it costs a few
+   instructions at each call site.
+
+   For each instrumented operation this class keeps a call counter, a byte
+   counter and a latency histogram with the buckets of LatencyHistogram, so
+   a reported latency is within 1/16 (6%) of the real one from nanoseconds
+   up to an hour. The buckets are atomic here because any thread may record.
+
+   Reading the clock costs more than a menu lookup, so the cheap in-memory
+   operations time their first 1024 calls and then one call in every 16 or
+   64; every call is counted. The file operations time every call.
+   Percentiles are computed from the timed calls.
+   Counters are updated with relaxed atomic adds: no call is lost when the
+   kitchen threads record at the same time as the main thread, and no
+   ordering is imposed on the surrounding code.
+
+   Compiling with -DRMS_NO_STATS turns the STATS_TIMER and STATS_ADD_BYTES
+   macros into nothing, so the instrumented functions are exactly as they
+   were. The report then says that statistics are disabled.
+
+   Basic operations:
+     - STATS_TIMER(name, op):       Times the rest of the enclosing scope as one call of op.
+     - STATS_ADD_BYTES(name, n):    Adds n bytes to the operation timed by name.
+     - isEnabled:      Checks whether this build records statistics.
+     - getName:        Returns the name of an operation.
+     - getSummary:     Returns the counters and percentiles of an operation.
+     - writeReport:    Writes a table of every operation.
+     - writeJson:      Writes every operation, with its histogram, as JSON.
+     - saveJson:       Writes the JSON to a file.
+     - reset:          Clears every counter.
+
+   Private utility:
+     - percentileNs:   Reads a percentile from a histogram.
+
+   Data members:
+     - counters:       Counters and histogram of each operation.
+
+--------------------------------------------------------------------------*/
+
+#ifndef OPERATIONSTATS_H
+#define OPERATIONSTATS_H
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "LatencyHistogram.h"
+using namespace std;
+
+// The instrumented operations.
+enum StatOp {
+    STAT_ENQUEUE,               // ActiveOrdersQueue::enqueue
+    STAT_DEQUEUE,               // ActiveOrdersQueue::dequeue
+    STAT_DELETE_ORDER,          // ActiveOrdersQueue::deleteOrder
+    STAT_FIND_MENU_ITEM,        // DynamicArrayList::findMenuItem
+    STAT_SEARCH_MENU,           // DynamicArrayList::searchMenu
+    STAT_PRICE_QUERY,           // DynamicArrayList::findItemsByPrice, findCheapestItems, findPriciestItems
+    STAT_LOAD_MENU,             // DynamicArrayList::loadMenuFromFile, bytes read
+    STAT_SAVE_COMPLETED,        // CompletedOrdersStack::saveCompletedOrdersToFile, bytes written
+    STAT_SAVE_LOG_REPORT,       // CompletedOrdersStack::saveLogReportToFile, bytes written
+    STAT_OP_COUNT
+};
+
+// Counters and percentiles reported by OperationStats::getSummary.
+struct StatSummary {
+    long long calls;    // Calls made.
+    long long timed;    // Calls whose latency was measured.
+    long long bytes;    // Bytes read or written.
+    double meanNs;      // Mean latency of the timed calls.
+    long long p50Ns;    // Latency percentiles of the timed calls.
+    long long p90Ns;
+    long long p99Ns;
+    long long p999Ns;
+    long long maxNs;    // Slowest timed call.
+};
+
+class OperationStats {
+public:
+    static const int BUCKET_COUNT = LatencyHistogram::BUCKET_COUNT;  // Latencies up to 2^42 ns (73 minutes).
+    static const long long ALWAYS_TIMED = 1024;  // Calls of each operation timed before sampling.
+
+    static bool isEnabled();
+    /*------------------------------------------------------------------------
+      Purpose:       Checks whether this build records statistics.
+
+      Precondition:  None.
+      Postcondition: Returns false when compiled with RMS_NO_STATS.
+     -----------------------------------------------------------------------*/
+    static const char* getName(StatOp);
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the name of an operation, as used in the reports.
+
+      Precondition:  op is below STAT_OP_COUNT.
+      Postcondition: Returns a lowercase name such as "enqueue".
+     -----------------------------------------------------------------------*/
+    static StatSummary getSummary(StatOp);
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the counters and percentiles of an operation.
+
+      Precondition:  op is below STAT_OP_COUNT.
+      Postcondition: Percentiles are bucket upper bounds, 0 if no call was
+                     timed.
+     -----------------------------------------------------------------------*/
+    static void writeReport(ostream&);
+    /*------------------------------------------------------------------------
+      Purpose:       Writes a table of every operation.
+
+      Precondition:  None.
+      Postcondition: One line per operation with calls, bytes, mean and
+                     percentiles in microseconds.
+     -----------------------------------------------------------------------*/
+    static void writeJson(ostream&);
+    /*------------------------------------------------------------------------
+      Purpose:       Writes every operation as JSON.
+
+      Precondition:  None.
+      Postcondition: One object with the summary of each operation and its
+                     non-empty histogram buckets as [upper bound ns, count]
+                     pairs.
+     -----------------------------------------------------------------------*/
+    static bool saveJson(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Writes the JSON of writeJson to a file.
+
+      Precondition:  None.
+      Postcondition: The file has been replaced. Returns false if it could
+                     not be written.
+     -----------------------------------------------------------------------*/
+    static void reset();
+    /*------------------------------------------------------------------------
+      Purpose:       Clears every counter and histogram.
+
+      Precondition:  No instrumented call is running on another thread.
+      Postcondition: Every operation reports zero calls.
+     -----------------------------------------------------------------------*/
+
+    // Counts a call; returns true if this call should be timed.
+    static bool countCall(StatOp op) {
+        long long calls = counters[op].calls.fetch_add(1, memory_order_relaxed);
+        return calls < ALWAYS_TIMED || (calls & SAMPLE_MASKS[op]) == 0;
+    }
+
+    // Records the latency of a timed call.
+    static void recordLatency(StatOp op, long long ns) {
+        Counters& c = counters[op];
+        bump(c.timed, 1);
+        bump(c.totalNs, ns);
+        bump(c.buckets[LatencyHistogram::bucketOf(ns)], 1);
+        long long currentMax = c.maxNs.load(memory_order_relaxed);
+        while (ns > currentMax && !c.maxNs.compare_exchange_weak(currentMax, ns, memory_order_relaxed)) {
+            // currentMax was reloaded by compare_exchange_weak; try again
+        }
+    }
+
+    // Adds bytes read or written by a call.
+    static void addBytes(StatOp op, long long bytes) {
+        bump(counters[op].bytes, bytes);
+    }
+
+private:
+    // The counters of one operation.
+    struct Counters {
+        atomic<long long> calls;
+        atomic<long long> timed;
+        atomic<long long> totalNs;
+        atomic<long long> maxNs;
+        atomic<long long> bytes;
+        atomic<long long> buckets[BUCKET_COUNT];
+    };
+
+    static const long long SAMPLE_MASKS[STAT_OP_COUNT];  // Time a call when calls & mask == 0.
+    static Counters counters[STAT_OP_COUNT];             // Zeroed before main runs.
+
+    static void bump(atomic<long long>& counter, long long amount) {
+        counter.fetch_add(amount, memory_order_relaxed);
+    }
+
+    static long long percentileNs(const Counters&, long long, double);
+    /*------------------------------------------------------------------------
+      Purpose:       Reads a percentile from a histogram holding `timed` calls.
+
+      Precondition:  fraction is between 0 and 1.
+      Postcondition: Returns the upper bound of the bucket holding that
+                     share of the timed calls, capped at the slowest call.
+     -----------------------------------------------------------------------*/
+};
+
+// Times one call of an operation from construction to destruction.
+class StatTimer {
+public:
+    explicit StatTimer(StatOp op) : op(op), timed(OperationStats::countCall(op)) {
+        if (timed) {
+            start = chrono::steady_clock::now();
+        }
+    }
+
+    ~StatTimer() {
+        if (timed) {
+            OperationStats::recordLatency(op, chrono::duration_cast<chrono::nanoseconds>(
+                chrono::steady_clock::now() - start).count());
+        }
+    }
+
+    void addBytes(long long bytes) {
+        OperationStats::addBytes(op, bytes);
+    }
+
+private:
+    StatTimer(const StatTimer&);             // Not copyable.
+    StatTimer& operator=(const StatTimer&);
+
+    StatOp op;                               // Operation being timed.
+    bool timed;                              // Whether this call is sampled.
+    chrono::steady_clock::time_point start;  // When the call started.
+};
+
+#ifdef RMS_NO_STATS
+#define STATS_TIMER(name, op)
+#define STATS_ADD_BYTES(name, bytes)
+#else
+#define STATS_TIMER(name, op) StatTimer name(op)
+#define STATS_ADD_BYTES(name, bytes) name.addBytes(bytes)
+#endif
+
+#endif /* OPERATIONSTATS_H */
@@ -8,21 +8,54 @@
 
 
 #include "Order.h"
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <ctime>
+
+const int Order::INLINE_LINES;
+const int Order::MIN_BINARY_SIZE;
+
+// Tags that lead a record with fields added after the first format. Older
+// records start with the order ID, which is never negative, so they can be
+// told apart.
+static const int32_t STAMPED_RECORD = -2;      // Lifecycle stamps at the end
+static const int32_t PRIORITY_RECORD = -3;     // Stamps, then the priority
+
+static const char* const PRIORITY_NAMES[PRIORITY_LEVELS] = {"normal", "quick", "vip", "pickup"};
 
 // Default constructor, initializes default values for an Order
 Order::Order() {
+    orderId = 0;                // No ID until the order is queued
     customerName = "unknown";    // Customer name defaulted to "unknown"
     totalPrice = 0.0;           // Total price starts at 0.0
     status = "pending";         // Order status is set to "pending"
     itemCount = 0;              // No items initially
+    lineCount = 0;              // No line items initially
+    priority = PRIORITY_NORMAL; // Scheduled like every other order
+    lines = inlineLines;        // Line items start in the inline buffer
+    lineCapacity = INLINE_LINES;
+    menu = NULL;                // No menu until an item is added
+    placedAt = -1;              // Not placed yet
+    startedAfter = -1;
+    completedAfter = -1;
 }
 
 // Constructor with customer name, initializes an order for a specific customer
 Order::Order(const string& name) {
+    orderId = 0;                // No ID until the order is queued
     customerName = name;        // Assigns the provided customer name
     totalPrice = 0.0;           // Total price starts at 0.0
     status = "pending";         // Order status is set to "pending"
     itemCount = 0;              // No items initially
+    lineCount = 0;              // No line items initially
+    priority = PRIORITY_NORMAL; // Scheduled like every other order
+    lines = inlineLines;        // Line items start in the inline buffer
+    lineCapacity = INLINE_LINES;
+    menu = NULL;                // No menu until an item is added
+    placedAt = -1;              // Not placed yet
+    startedAfter = -1;
+    completedAfter = -1;
 }
 
 // Copy constructor, creates a deep copy of an existing Order
@@ -32,36 +65,63 @@ Order::Order(const Order& other) {
     status = other.status;              // Copies order status
     itemCount = other.itemCount;        // Copies the item count
     orderId = other.orderId;            // Copies the order ID
+    priority = other.priority;          // Copies the priority class
+    menu = other.menu;                  // Shares the same menu
+    placedAt = other.placedAt;          // Copies the lifecycle stamps
+    startedAfter = other.startedAfter;
+    completedAfter = other.completedAfter;
 
-    // Copies items array if there are items
-    if (itemCount > 0) {
-        items = new MenuItem[itemCount];
-        for (int i = 0; i < itemCount; ++i) {
-            items[i] = other.items[i];
-        }
-    } else {
-        items = NULL;  // No items to copy
+    // Copies the line items, on the heap only if they do not fit inline
+    lines = inlineLines;
+    lineCapacity = INLINE_LINES;
+    lineCount = 0;                      // Nothing for reserveLines to keep
+    reserveLines(other.lineCount);
+    for (int i = 0; i < other.lineCount; ++i) {
+        lines[i] = other.lines[i];
     }
+    lineCount = other.lineCount;        // Copies the line count
+}
+
+// Move constructor, takes over the line items of an existing Order
+Order::Order(Order&& other) noexcept
+    : orderId(other.orderId), priority(other.priority), customerName(std::move(other.customerName)), lines(inlineLines),
+      lineCapacity(INLINE_LINES), menu(other.menu), status(std::move(other.status)),
+      placedAt(other.placedAt), startedAfter(other.startedAfter), completedAfter(other.completedAfter) {
+    takeLines(other);
 }
 
-// Adds a menu item to the order by index
-bool Order::addItem(int index, const MenuItem& item, const DynamicArrayList& menuList) {
-    if (index < 0 || index > menuList.getSize()) {  // Validates index
+// Destructor, releases the heap line item array if there is one
+Order::~Order() {
+    releaseLines();
+}
+
+// Adds a menu item to the order by its menu ID
+bool Order::addItem(int id, const DynamicArrayList& menuList) {
+    const MenuItem* item = menuList.findMenuItem(id);  // The menu is the only source of the item
+    if (item == NULL) {
         cout << "Invalid index. Item not added." << endl;
         return false;
     }
+    menu = &menuList;  // Remember the menu for displaying item names
+    appendLine(item->getId(), item->getPrice());
+    return true;
+}
 
-    // Expands the items array to include the new item
-    MenuItem* temp = new MenuItem[itemCount + 1];
-    for (int i = 0; i < itemCount; ++i) {
-        temp[i] = items[i];  // Copies existing items
+// Adds the menu items with the given IDs, reserving room for all of them first
+int Order::addItems(const int ids[], int count, const DynamicArrayList& menuList) {
+    reserveLines(lineCount + count);  // At most one allocation for the whole list
+    int added = 0;
+    for (int i = 0; i < count; ++i) {
+        const MenuItem* item = menuList.findMenuItem(ids[i]);
+        if (item) {
+            appendLine(item->getId(), item->getPrice());
+            added++;
+        }
     }
-    temp[itemCount] = item;  // Adds the new item
-    delete[] items;          // Deletes old array
-    items = temp;            // Updates pointer to new array
-    totalPrice += item.getPrice();  // Adds item's price to total
-    itemCount++;             // Increments item count
-    return true;
+    if (added > 0) {
+        menu = &menuList;  // Remember the menu for displaying item names
+    }
+    return added;
 }
 
 // Returns the total price of the order
@@ -69,6 +129,30 @@ double Order::getTotalPrice() const {
     return totalPrice;
 }
 
+// Returns the total of the order in whole cents
+long long Order::getTotalCents() const {
+    long long cents = 0;
+    for (int i = 0; i < lineCount; ++i) {
+        cents += llround(lines[i].unitPrice * 100) * lines[i].quantity;
+    }
+    return cents;
+}
+
+// Returns the number of items in the order
+int Order::getItemCount() const {
+    return itemCount;
+}
+
+// Returns the number of line items
+int Order::getLineCount() const {
+    return lineCount;
+}
+
+// Returns one line item
+const OrderLine& Order::getLine(int index) const {
+    return lines[index];
+}
+
 // Sets the order ID
 void Order::setOrderId(int orderId) {
     this->orderId = orderId;
@@ -99,40 +183,312 @@ const string& Order::getStatus() const {
     return status;
 }
 
+// Sets the priority class of the order
+void Order::setPriority(OrderPriority priority) {
+    this->priority = priority;
+}
+
+// Gets the priority class of the order
+OrderPriority Order::getPriority() const {
+    return static_cast<OrderPriority>(priority);
+}
+
+// Returns the name of a priority class
+const char* Order::getPriorityName(OrderPriority priority) {
+    return PRIORITY_NAMES[priority];
+}
+
+// Reads a priority class from its name or its number
+bool Order::parsePriority(const string& text, OrderPriority& priority) {
+    for (int p = 0; p < PRIORITY_LEVELS; ++p) {
+        if (text == PRIORITY_NAMES[p] || (text.size() == 1 && text[0] == '0' + p)) {
+            priority = static_cast<OrderPriority>(p);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Clamps the time from placed to `at` to the range of the 32-bit offsets
+static int offsetFrom(long long placedAt, long long at) {
+    long long offset = at - placedAt;
+    if (offset < 0) {
+        return 0;  // Stamped before it was placed, e.g. a restored clock
+    }
+    return offset > INT_MAX ? INT_MAX : static_cast<int>(offset);
+}
+
+// Records when the order was placed and clears the later stamps
+void Order::markPlaced(long long at) {
+    placedAt = at;
+    startedAfter = -1;
+    completedAfter = -1;
+}
+
+// Records when the kitchen started the order, once
+void Order::markStarted(long long at) {
+    if (placedAt >= 0 && startedAfter < 0) {
+        startedAfter = offsetFrom(placedAt, at);
+    }
+}
+
+// Records when the order was completed, once
+void Order::markCompleted(long long at) {
+    if (placedAt >= 0 && completedAfter < 0) {
+        completedAfter = offsetFrom(placedAt, at);
+    }
+}
+
+// Returns when the order was placed, or -1
+long long Order::getPlacedAt() const {
+    return placedAt;
+}
+
+// Returns when the kitchen started the order, or -1
+long long Order::getStartedAt() const {
+    return startedAfter < 0 ? -1 : placedAt + startedAfter;
+}
+
+// Returns when the order was completed, or -1
+long long Order::getCompletedAt() const {
+    return completedAfter < 0 ? -1 : placedAt + completedAfter;
+}
+
+// Returns wall-clock milliseconds that never go backwards within a run
+long long Order::currentTimeMillis() {
+    static const long long wallStart = chrono::duration_cast<chrono::milliseconds>(
+        chrono::system_clock::now().time_since_epoch()).count();
+    static const chrono::steady_clock::time_point steadyStart = chrono::steady_clock::now();
+    return wallStart + chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now() - steadyStart).count();
+}
+
 // Assignment operator overload, performs a deep copy
 Order& Order::operator=(const Order& other) {
     if (this == &other)  // Self-assignment check
         return *this;
 
-    delete[] items;  // Deletes current items
-
     customerName = other.customerName;  // Copies customer name
     totalPrice = other.totalPrice;      // Copies total price
     status = other.status;              // Copies order status
     itemCount = other.itemCount;        // Copies item count
     orderId = other.orderId;            // Copies order ID
+    priority = other.priority;          // Copies the priority class
+    menu = other.menu;                  // Shares the same menu
+    placedAt = other.placedAt;          // Copies the lifecycle stamps
+    startedAfter = other.startedAfter;
+    completedAfter = other.completedAfter;
 
-    // Copies items array if there are items
-    if (itemCount > 0) {
-        items = new MenuItem[itemCount];
-        for (int i = 0; i < itemCount; ++i) {
-            items[i] = other.items[i];
-        }
-    } else {
-        items = NULL;  // No items to copy
+    // Copies the line items, reusing the current array if it is large enough
+    lineCount = 0;                      // Nothing to keep if it has to grow
+    reserveLines(other.lineCount);
+    for (int i = 0; i < other.lineCount; ++i) {
+        lines[i] = other.lines[i];
     }
+    lineCount = other.lineCount;        // Copies line count
 
     return *this;
 }
 
-// Displays the order details
+// Move assignment operator, takes over the line items of another Order
+Order& Order::operator=(Order&& other) noexcept {
+    if (this == &other)  // Self-assignment check
+        return *this;
+
+    releaseLines();  // Frees the current heap line items, if any
+
+    customerName = std::move(other.customerName);
+    status = std::move(other.status);
+    orderId = other.orderId;
+    priority = other.priority;
+    menu = other.menu;
+    placedAt = other.placedAt;
+    startedAfter = other.startedAfter;
+    completedAfter = other.completedAfter;
+    takeLines(other);
+    return *this;
+}
+
+// Displays the order details, resolving item names from the menu
 void Order::displayOrder(ostream& out) const {
     out << "Order ID: " << orderId << ", Customer: " << customerName << endl;
     out << "Items:" << endl;
-    for (int i = 0; i < itemCount; ++i) {
-        out << "- " << items[i].getName() << " ($" << items[i].getPrice() << ")" << endl;
+    for (int i = 0; i < lineCount; ++i) {
+        const MenuItem* item = menu ? menu->findMenuItem(lines[i].menuItemId) : NULL;
+        out << "- ";
+        if (item) {
+            out << item->getName();
+        } else {
+            out << "Item #" << lines[i].menuItemId;  // No longer on the menu
+        }
+        if (lines[i].quantity > 1) {
+            out << " x" << lines[i].quantity;
+        }
+        out << " ($" << lines[i].unitPrice << ")" << endl;
     }
     out << "Status: " << status << endl;
+    if (priority != PRIORITY_NORMAL) {
+        out << "Priority: " << PRIORITY_NAMES[priority] << endl;
+    }
+    if (placedAt >= 0) {
+        time_t placed = static_cast<time_t>(placedAt / 1000);
+        char clock[9];
+        strftime(clock, sizeof(clock), "%H:%M:%S", localtime(&placed));
+        out << "Placed: " << clock;
+        if (startedAfter >= 0) {
+            out << ", started after " << startedAfter / 1000 << " s";
+        }
+        if (completedAfter >= 0) {
+            out << ", completed after " << completedAfter / 1000 << " s";
+        }
+        out << endl;
+    }
+}
+
+// Appends the order to a buffer in the binary log format
+void Order::writeBinary(string& out) const {
+    // Size the buffer once, then fill it in place
+    size_t bytes = 4 + 4 + (4 + customerName.size()) + (4 + status.size()) + 8 + 4 + lineCount * 16 + 16 + 4;
+    size_t start = out.size();
+    out.resize(start + bytes);
+    char* at = &out[start];
+    at = storeInt32(at, PRIORITY_RECORD);
+    at = storeInt32(at, orderId);
+    at = storeString(at, customerName);
+    at = storeString(at, status);
+    at = storeDouble(at, totalPrice);
+    at = storeInt32(at, lineCount);
+    for (int i = 0; i < lineCount; ++i) {
+        at = storeInt32(at, lines[i].menuItemId);
+        at = storeInt32(at, lines[i].quantity);
+        at = storeDouble(at, lines[i].unitPrice);
+    }
+    at = storeInt64(at, placedAt);
+    at = storeInt32(at, startedAfter);
+    at = storeInt32(at, completedAfter);
+    storeInt32(at, priority);
+}
+
+// Restores an order from the binary log format
+bool Order::readBinary(BinaryReader& in, const DynamicArrayList* menuList) {
+    int32_t id, count;
+    string name, state;
+    double total;
+    if (!in.readInt32(id)) {
+        return false;
+    }
+    bool prioritized = id == PRIORITY_RECORD;
+    bool stamped = prioritized || id == STAMPED_RECORD;  // Untagged records predate the stamps
+    if ((stamped && !in.readInt32(id)) || !in.readString(name) || !in.readString(state)
+        || !in.readDouble(total) || !in.readInt32(count) || count < 0
+        || in.remaining() < static_cast<size_t>(count) * 16 + (stamped ? 16 : 0) + (prioritized ? 4 : 0)) {
+        return false;  // Incomplete record
+    }
+
+    lineCount = 0;  // Replace the current contents
+    reserveLines(count);
+    int items = 0;
+    for (int i = 0; i < count; ++i) {
+        int32_t itemId = 0, quantity = 0;
+        in.readInt32(itemId);  // Cannot fail, the length was checked above
+        in.readInt32(quantity);
+        in.readDouble(lines[i].unitPrice);
+        lines[i].menuItemId = itemId;
+        lines[i].quantity = quantity;
+        items += quantity;
+    }
+    lineCount = count;
+    itemCount = items;
+    placedAt = -1;
+    startedAfter = -1;
+    completedAfter = -1;
+    if (stamped) {
+        int64_t placed = 0;
+        int32_t started = 0, completed = 0;
+        in.readInt64(placed);  // Cannot fail, the length was checked above
+        in.readInt32(started);
+        in.readInt32(completed);
+        placedAt = placed;
+        startedAfter = started;
+        completedAfter = completed;
+    }
+    priority = PRIORITY_NORMAL;
+    if (prioritized) {
+        int32_t level = 0;
+        in.readInt32(level);
+        priority = level >= 0 && level < PRIORITY_LEVELS ? level : PRIORITY_NORMAL;
+    }
+    orderId = id;
+    customerName.swap(name);
+    status.swap(state);
+    totalPrice = total;
+    menu = menuList;
+    return true;
+}
+
+// Adds one unit of an item, merging it into the last line when it repeats
+void Order::appendLine(int menuItemId, double unitPrice) {
+    // The same item ordered again at the same price only bumps the quantity
+    if (lineCount > 0 && lines[lineCount - 1].menuItemId == menuItemId
+        && lines[lineCount - 1].unitPrice == unitPrice) {
+        lines[lineCount - 1].quantity++;
+    } else {
+        reserveLines(lineCount + 1);  // Doubles the array when it is full
+        lines[lineCount].menuItemId = menuItemId;
+        lines[lineCount].quantity = 1;
+        lines[lineCount].unitPrice = unitPrice;
+        lineCount++;
+    }
+    totalPrice += unitPrice;  // Adds item's price to total
+    itemCount++;              // Increments item count
+}
+
+// Grows the line array to hold at least `needed` lines, at least doubling it
+void Order::reserveLines(int needed) {
+    if (needed <= lineCapacity) {
+        return;
+    }
+    int capacity = lineCapacity * 2;
+    if (capacity < needed) {
+        capacity = needed;
+    }
+    OrderLine* grown = new OrderLine[capacity];
+    for (int i = 0; i < lineCount; ++i) {
+        grown[i] = lines[i];  // Keeps the existing lines
+    }
+    releaseLines();
+    lines = grown;
+    lineCapacity = capacity;
+}
+
+// Frees a heap line array and goes back to the inline buffer
+void Order::releaseLines() {
+    if (lines != inlineLines) {
+        delete[] lines;
+    }
+    lines = inlineLines;
+    lineCapacity = INLINE_LINES;
+}
+
+// Takes the line items of an order being moved; inline lines have to be copied
+void Order::takeLines(Order& other) {
+    if (other.lines == other.inlineLines) {
+        for (int i = 0; i < other.lineCount; ++i) {
+            inlineLines[i] = other.inlineLines[i];
+        }
+    } else {
+        lines = other.lines;  // Takes ownership of the heap array
+        lineCapacity = other.lineCapacity;
+        other.lines = other.inlineLines;
+        other.lineCapacity = INLINE_LINES;
+    }
+    lineCount = other.lineCount;
+    itemCount = other.itemCount;
+    totalPrice = other.totalPrice;
+
+    other.lineCount = 0;  // The moved-from order no longer has the lines
+    other.itemCount = 0;
+    other.totalPrice = 0.0;
 }
 
 // Overloads the output stream operator to display order details
@@ -7,49 +7,124 @@
    for managing the details of the order, including the order's ID, customer name,
    the items included, total price, and order status.
 
+   An order does not copy the menu items it contains. Each entry is a compact
+   OrderLine holding the menu item ID, the quantity and the unit price captured
+   when the item was ordered. Item names are looked up in the menu only when the
+   order is printed.
+
+   The first INLINE_LINES line items are stored inside the Order itself, so a
+   typical ticket needs no heap allocation. Larger orders move the lines to a
+   heap array that doubles in capacity whenever it fills, so adding n items
+   costs O(log n) allocations instead of one per item.
+
+   An order records when it was placed, when the kitchen started it and when
+   it was completed. The placed time is milliseconds since the epoch from
+   currentTimeMillis, which never goes backwards while the program runs; the
+   other two are kept as millisecond offsets from it in 32-bit fields, so the
+   three stamps add 16 bytes to an order. Unset stamps read as -1.
+
+   Each order has a priority class (normal, quick, VIP, pickup) that the
+   active queue can schedule by. It is kept in what was padding, so it does
+   not make an order larger.
+
    Basic operations:
      - Constructor: Constructs an Order object, either empty or with a specified customer name.
      - Copy constructor: Creates a new Order object by copying the data from an existing Order.
-     - addItem: Adds a MenuItem to the order at a specific index and updates the total price.
+     - Move constructor: Creates a new Order object by taking over the data of an existing Order.
+     - Destructor: Releases the heap line item array, if any.
+     - addItem: Adds a MenuItem to the order and updates the total price.
+     - addItems: Adds several menu items, given by ID, in one call.
      - getTotalPrice: Calculates and returns the total price of the items in the order.
+     - getItemCount: Returns the number of items in the order.
+     - getLineCount / getLine: Read the line items of the order.
+     - getTotalCents: Returns the exact total of the order in whole cents.
      - setOrderId: Sets the order ID for the order.
      - getOrderId: Returns the order ID of the order.
      - setCustomerName: Sets the customer's name associated with the order.
      - getCustomerName: Returns the customer's name.
      - setStatus: Sets the status of the order (e.g., "Pending", "Completed").
      - getStatus: Returns the status of the order.
+     - setPriority: Sets the priority class of the order.
+     - getPriority: Returns the priority class of the order.
+     - getPriorityName: Returns the name of a priority class (static).
+     - parsePriority: Reads a priority class from its name or number (static).
+     - markPlaced: Records when the order was placed.
+     - markStarted: Records when the kitchen started the order.
+     - markCompleted: Records when the order was completed.
+     - getPlacedAt: Returns when the order was placed.
+     - getStartedAt: Returns when the kitchen started the order.
+     - getCompletedAt: Returns when the order was completed.
+     - currentTimeMillis: Returns the clock used for the stamps.
      - displayOrder: Outputs the order details in a readable format to an output stream.
+     - writeBinary: Appends the order to a byte buffer in the binary log format.
+     - readBinary: Restores an order written by writeBinary.
      - Assignment operator: Assigns the data from one Order object to another.
+     - Move assignment operator: Moves the data from one Order object into another.
+
+   Private utility:
+     - appendLine: Adds one unit of an item to the line items and the totals.
+     - reserveLines: Makes room for a number of line items, growing geometrically.
+     - releaseLines: Frees a heap line array and returns to the inline buffer.
+     - takeLines: Takes over the line items of an order that is being moved.
 
    Data members:
      - orderId: The unique identifier for the order.
-     - itemCount: The number of items included in the order.
+     - itemCount: The number of items included in the order (sum of quantities).
+     - lineCount: The number of line items in the order.
+     - priority: The priority class of the order.
      - customerName: The name of the customer who placed the order.
-     - items: A pointer to an array of MenuItem objects that make up the order.
+     - lines: Points to the line items, either inlineLines or a heap array.
+     - lineCapacity: How many line items fit in the array lines points to.
+     - inlineLines: Storage for the first INLINE_LINES line items.
+     - menu: The menu used to resolve item names when the order is displayed.
      - totalPrice: The total price of the order, calculated by summing the prices of all items.
      - status: The current status of the order (e.g., "Pending", "Completed").
+     - placedAt: When the order was placed, in ms since the epoch, or -1.
+     - startedAfter: Milliseconds from placed to started, or -1.
+     - completedAfter: Milliseconds from placed to completed, or -1.
 
    Overloaded operators:
-     - ostream& operator<<: Overloads the `<<` operator for printing MenuItem details to an output stream.
+     - ostream& operator<<: Overloads the `<<` operator for printing Order details to an output stream.
 
 -------------------------------------------------------------------------- */
 
 #ifndef ORDER_H
 #define ORDER_H
 #include <iostream>
+#include "BinaryIO.h"
 #include "DynamicArrayList.h"
 using namespace std;
 
+// A single line of an order: which menu item, how many, and at what price.
+struct OrderLine {
+    int menuItemId;     // The ID of the ordered menu item.
+    int quantity;       // How many units of the item were ordered.
+    double unitPrice;   // The price of one unit at the time the order was placed.
+};
+
+// Priority classes of an order, lowest first.
+enum OrderPriority {
+    PRIORITY_NORMAL,    // Dine-in and takeaway orders.
+    PRIORITY_QUICK,     // Orders the kitchen can turn around at once.
+    PRIORITY_VIP,       // VIP tables.
+    PRIORITY_PICKUP,    // Delivery drivers waiting at the pass.
+    PRIORITY_LEVELS
+};
+
 class Order {
 public:
+    static const int INLINE_LINES = 8; // Line items stored without a heap allocation.
+    static const int MIN_BINARY_SIZE = 24; // Bytes of the smallest record readBinary accepts.
+
     Order();
     /*------------------------------------------------------------------------
           Purpose:       Constructs an empty Order object.
 
           Precondition:  None.
           Postcondition: An empty Order object is created with default values for
-                          customerName (unknow), itemCount (0), totalPrice (0.0), and status
-                         ("pending").
+                         customerName ("unknown"), itemCount (0), totalPrice (0.0), and status
+                         ("pending"). `lines` points to the inline buffer of
+                         INLINE_LINES line items; nothing is allocated.
         ------------------------------------------------------------------------*/
         
     Order(const string&);
@@ -59,7 +134,8 @@ public:
         Precondition:  A valid customer name string is provided.
         Postcondition: An Order object is created with the provided customer name,
                        itemCount (0), totalPrice (0.0), and status ("pending").
-                       The `items` pointer is initialized to `nullptr`.
+                       `lines` points to the inline buffer of INLINE_LINES
+                       line items; the heap is used only once more are added.
       ------------------------------------------------------------------------*/
     Order(const Order&);
     /*------------------------------------------------------------------------
@@ -69,17 +145,51 @@ public:
           Precondition:  An existing Order object is provided.
           Postcondition: A new Order object is created with the same data as the
                          provided Order (orderId, itemCount, customerName, status,
-                         items, and totalPrice).
+                         line items, and totalPrice). The lines are copied into
+                         the inline buffer when they fit there.
         ------------------------------------------------------------------------*/
     
-    bool addItem(int index, const MenuItem&, const DynamicArrayList&);
+    Order(Order&&) noexcept;
     /*------------------------------------------------------------------------
-         Purpose:       Adds a MenuItem to the Order with a specified MenuItem index.
+          Purpose:       Move constructor that creates a new Order object by taking
+                         over the data of an existing Order object.
+
+          Precondition:  An existing Order object is provided.
+          Postcondition: The new Order owns the line items of `other`, which is
+                         left as an empty order with no line items.
+        ------------------------------------------------------------------------*/
 
-         Precondition:  A valid MenuItem object and DynamicArrayList object are provided.
-                        The `index` must be within the valid range of the item list.
-         Postcondition: The MenuItem is added to the Order's item list created at the specified
-                        index, and the total price of the order is updated.
+    ~Order();
+    /*------------------------------------------------------------------------
+          Purpose:       Destructor: Releases the memory used by the line items.
+
+          Precondition:  None.
+          Postcondition: A heap line item array, if the order had one, has been
+                         deallocated.
+        ------------------------------------------------------------------------*/
+
+    bool addItem(int id, const DynamicArrayList&);
+    /*------------------------------------------------------------------------
+         Purpose:       Adds the MenuItem with a specified ID to the Order.
+
+         Precondition:  A valid DynamicArrayList object is provided.
+         Postcondition: The item is looked up in the menu list by its ID. A line
+                        item referring to it is added to the Order (or the quantity
+                        of the previous line is increased when the same item is
+                        added again), the menu is remembered for displaying names,
+                        and the total price of the order is updated.
+                        Returns false if the ID is not in the menu.
+       ------------------------------------------------------------------------*/
+
+    int addItems(const int[], int, const DynamicArrayList&);
+    /*------------------------------------------------------------------------
+         Purpose:       Adds several menu items, given by their IDs, to the Order.
+
+         Precondition:  `ids` holds `count` menu item IDs.
+         Postcondition: Every ID found in the menu has been added as by addItem,
+                        in order, with room for all of them reserved up front.
+                        IDs not in the menu are skipped. Returns the number of
+                        items added.
        ------------------------------------------------------------------------*/
     
     double getTotalPrice() const;
@@ -91,6 +201,40 @@ public:
                         of all MenuItems added.
        ------------------------------------------------------------------------*/
     
+    long long getTotalCents() const;
+    /*------------------------------------------------------------------------
+         Purpose:       Returns the total price of the order in cents.
+
+         Precondition:  None.
+         Postcondition: Returns the sum over all line items of the unit price,
+                        rounded to the nearest cent, times the quantity. The
+                        result is exact, unlike sums of double prices.
+       ------------------------------------------------------------------------*/
+
+    int getItemCount() const;
+    /*------------------------------------------------------------------------
+         Purpose:       Returns the number of items in the order.
+
+         Precondition:  None.
+         Postcondition: Returns the sum of the quantities of all line items.
+       ------------------------------------------------------------------------*/
+    int getLineCount() const;
+    /*------------------------------------------------------------------------
+         Purpose:       Returns the number of line items in the order.
+
+         Precondition:  None.
+         Postcondition: Returns how many distinct lines the order holds.
+       ------------------------------------------------------------------------*/
+    const OrderLine& getLine(int) const;
+    /*------------------------------------------------------------------------
+         Purpose:       Returns one line item of the order.
+
+         Precondition:  0 <= index < getLineCount().
+         Postcondition: Returns the line at that index, in the order the
+                        items were added. The reference is valid until the
+                        order is changed.
+       ------------------------------------------------------------------------*/
+
     void setOrderId(int);
     /*------------------------------------------------------------------------
          Purpose:       Sets the order ID to a specified value.
@@ -138,6 +282,86 @@ public:
           Postcondition: Returns the status string associated with the Order.
         ------------------------------------------------------------------------*/
 
+    void setPriority(OrderPriority);
+    /*------------------------------------------------------------------------
+          Purpose:       Sets the priority class of the order.
+
+          Precondition:  The priority is below PRIORITY_LEVELS.
+          Postcondition: The priority is set. An order that is already queued
+                         keeps its place; set the priority before enqueueing.
+        ------------------------------------------------------------------------*/
+    OrderPriority getPriority() const;
+    /*------------------------------------------------------------------------
+          Purpose:       Returns the priority class of the order.
+
+          Precondition:  None.
+          Postcondition: Returns PRIORITY_NORMAL unless it was set.
+        ------------------------------------------------------------------------*/
+    static const char* getPriorityName(OrderPriority);
+    /*------------------------------------------------------------------------
+          Purpose:       Returns the name of a priority class.
+
+          Precondition:  The priority is below PRIORITY_LEVELS.
+          Postcondition: Returns "normal", "quick", "vip" or "pickup".
+        ------------------------------------------------------------------------*/
+    static bool parsePriority(const string&, OrderPriority&);
+    /*------------------------------------------------------------------------
+          Purpose:       Reads a priority class from its name or number.
+
+          Precondition:  None.
+          Postcondition: Accepts the names of getPriorityName and the numbers
+                         0 to PRIORITY_LEVELS - 1. Returns false, leaving the
+                         priority unchanged, for anything else.
+        ------------------------------------------------------------------------*/
+
+    void markPlaced(long long = currentTimeMillis());
+    /*------------------------------------------------------------------------
+          Purpose:       Records when the order was placed.
+
+          Precondition:  The time is in milliseconds since the epoch; it
+                         defaults to now.
+          Postcondition: placedAt is set and the started and completed stamps
+                         are cleared.
+        ------------------------------------------------------------------------*/
+    void markStarted(long long = currentTimeMillis());
+    /*------------------------------------------------------------------------
+          Purpose:       Records when the kitchen started the order.
+
+          Precondition:  The time defaults to now.
+          Postcondition: The started stamp is set if the order was placed and
+                         not started yet; otherwise nothing changes. A time
+                         before the placed time counts as the placed time.
+        ------------------------------------------------------------------------*/
+    void markCompleted(long long = currentTimeMillis());
+    /*------------------------------------------------------------------------
+          Purpose:       Records when the order was completed.
+
+          Precondition:  The time defaults to now.
+          Postcondition: The completed stamp is set if the order was placed and
+                         not completed yet; otherwise nothing changes.
+        ------------------------------------------------------------------------*/
+    long long getPlacedAt() const;
+    long long getStartedAt() const;
+    long long getCompletedAt() const;
+    /*------------------------------------------------------------------------
+          Purpose:       Return when the order was placed, started and
+                         completed.
+
+          Precondition:  None.
+          Postcondition: Returns milliseconds since the epoch, or -1 if that
+                         stamp is not set.
+        ------------------------------------------------------------------------*/
+    static long long currentTimeMillis();
+    /*------------------------------------------------------------------------
+          Purpose:       Returns the current time for the lifecycle stamps.
+
+          Precondition:  None.
+          Postcondition: Returns milliseconds since the epoch. The wall clock is
+                         read once; later calls add the steady clock's elapsed
+                         time, so the result never goes backwards while the
+                         program runs.
+        ------------------------------------------------------------------------*/
+
     void displayOrder(ostream&) const;
     /*------------------------------------------------------------------------
          Purpose:       Displays the details of the Order object in a readable format.
@@ -145,6 +369,36 @@ public:
          Precondition:  A valid output stream object (`ostream`) is provided.
          Postcondition: The details of the Order (ID, customer name, status, and items)
                         are output to the provided stream in a readable format.
+                        Item names are resolved from the menu; an item that is no
+                        longer on the menu is shown by its ID. The priority
+                        is shown unless it is normal. A placed order
+                        also shows its placed time of day and how many
+                        seconds later it was started and completed.
+       ------------------------------------------------------------------------*/
+
+    void writeBinary(string&) const;
+    /*------------------------------------------------------------------------
+         Purpose:       Serializes the order for the binary append-only logs.
+
+         Precondition:  None.
+         Postcondition: A record tag, the order ID, customer name, status,
+                        total price, every line item, the lifecycle stamps
+                        and the priority are appended to the buffer. Item names are not
+                        written; they come from the menu when read.
+       ------------------------------------------------------------------------*/
+
+    bool readBinary(BinaryReader&, const DynamicArrayList*);
+    /*------------------------------------------------------------------------
+         Purpose:       Restores an order written by writeBinary.
+
+         Precondition:  The reader is positioned at the start of an order.
+                        `menu` is used to display item names and may be NULL.
+         Postcondition: The order holds the decoded data and the reader is
+                        positioned after it. Records written before the
+                        stamps existed have no tag and load unstamped;
+                        records written before the priority load as normal.
+                        Returns false, leaving the order unchanged, if the
+                        data is incomplete.
        ------------------------------------------------------------------------*/
 
     Order& operator=(const Order&);
@@ -157,16 +411,70 @@ public:
                         status, items, and totalPrice).
        ------------------------------------------------------------------------*/
 
+    Order& operator=(Order&&) noexcept;
+    /*------------------------------------------------------------------------
+         Purpose:       Move assignment operator that moves the data of one Order
+                        object into another without copying the line items.
+
+         Precondition:  A valid Order object is provided.
+         Postcondition: The current Order owns the data of `other`, which is left
+                        as an empty order with no line items.
+       ------------------------------------------------------------------------*/
+
 private:
+    void appendLine(int, double);
+    /*------------------------------------------------------------------------
+         Purpose:       Adds one unit of a menu item at a given price.
+
+         Precondition:  The ID is on the menu.
+         Postcondition: The quantity of the last line has been increased if it
+                        is the same item at the same price; otherwise a new line
+                        has been appended. Totals have been updated.
+       ------------------------------------------------------------------------*/
+    void reserveLines(int);
+    /*------------------------------------------------------------------------
+         Purpose:       Makes sure a number of line items fit without reallocating.
+
+         Precondition:  None.
+         Postcondition: lineCapacity is at least the requested count. When the
+                        array had to grow, its capacity was at least doubled and
+                        the existing line items were kept.
+       ------------------------------------------------------------------------*/
+    void releaseLines();
+    /*------------------------------------------------------------------------
+         Purpose:       Frees the heap line array, if any.
+
+         Precondition:  None.
+         Postcondition: lines points to inlineLines. The line items themselves
+                        are not preserved.
+       ------------------------------------------------------------------------*/
+    void takeLines(Order&);
+    /*------------------------------------------------------------------------
+         Purpose:       Takes over the line items of another order.
+
+         Precondition:  This order has no heap line array.
+         Postcondition: This order holds the line items of `other`: a heap
+                        array is taken over, inline lines are copied. `other`
+                        is left with no line items.
+       ------------------------------------------------------------------------*/
+
     int orderId;        // The unique identifier for the order.
     int itemCount;      // The total number of items in the order.
+    int lineCount;      // The number of line items in the order.
+    int priority;       // The OrderPriority of the order; fills the padding before customerName.
     string customerName; // The name of the customer who placed the order.
-    MenuItem *items;    // Pointer to an array of MenuItem objects in the order.
+    OrderLine *lines;   // Points to inlineLines or to a heap array of line items.
+    int lineCapacity;   // Number of line items that fit in the array lines points to.
+    OrderLine inlineLines[INLINE_LINES]; // The first line items, stored in place.
+    const DynamicArrayList *menu; // Menu used to look up item names when displaying.
     double totalPrice;  // The total price of the order, calculated from items' prices.
     string status;      // The current status of the order (e.g., "Pending", "Completed").
+    long long placedAt; // When the order was placed, in ms since the epoch, or -1.
+    int startedAfter;   // Milliseconds from placed to started, or -1.
+    int completedAfter; // Milliseconds from placed to completed, or -1.
 };
-// Overloaded output operator to display MenuItem details.
-ostream& operator<<(ostream&, const MenuItem &);
+// Overloaded output operator to display Order details.
+ostream& operator<<(ostream&, const Order &);
 
 
 #endif /* ORDER_H */
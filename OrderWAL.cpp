@@ -0,0 +1,149 @@
+// This is the implementation file for the OrderWAL class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, OrderWAL.h, provides the class structure and function declarations.
+
+//
+//  OrderWAL.cpp
+//
+
+#include "OrderWAL.h"
+#include <cstdio>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "BinaryIO.h"
+
+static const char RECORD_ENQUEUE = 'E';  // Order added to the queue
+static const char RECORD_CANCEL = 'C';   // Order deleted from the queue
+static const char RECORD_PROCESS = 'P';  // Order moved to the completed stack
+
+// Constructor, a group size of one commits every record on its own
+OrderWAL::OrderWAL(const string& fileName, FsyncPolicy policy, int flushIntervalMillis, int groupSize)
+    : fileName(fileName), log(groupSize, policy, policy == FSYNC_INTERVAL ? flushIntervalMillis : 0) {
+    replayedCount = 0;
+}
+
+// Replays every record of the log, then opens it for new records
+bool OrderWAL::recover(ActiveOrdersQueue& activeOrders, CompletedOrdersStack& completedOrders,
+                       const DynamicArrayList* menu, const unordered_set<int>* loggedIds) {
+    replayedCount = 0;
+    vector<string> records;
+    AppendOnlyLog::readRecords(fileName, records);  // A missing file has no records
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (replay(records[i], activeOrders, completedOrders, menu, loggedIds)) {
+            replayedCount++;
+        }
+    }
+    return log.open(fileName);  // Also drops a torn last record
+}
+
+// Syncs and closes the log
+void OrderWAL::close() {
+    log.close();
+}
+
+// Checks whether the log is open
+bool OrderWAL::isOpen() const {
+    return log.isOpen();
+}
+
+// Logs an order added to the queue
+bool OrderWAL::recordEnqueue(const Order& order) {
+    string record(1, RECORD_ENQUEUE);
+    order.writeBinary(record);
+    return log.append(record);
+}
+
+// Logs an order deleted from the queue
+bool OrderWAL::recordCancel(int orderId) {
+    return recordId(RECORD_CANCEL, orderId);
+}
+
+// Logs an order moved to the completed stack
+bool OrderWAL::recordProcess(const Order& order) {
+    string record(1, RECORD_PROCESS);
+    appendInt32(record, order.getOrderId());
+    appendInt64(record, order.getStartedAt());
+    appendInt64(record, order.getCompletedAt());
+    return log.append(record);
+}
+
+// Commits the current group and forces the log to disk
+bool OrderWAL::sync() {
+    return log.sync();
+}
+
+// Empties the log; its changes are already in a snapshot on disk
+bool OrderWAL::checkpoint() {
+    log.close();
+    if (remove(fileName.c_str()) != 0) {
+        cerr << "Failed to empty order log: " << fileName << endl;
+    }
+    return log.open(fileName);
+}
+
+// Returns the counters of the underlying log
+LogStats OrderWAL::getStats() const {
+    return log.getStats();
+}
+
+// Returns how many records the last recover applied
+int OrderWAL::getReplayedCount() const {
+    return replayedCount;
+}
+
+// Logs a type byte followed by an order ID
+bool OrderWAL::recordId(char type, int orderId) {
+    string record(1, type);
+    appendInt32(record, orderId);
+    return log.append(record);
+}
+
+// Applies one record; records the restored state already reflects are skipped
+bool OrderWAL::replay(const string& record, ActiveOrdersQueue& activeOrders,
+                      CompletedOrdersStack& completedOrders, const DynamicArrayList* menu,
+                      const unordered_set<int>* loggedIds) {
+    if (record.empty()) {
+        return false;
+    }
+    BinaryReader reader(record.data() + 1, record.size() - 1);
+    if (record[0] == RECORD_ENQUEUE) {
+        Order order;
+        if (!order.readBinary(reader, menu) || order.getOrderId() < activeOrders.getNextOrderId()) {
+            return false;  // Damaged, or already in the snapshot
+        }
+        activeOrders.restoreOrder(std::move(order));
+        return true;
+    }
+
+    int32_t orderId = 0;
+    if (!reader.readInt32(orderId)) {
+        return false;
+    }
+    if (record[0] == RECORD_CANCEL) {
+        return activeOrders.deleteOrder(orderId);
+    }
+    if (record[0] == RECORD_PROCESS) {
+        Order* found = activeOrders.findOrder(orderId);
+        if (found == NULL) {
+            return false;  // Processed before the snapshot
+        }
+        Order processed = std::move(*found);  // The node is deleted next
+        activeOrders.deleteOrder(orderId);
+        processed.setStatus("completed");
+        int64_t startedAt = 0, completedAt = 0;
+        if (reader.readInt64(startedAt) && reader.readInt64(completedAt)) {
+            if (startedAt >= 0) {
+                processed.markStarted(startedAt);  // The times of the original run
+            }
+            if (completedAt >= 0) {
+                processed.markCompleted(completedAt);
+            }
+        }
+        // Never stamped with the restart time; the order log may have it from before the crash
+        bool logged = loggedIds != NULL && loggedIds->count(orderId) > 0;
+        completedOrders.restoreOrder(std::move(processed), logged);
+        return true;
+    }
+    return false;  // Unknown record type
+}
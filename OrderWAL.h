@@ -0,0 +1,199 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the OrderWAL class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   OrderWAL.cpp where the logic of each method is fully defined.
+   OrderWAL.h contains the declaration of the OrderWAL class.
+   This class is a write-ahead log for the active orders. Every change to the
+   queue - a new order, a cancelled order, an order processed into the
+   completed stack - is written to an AppendOnlyLog before it is reported to
+   the user, so a crash never loses an order that was acknowledged.
+
+   Records (one per log record, first byte is the type):
+     - 'E' + the order in Order::writeBinary format: order enqueued.
+     - 'C' + 32-bit order ID: order cancelled.
+     - 'P' + 32-bit order ID + 64-bit started and completed times: order
+       completed and pushed. It is written by the kitchen when the order is
+       really done, not when it leaves the queue, so an order still in the
+       kitchen at a crash is recovered as active and processed again. A time
+       the order was never stamped with (an order restored from an unstamped
+       snapshot) is -1, and replay leaves it unset instead of using the
+       restart time. Logs written before the times were added have the ID
+       only.
+
+   By default every record is committed as its own group, so with
+   FSYNC_EACH_COMMIT it is on disk when the record call returns. A larger
+   group size lets a caller that handles many changes at once (batch mode)
+   pay one write and fsync per group: records wait in memory until the group
+   is full or sync is called, so such a caller must call sync before it
+   acknowledges them. FSYNC_INTERVAL trades the last flush interval of
+   changes for much cheaper records.
+
+   Recovery replays the log on top of whatever the snapshot restored. Replay
+   is idempotent: an enqueue whose ID the queue has already handed out is
+   skipped, and cancel and process only act on orders still in the queue.
+   The completed-order log is attached to the stack before replay, so the
+   orders it missed in the crash are appended to it; orders it already holds
+   are passed in by ID and not appended twice. After a snapshot reaches the
+   disk, checkpoint empties the log.
+
+   Basic operations:
+     - Constructor:   Sets the log file and fsync policy.
+     - recover:       Replays the log into the queue and stack and opens it.
+     - close:         Syncs and closes the log.
+     - isOpen:        Checks whether the log is open.
+     - recordEnqueue: Logs a new active order.
+     - recordCancel:  Logs a cancelled order.
+     - recordProcess: Logs an order moved to the completed stack.
+     - sync:          Forces every record logged so far to disk.
+     - checkpoint:    Empties the log once its changes are in a snapshot.
+     - getStats:      Returns the counters of the underlying log.
+     - getReplayedCount: Number of records applied by the last recover.
+
+   Private utility:
+     - recordId: Logs a record that carries only an order ID.
+     - replay:   Applies one record to the queue and stack.
+
+   Data members:
+     - fileName:      Path of the log file.
+     - log:           The underlying append-only log.
+     - replayedCount: Records applied by the last recover.
+
+--------------------------------------------------------------------------*/
+
+#ifndef ORDERWAL_H
+#define ORDERWAL_H
+
+#include <string>
+#include <unordered_set>
+#include "ActiveOrdersQueue.h"
+#include "AppendOnlyLog.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "Order.h"
+using namespace std;
+
+class OrderWAL {
+public:
+    OrderWAL(const string&, FsyncPolicy = FSYNC_EACH_COMMIT, int = 20, int groupSize = 1);
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a write-ahead log bound to a file.
+
+      Precondition:  The flush interval (milliseconds) is only used by
+                     FSYNC_INTERVAL. groupSize is positive.
+      Postcondition: The log is closed until recover is called. With a
+                     group size above 1, records are durable only once
+                     sync returns or their group has been committed.
+     -----------------------------------------------------------------------*/
+    bool recover(ActiveOrdersQueue&, CompletedOrdersStack&, const DynamicArrayList*,
+                 const unordered_set<int>* loggedIds = NULL);
+    /*------------------------------------------------------------------------
+      Purpose:       Replays the log and opens it for new records.
+
+      Precondition:  The queue and stack hold the state restored from the
+                     last snapshot (or are empty). If the stack has an order
+                     log attached, loggedIds holds the IDs of the orders it
+                     already has (CompletedOrdersStack::readLoggedOrderIds)
+                     or is NULL if it has none.
+      Postcondition: Every valid record has been applied; a torn last record
+                     is dropped. Processed orders are appended to the order
+                     log unless loggedIds holds them, so each is logged once.
+                     Returns false if the log cannot be opened.
+     -----------------------------------------------------------------------*/
+    void close();
+    /*------------------------------------------------------------------------
+      Purpose:       Syncs and closes the log.
+
+      Precondition:  None.
+      Postcondition: Every record is on disk and the log is closed.
+     -----------------------------------------------------------------------*/
+    bool isOpen() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Checks whether the log is open.
+
+      Precondition:  None.
+      Postcondition: Returns true between a successful recover and close.
+     -----------------------------------------------------------------------*/
+    bool recordEnqueue(const Order&);
+    /*------------------------------------------------------------------------
+      Purpose:       Logs an order that was added to the queue.
+
+      Precondition:  The order carries the ID the queue gave it.
+      Postcondition: The record has been written (and synced, per policy).
+                     Returns false if the log is closed or the write failed.
+     -----------------------------------------------------------------------*/
+    bool recordCancel(int);
+    /*------------------------------------------------------------------------
+      Purpose:       Logs an order that was deleted from the queue.
+
+      Precondition:  None.
+      Postcondition: Same as recordEnqueue.
+     -----------------------------------------------------------------------*/
+    bool recordProcess(const Order&);
+    /*------------------------------------------------------------------------
+      Purpose:       Logs an order that was completed and is being pushed.
+
+      Precondition:  The order has been stamped as completed, so replay
+                     restores the same ticket times. Called where the order
+                     is completed (StationRouter, KitchenWorkerPool or a
+                     direct push), from any thread.
+      Postcondition: Same as recordEnqueue. Stamps the order lacks are
+                     logged as -1 and left unset by replay.
+     -----------------------------------------------------------------------*/
+    bool sync();
+    /*------------------------------------------------------------------------
+      Purpose:       Forces every record logged so far to disk.
+
+      Precondition:  The log is open.
+      Postcondition: Every record call made before sync is on disk. Returns
+                     false if the log could not be written or synced.
+     -----------------------------------------------------------------------*/
+    bool checkpoint();
+    /*------------------------------------------------------------------------
+      Purpose:       Empties the log.
+
+      Precondition:  A snapshot holding every logged change is on disk.
+      Postcondition: The log file holds no records and is open again.
+     -----------------------------------------------------------------------*/
+    LogStats getStats() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the counters of the underlying log.
+
+      Precondition:  None.
+      Postcondition: Returns records, commits, fsyncs and bytes since the
+                     log object was created.
+     -----------------------------------------------------------------------*/
+    int getReplayedCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns how many records the last recover applied.
+
+      Precondition:  None.
+      Postcondition: Skipped (already applied) records are not counted.
+     -----------------------------------------------------------------------*/
+
+private:
+    OrderWAL(const OrderWAL&);            // Not copyable.
+    OrderWAL& operator=(const OrderWAL&);
+
+    bool recordId(char, int);
+    /*------------------------------------------------------------------------
+      Purpose:       Logs a record made of a type byte and an order ID.
+
+      Precondition:  None.
+      Postcondition: Same as recordEnqueue.
+     -----------------------------------------------------------------------*/
+    bool replay(const string&, ActiveOrdersQueue&, CompletedOrdersStack&, const DynamicArrayList*,
+                const unordered_set<int>*);
+    /*------------------------------------------------------------------------
+      Purpose:       Applies one record to the queue and stack.
+
+      Precondition:  The record was read from this log. loggedIds is as
+                     for recover.
+      Postcondition: Returns true if the record changed the state.
+     -----------------------------------------------------------------------*/
+
+    string fileName;     // Path of the log file.
+    AppendOnlyLog log;   // Records are committed one at a time.
+    int replayedCount;   // Records applied by the last recover.
+};
+
+#endif /* ORDERWAL_H */
@@ -0,0 +1,213 @@
+// This is the implementation file for the StationRouter class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, StationRouter.h, provides the class structure and function declarations.
+
+//
+//  StationRouter.cpp
+//
+
+#include "StationRouter.h"
+#include <utility>
+
+// Constructor, binds the router to the menu and the stack without starting threads
+StationRouter::StationRouter(const DynamicArrayList& menu, CompletedOrdersStack& completedOrders,
+                             int prepMicrosPerItem)
+    : menu(menu), completedOrders(completedOrders), orderWal(NULL), stopping(false), nextOrderId(1), openOrders(0),
+      ordersCompleted(0), itemsPrepared(0), totalOrderMicros(0), maxOrderMicros(0) {
+    this->prepMicrosPerItem = prepMicrosPerItem > 0 ? prepMicrosPerItem : 0;
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        stations[s].ticketsDone.store(0);
+    }
+}
+
+// Destructor, makes sure no worker outlives the router
+StationRouter::~StationRouter() {
+    shutdown();
+}
+
+// Starts one worker thread per station
+void StationRouter::start() {
+    if (isRunning()) {
+        return;  // Already running
+    }
+    stopping.store(false);
+    startTime = chrono::steady_clock::now();
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        stations[s].worker = thread(&StationRouter::stationLoop, this, s);
+    }
+}
+
+// Asks the stations to finish their tickets and waits for them
+void StationRouter::shutdown() {
+    if (!isRunning()) {
+        return;
+    }
+    stopping.store(true);
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        lock_guard<mutex> guard(stations[s].lock);  // No worker is between its check and its wait
+        stations[s].ready.notify_all();
+    }
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        stations[s].worker.join();
+    }
+    stopTime = chrono::steady_clock::now();
+}
+
+// Returns true while worker threads exist
+bool StationRouter::isRunning() const {
+    return stations[0].worker.joinable();
+}
+
+// Splits a copy of an order into station tickets
+int StationRouter::submit(const Order& newOrder) {
+    return submit(Order(newOrder));
+}
+
+// Splits an order into station tickets, taking over its data
+int StationRouter::submit(Order&& newOrder) {
+    PendingOrder* pending = new PendingOrder;
+    pending->order = std::move(newOrder);
+    int orderId = nextOrderId.fetch_add(1);
+    pending->order.setOrderId(orderId);
+    pending->order.markPlaced();
+    route(pending);  // May complete and delete the order at once
+    return orderId;
+}
+
+// Splits an order that keeps its ID and stamps into station tickets
+void StationRouter::dispatch(Order&& order) {
+    PendingOrder* pending = new PendingOrder;
+    pending->order = std::move(order);
+    int orderId = pending->order.getOrderId();
+    int next = nextOrderId.load();
+    while (orderId >= next && !nextOrderId.compare_exchange_weak(next, orderId + 1)) {
+        // next was reloaded by compare_exchange_weak; never hand out this ID again
+    }
+    route(pending);
+}
+
+// Polls until no submitted order is open
+void StationRouter::waitUntilIdle() {
+    while (isRunning() && openOrders.load() > 0) {
+        this_thread::sleep_for(chrono::microseconds(50));
+    }
+}
+
+// Sets the write-ahead log that receives each completed order
+void StationRouter::setOrderWAL(OrderWAL* log) {
+    orderWal = log;
+}
+
+// Returns the number of orders still being prepared
+int StationRouter::getOpenOrders() const {
+    return openOrders.load();
+}
+
+// Returns throughput, ticket and order-time statistics
+StationStats StationRouter::getStats() const {
+    StationStats stats;
+    stats.ordersCompleted = ordersCompleted.load();
+    stats.itemsPrepared = itemsPrepared.load();
+    stats.ticketsCompleted = 0;
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        stats.ticketsByStation[s] = stations[s].ticketsDone.load();
+        stats.ticketsCompleted += stats.ticketsByStation[s];
+    }
+    chrono::steady_clock::time_point end = isRunning() ? chrono::steady_clock::now() : stopTime;
+    stats.elapsedSeconds = chrono::duration<double>(end - startTime).count();
+    stats.ordersPerSecond = stats.elapsedSeconds > 0 ? stats.ordersCompleted / stats.elapsedSeconds : 0;
+    stats.averageOrderMicros = stats.ordersCompleted > 0
+        ? (double)totalOrderMicros.load() / stats.ordersCompleted : 0;
+    stats.maxOrderMicros = maxOrderMicros.load();
+    return stats;
+}
+
+// Queues one ticket per station the order needs
+void StationRouter::route(PendingOrder* pending) {
+    Order& order = pending->order;
+    pending->started.store(false);
+    pending->submittedAt = chrono::steady_clock::now();
+
+    // Count the items of each station; the lines are few, so this is a short scan
+    int items[STATION_COUNT] = {0};
+    for (int i = 0; i < order.getLineCount(); ++i) {
+        const OrderLine& line = order.getLine(i);
+        const MenuItem* item = menu.findMenuItem(line.menuItemId);
+        items[item != NULL ? item->getStation() : STATION_LINE] += line.quantity;
+    }
+    int tickets = 0;
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        tickets += items[s] > 0;
+    }
+    openOrders.fetch_add(1);
+    if (tickets == 0) {
+        completeOrder(pending);  // Nothing to prepare
+        return;
+    }
+
+    // Set the count before the first ticket is visible, so no station can finish early
+    pending->ticketsLeft.store(tickets);
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        if (items[s] > 0) {
+            Ticket ticket = {pending, items[s]};
+            {
+                lock_guard<mutex> guard(stations[s].lock);
+                stations[s].tickets.push_back(ticket);
+            }
+            stations[s].ready.notify_one();
+        }
+    }
+}
+
+// The body of each station's worker thread
+void StationRouter::stationLoop(int s) {
+    Station& station = stations[s];
+    while (true) {
+        Ticket ticket;
+        {
+            unique_lock<mutex> lock(station.lock);
+            while (station.tickets.empty()) {
+                if (stopping.load()) {
+                    return;  // Shutdown requested and nothing left to drain
+                }
+                station.ready.wait(lock);
+            }
+            ticket = station.tickets.front();
+            station.tickets.pop_front();
+        }
+
+        PendingOrder* pending = ticket.pending;
+        if (!pending->started.exchange(true)) {
+            pending->order.markStarted();  // The first station to pick the order up
+        }
+        if (prepMicrosPerItem > 0) {  // Simulate preparing the items
+            this_thread::sleep_for(chrono::microseconds((long long)prepMicrosPerItem * ticket.items));
+        }
+        itemsPrepared.fetch_add(ticket.items);
+        station.ticketsDone.fetch_add(1);
+        if (pending->ticketsLeft.fetch_sub(1) == 1) {
+            completeOrder(pending);  // This was the last open ticket
+        }
+    }
+}
+
+// Pushes a finished order and records how long it took
+void StationRouter::completeOrder(PendingOrder* pending) {
+    long long orderMicros = chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - pending->submittedAt).count();
+    pending->order.setStatus("completed");
+    pending->order.markCompleted();  // Logged with the same time the stack keeps
+    if (orderWal != NULL) {
+        orderWal->recordProcess(pending->order);  // Only now is the order really done
+    }
+    completedOrders.push(std::move(pending->order));  // The stack takes its own lock
+    delete pending;
+
+    totalOrderMicros.fetch_add(orderMicros);
+    long long currentMax = maxOrderMicros.load();
+    while (orderMicros > currentMax && !maxOrderMicros.compare_exchange_weak(currentMax, orderMicros)) {
+        // currentMax was reloaded by compare_exchange_weak; try again
+    }
+    ordersCompleted.fetch_add(1);
+    openOrders.fetch_sub(1);
+}
@@ -0,0 +1,261 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the StationRouter class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   StationRouter.cpp where the logic of each method is fully defined.
+   StationRouter.h contains the declaration of the StationRouter class.
+   This class is a kitchen execution engine that works per station instead of
+   per order. When an order is submitted, its items are grouped by the prep
+   station of their menu item and one ticket per station is put on that
+   station's queue. Each station has its own worker thread that prepares its
+   tickets one after another (simulated by a fixed preparation time per item).
+   A salad no longer waits behind the grill item of the same order: the
+   stations work on an order in parallel, and an order is only as slow as its
+   busiest station.
+
+   Each pending order counts the tickets still open. The station that
+   finishes the last one marks the order "completed" and pushes it onto the
+   CompletedOrdersStack, which locks itself, so other code may read the
+   stack while the router is running. With an OrderWAL set, the order's
+   process record is written at that moment, after it is stamped completed. The menu is read by submit and
+   dispatch and must not change while an order is being routed.
+   main.cpp and BatchRunner give processed orders to a KitchenWorkerPool
+   bound to a router: its workers dispatch each order here, keeping the ID
+   the active queue gave it, and the stations prepare it.
+
+   Basic operations:
+     - Constructor: Creates a router bound to the menu and a completed stack.
+     - Destructor:  Shuts the router down if it is still running.
+     - start:       Starts one worker thread per station.
+     - shutdown:    Lets the stations drain their queues, then stops and joins them.
+     - isRunning:   Checks whether the worker threads are running.
+     - submit:      Splits an order into station tickets and queues them.
+                    Safe to call from any thread. A temporary order is moved in.
+     - dispatch:    Same as submit for an order that keeps its ID and stamps.
+     - getOpenOrders: Number of submitted orders not completed yet.
+     - waitUntilIdle: Waits until every submitted order has been completed.
+     - setOrderWAL: Logs each order's process record when it completes.
+     - getStats:    Returns throughput, ticket and order-time statistics.
+
+   Private utility:
+     - PendingOrder: An order whose tickets are being prepared.
+     - Ticket:       The part of an order one station prepares.
+     - Station:      A station's ticket queue, its worker and its counters.
+     - route:        Queues one ticket per station a pending order needs.
+     - stationLoop:  The body of each station's worker thread.
+     - completeOrder: Pushes an order whose last ticket is done.
+
+   Data members:
+     - menu:            The menu the item stations are read from.
+     - completedOrders: The stack completed orders are pushed onto.
+     - orderWal:        Write-ahead log receiving completed orders, or NULL.
+     - prepMicrosPerItem: Simulated preparation time per item, in microseconds.
+     - stations:        One queue and worker per prep station.
+     - stopping:        Set by shutdown; workers exit once their queue is empty.
+     - nextOrderId:     Counter for assigning unique order IDs.
+     - openOrders:      Submitted orders not completed yet.
+     - ordersCompleted, itemsPrepared, totalOrderMicros, maxOrderMicros: Counters.
+     - startTime, stopTime: When the router was started and shut down.
+
+--------------------------------------------------------------------------*/
+
+#ifndef STATIONROUTER_H
+#define STATIONROUTER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+#include "OrderWAL.h"
+using namespace std;
+
+// Throughput and latency figures reported by StationRouter::getStats.
+struct StationStats {
+    long ordersCompleted;     // Orders pushed onto the completed stack.
+    long ticketsCompleted;    // Station tickets prepared.
+    long itemsPrepared;       // Items in those tickets.
+    double elapsedSeconds;    // Time since start (or between start and shutdown).
+    double ordersPerSecond;   // ordersCompleted / elapsedSeconds.
+    double averageOrderMicros; // Mean time from submit until the last ticket was done.
+    long long maxOrderMicros; // Longest time from submit until the last ticket was done.
+    long ticketsByStation[STATION_COUNT]; // Tickets prepared at each station.
+};
+
+class StationRouter {
+public:
+    StationRouter(const DynamicArrayList&, CompletedOrdersStack&, int prepMicrosPerItem = 0);
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a router with one queue per prep station.
+
+      Precondition:  prepMicrosPerItem is zero or positive. The menu and the
+                     stack outlive the router.
+      Postcondition: The router is created but no threads are running.
+     -----------------------------------------------------------------------*/
+    ~StationRouter();
+    /*------------------------------------------------------------------------
+      Purpose:       Destructor: Shuts the router down if it is still running.
+
+      Precondition:  None.
+      Postcondition: All worker threads have been joined.
+     -----------------------------------------------------------------------*/
+    void start();
+    /*------------------------------------------------------------------------
+      Purpose:       Starts the station worker threads.
+
+      Precondition:  The router is not running.
+      Postcondition: One thread per station is preparing tickets.
+     -----------------------------------------------------------------------*/
+    void shutdown();
+    /*------------------------------------------------------------------------
+      Purpose:       Stops the router after every station queue has been drained.
+
+      Precondition:  Producers have stopped submitting orders.
+      Postcondition: Every submitted order has been completed and pushed,
+                     and all worker threads have been joined.
+     -----------------------------------------------------------------------*/
+    bool isRunning() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Checks whether the worker threads are running.
+
+      Precondition:  None.
+      Postcondition: Returns true between start and shutdown.
+     -----------------------------------------------------------------------*/
+    int submit(const Order&);
+    /*------------------------------------------------------------------------
+      Purpose:       Splits an order into station tickets and queues them.
+
+      Precondition:  The menu is not being changed. Safe to call from any
+                     thread while the router runs; orders submitted before
+                     start wait for it.
+      Postcondition: The order has the next unused order ID, which is
+                     returned, and is stamped as placed. Each station that
+                     prepares one of its items has a ticket for it. Items
+                     no longer on the menu are prepared on the line; an
+                     order without items is completed at once.
+     -----------------------------------------------------------------------*/
+    int submit(Order&&);
+    /*------------------------------------------------------------------------
+      Purpose:       Moves an order into the router and queues its tickets.
+
+      Precondition:  Same as submit(const Order&).
+      Postcondition: Same as submit(const Order&), but the order's data has
+                     been moved in; newOrder is left empty.
+     -----------------------------------------------------------------------*/
+    void dispatch(Order&&);
+    /*------------------------------------------------------------------------
+      Purpose:       Moves an order that already has its ID into the router.
+
+      Precondition:  Same as submit(const Order&). The order has its ID and
+                     placed stamp, for example from ActiveOrdersQueue::dequeue.
+      Postcondition: Same as submit(Order&&), but the order keeps its ID and
+                     stamps, and nextOrderId has been moved past that ID.
+     -----------------------------------------------------------------------*/
+    void waitUntilIdle();
+    /*------------------------------------------------------------------------
+      Purpose:       Waits until every submitted order has been completed.
+
+      Precondition:  No other thread submits orders meanwhile.
+      Postcondition: If the router is running, no order is open. Returns at
+                     once if it is not running.
+     -----------------------------------------------------------------------*/
+    void setOrderWAL(OrderWAL*);
+    /*------------------------------------------------------------------------
+      Purpose:       Sets the write-ahead log completed orders are recorded in.
+
+      Precondition:  The router is not running, and the log outlives it.
+                     NULL turns logging off.
+      Postcondition: Each order is logged with OrderWAL::recordProcess once
+                     its last ticket is done, before it is pushed.
+     -----------------------------------------------------------------------*/
+    int getOpenOrders() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns how many submitted orders are not completed yet.
+
+      Precondition:  None.
+      Postcondition: Returns the count at the time of the call.
+     -----------------------------------------------------------------------*/
+    StationStats getStats() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns throughput, ticket and order-time statistics.
+
+      Precondition:  None.
+      Postcondition: Returns the figures accumulated since start.
+     -----------------------------------------------------------------------*/
+
+private:
+    StationRouter(const StationRouter&);            // Not copyable.
+    StationRouter& operator=(const StationRouter&);
+
+    // An order whose tickets are being prepared; the last station deletes it.
+    struct PendingOrder {
+        Order order;                 // The order, pushed once complete.
+        atomic<int> ticketsLeft;     // Tickets not prepared yet.
+        atomic<bool> started;        // True once a station has taken a ticket.
+        chrono::steady_clock::time_point submittedAt; // When submit was called.
+    };
+
+    // The part of one order a single station prepares.
+    struct Ticket {
+        PendingOrder* pending;       // The order the ticket belongs to.
+        int items;                   // Items to prepare at this station.
+    };
+
+    // A station's queue of tickets and the worker that drains it.
+    struct Station {
+        mutex lock;                  // Guards tickets.
+        condition_variable ready;    // Signals a new ticket or shutdown.
+        deque<Ticket> tickets;       // Tickets waiting at the station.
+        thread worker;               // The station's worker thread.
+        atomic<long> ticketsDone;    // Tickets prepared since start.
+    };
+
+    void route(PendingOrder*);
+    /*------------------------------------------------------------------------
+      Purpose:       Queues one ticket per station a pending order needs.
+
+      Precondition:  The pending order holds the submitted order, which has
+                     its ID and placed stamp.
+      Postcondition: The tickets are queued, or the order is completed at
+                     once if it has no items. The pending order may already
+                     have been deleted.
+     -----------------------------------------------------------------------*/
+    void stationLoop(int);
+    /*------------------------------------------------------------------------
+      Purpose:       Runs one station: take a ticket, prepare it, repeat.
+
+      Precondition:  Called on the station's worker thread.
+      Postcondition: Returns once shutdown was requested and the station's
+                     queue is empty.
+     -----------------------------------------------------------------------*/
+    void completeOrder(PendingOrder*);
+    /*------------------------------------------------------------------------
+      Purpose:       Completes an order whose last ticket is done.
+
+      Precondition:  No ticket of the order is left.
+      Postcondition: The order is marked and stamped completed, logged in the
+                     write-ahead log if one is set, and pushed; the statistics
+                     are updated and the pending order is deleted.
+     -----------------------------------------------------------------------*/
+
+    const DynamicArrayList& menu;          // Menu the item stations come from.
+    CompletedOrdersStack& completedOrders; // Stack of finished orders.
+    OrderWAL* orderWal;                    // Log of completed orders, or NULL.
+    int prepMicrosPerItem;                 // Simulated preparation time per item.
+    Station stations[STATION_COUNT];       // One queue and worker per station.
+    atomic<bool> stopping;                 // True once shutdown has been requested.
+    atomic<int> nextOrderId;               // Identifier for the next order.
+    atomic<int> openOrders;                // Orders submitted but not completed.
+    atomic<long> ordersCompleted;          // Orders completed since start.
+    atomic<long> itemsPrepared;            // Items prepared since start.
+    atomic<long long> totalOrderMicros;    // Sum of submit-to-completion times.
+    atomic<long long> maxOrderMicros;      // Longest submit-to-completion time.
+    chrono::steady_clock::time_point startTime; // When start was called.
+    chrono::steady_clock::time_point stopTime;  // When shutdown finished.
+};
+
+#endif /* STATIONROUTER_H */
@@ -0,0 +1,174 @@
+// This is the implementation file for the SystemSnapshot class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, SystemSnapshot.h, provides the class structure and function declarations.
+
+//
+//  SystemSnapshot.cpp
+//
+
+#include "SystemSnapshot.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <cstring>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include "BinaryIO.h"
+
+static const char SNAPSHOT_MAGIC[] = "RMSSNAPS";  // First bytes of every snapshot
+static const size_t SNAPSHOT_MAGIC_SIZE = 8;
+static const size_t SNAPSHOT_HEADER_SIZE = SNAPSHOT_MAGIC_SIZE + 4 + 8 + 4;  // Magic, version, length, checksum
+
+const int SystemSnapshot::FORMAT_VERSION;
+
+// Constructor, binds the snapshot to the system state
+SystemSnapshot::SystemSnapshot(DynamicArrayList& menu, ActiveOrdersQueue& activeOrders,
+                               CompletedOrdersStack& completedOrders)
+    : menu(menu), activeOrders(activeOrders), completedOrders(completedOrders), saveSucceeded(true) {
+    lastEncodeMillis = 0;
+    lastImageSize = 0;
+}
+
+// Destructor, waits for a running background write
+SystemSnapshot::~SystemSnapshot() {
+    waitForSave();
+}
+
+// Encodes the menu and queue and freezes the stack now; the rest runs in the background
+bool SystemSnapshot::save(const string& fileName) {
+    bool previous = waitForSave();  // One write at a time
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    string* image = new string;  // The writer thread owns and deletes it
+    image->reserve(lastImageSize + lastImageSize / 8);  // Avoids regrowing a large buffer
+    image->append(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+    appendInt32(*image, FORMAT_VERSION);
+    image->append(8 + 4, '\0');  // Length and checksum, filled in by the writer
+    menu.writeBinary(*image);
+    activeOrders.writeBinary(*image);
+    CompletedOrdersStack::Frozen completed = completedOrders.freeze();  // Shares the chunks, no orders copied
+    lastEncodeMillis = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    saveSucceeded = false;
+    writer = thread(&SystemSnapshot::writeImage, this, image, std::move(completed), fileName);
+    return previous;
+}
+
+// Waits for the background write and returns whether it succeeded
+bool SystemSnapshot::waitForSave() {
+    if (writer.joinable()) {
+        writer.join();
+    }
+    return saveSucceeded;
+}
+
+// Restores the state from a snapshot file
+bool SystemSnapshot::load(const string& fileName) {
+    waitForSave();  // The stack cannot be swapped while a frozen copy of it is being written
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;  // No snapshot yet
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < SNAPSHOT_HEADER_SIZE) {
+        close(fd);
+        cerr << "Snapshot is too short: " << fileName << endl;
+        return false;
+    }
+    size_t fileSize = info.st_size;
+    void* mapped = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping stays valid after the descriptor is closed
+    if (mapped == MAP_FAILED) {
+        cerr << "Failed to read snapshot: " << fileName << endl;
+        return false;
+    }
+    madvise(mapped, fileSize, MADV_SEQUENTIAL);  // Decoded front to back once
+    const char* image = static_cast<const char*>(mapped);
+
+    bool loaded = false;
+    BinaryReader header(image + SNAPSHOT_MAGIC_SIZE, SNAPSHOT_HEADER_SIZE - SNAPSHOT_MAGIC_SIZE);
+    int32_t version = 0, checksum = 0;
+    int64_t length = 0;
+    header.readInt32(version);
+    header.readInt64(length);
+    header.readInt32(checksum);
+    const char* payload = image + SNAPSHOT_HEADER_SIZE;
+    if (memcmp(image, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0) {
+        cerr << "Not a snapshot file: " << fileName << endl;
+    } else if (version < 1 || version > FORMAT_VERSION) {
+        cerr << "Unsupported snapshot version " << version << ": " << fileName << endl;
+    } else if (length != static_cast<int64_t>(fileSize - SNAPSHOT_HEADER_SIZE)
+               || checksumWords(payload, length) != static_cast<uint32_t>(checksum)) {
+        cerr << "Snapshot is damaged: " << fileName << endl;
+    } else {
+        // The checksum matched, so the sections decode unless the file was written by a buggy build.
+        // Decode into new containers so a bad section leaves all three untouched.
+        BinaryReader reader(payload, length);
+        DynamicArrayList loadedMenu(10);
+        ActiveOrdersQueue loadedOrders;
+        CompletedOrdersStack loadedCompleted;
+        loaded = loadedMenu.readBinary(reader)
+                 && loadedOrders.readBinary(reader, &menu)  // Orders point at the live menu
+                 && loadedCompleted.readBinary(reader, &menu);
+        if (loaded) {
+            menu = std::move(loadedMenu);
+            activeOrders.swap(loadedOrders);     // The old orders go with the temporaries
+            completedOrders.swap(loadedCompleted);
+            lastImageSize = fileSize;  // The next save will need about as much
+        } else {
+            cerr << "Snapshot could not be decoded: " << fileName << endl;
+        }
+    }
+    munmap(mapped, fileSize);
+    return loaded;
+}
+
+// Returns how long the last save held the containers
+double SystemSnapshot::getLastEncodeMillis() const {
+    return lastEncodeMillis;
+}
+
+// Body of the writer thread: completed orders, checksum, temporary file, fsync, rename
+void SystemSnapshot::writeImage(string* image, CompletedOrdersStack::Frozen completed, string fileName) {
+    completed.writeBinary(*image);
+    completed.release();  // Push and pop stop copying chunks for this snapshot
+    const char* payload = image->data() + SNAPSHOT_HEADER_SIZE;
+    size_t length = image->size() - SNAPSHOT_HEADER_SIZE;
+    char* at = &(*image)[SNAPSHOT_MAGIC_SIZE + 4];
+    at = storeInt64(at, static_cast<int64_t>(length));
+    storeInt32(at, static_cast<int32_t>(checksumWords(payload, length)));
+    lastImageSize = image->size();  // Read by the next save only after joining this thread
+
+    string tempFile = fileName + ".tmp";
+    bool ok = false;
+    int fd = open(tempFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        const char* next = image->data();
+        size_t left = image->size();
+        while (left > 0) {
+            ssize_t written = write(fd, next, left);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                break;
+            }
+            next += written;
+            left -= written;
+        }
+        ok = left == 0 && fsync(fd) == 0;  // On disk before it replaces the old snapshot
+        close(fd);
+    }
+    if (ok) {
+        ok = rename(tempFile.c_str(), fileName.c_str()) == 0;
+    } else {
+        remove(tempFile.c_str());
+        cerr << "Failed to write snapshot: " << fileName << endl;
+    }
+    delete image;
+    saveSucceeded = ok;
+}
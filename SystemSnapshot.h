@@ -0,0 +1,148 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the SystemSnapshot class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   SystemSnapshot.cpp where the logic of each method is fully defined.
+   SystemSnapshot.h contains the declaration of the SystemSnapshot class.
+   This class saves and restores the whole state of the system in one binary
+   file: the menu with its ID counter, the active orders queue with its order
+   ID counter, and the completed orders stack.
+
+   File format (version 4):
+     - 8-byte magic "RMSSNAPS"
+     - 32-bit format version
+     - 64-bit payload length and 32-bit checksum of the payload
+     - payload: the menu, the active queue and the completed stack, each
+       written by its own writeBinary method
+   Version 2 orders carry their lifecycle stamps, version 3 orders also
+   their priority, and version 4 menu items their prep station. Older files
+   still load; Order::readBinary and DynamicArrayList::readBinary tell the
+   record formats apart, leaving old orders unstamped and of normal priority
+   and old items on the line. Files with a newer version than this build
+   understands are rejected.
+
+   Saving is split in two. On the calling thread, the menu and the active
+   queue, which stay small, are encoded into a memory buffer, and the
+   completed stack, which grows all day, is frozen: the frozen copy shares
+   the stack's chunks, which are copied on write. This is the only time the
+   containers must not change. A background thread then encodes the frozen
+   orders, writes the buffer to a temporary file, syncs it and renames it
+   over the snapshot, so neither encoding the day's orders nor disk latency
+   pauses order intake.
+   Loading maps the file into memory and decodes all three sections into
+   new containers first. Only when every section decodes are they swapped
+   into the live menu, queue and stack, so a bad section changes nothing.
+
+   Basic operations:
+     - Constructor: Binds the snapshot to the menu, the queue and the stack.
+     - Destructor:  Waits for a running background write.
+     - save:        Encodes the state and starts writing it in the background.
+     - waitForSave: Waits for the background write and reports whether it succeeded.
+     - load:        Restores the state from a snapshot file.
+     - getLastEncodeMillis: How long the last save held the containers.
+
+   Private utility:
+     - writeImage: Body of the background writer thread.
+
+   Data members:
+     - menu, activeOrders, completedOrders: The state being saved and restored.
+     - writer:          The background writer thread.
+     - saveSucceeded:   Result of the last background write.
+     - lastEncodeMillis: Time the last save held the containers.
+     - lastImageSize:   Size of the last snapshot saved or loaded, used to
+                        size the encode buffer up front.
+
+--------------------------------------------------------------------------*/
+
+#ifndef SYSTEMSNAPSHOT_H
+#define SYSTEMSNAPSHOT_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "ActiveOrdersQueue.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+using namespace std;
+
+class SystemSnapshot {
+public:
+    static const int FORMAT_VERSION = 4; // Version written by save.
+
+    SystemSnapshot(DynamicArrayList&, ActiveOrdersQueue&, CompletedOrdersStack&);
+    /*------------------------------------------------------------------------
+      Purpose:       Creates a snapshot helper for the given state.
+
+      Precondition:  The menu, queue and stack outlive the snapshot helper.
+      Postcondition: No save is running.
+     -----------------------------------------------------------------------*/
+    ~SystemSnapshot();
+    /*------------------------------------------------------------------------
+      Purpose:       Destructor: Waits for a running background write.
+
+      Precondition:  None.
+      Postcondition: The writer thread has been joined.
+     -----------------------------------------------------------------------*/
+    bool save(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Saves the current state to a snapshot file.
+
+      Precondition:  No other thread changes the menu or queue during the
+                     call. The stack locks itself and may keep changing.
+      Postcondition: The menu and queue have been encoded and the stack
+                     frozen; the completed orders are being encoded and the
+                     snapshot written in the background. Call waitForSave for
+                     the result. A previous save is waited for first. Returns
+                     false if the previous save failed.
+     -----------------------------------------------------------------------*/
+    bool waitForSave();
+    /*------------------------------------------------------------------------
+      Purpose:       Waits for the background write to finish.
+
+      Precondition:  None.
+      Postcondition: Returns true if the last save reached the disk (or no
+                     save was started).
+     -----------------------------------------------------------------------*/
+    bool load(const string&);
+    /*------------------------------------------------------------------------
+      Purpose:       Restores the state from a snapshot file.
+
+      Precondition:  None.
+      Postcondition: A running save has been waited for. The menu, queue
+                     and stack hold the saved state, with their ID counters.
+                     Returns false, leaving all three unchanged, if the file
+                     is missing, from a newer version, fails its checksum or
+                     any section fails to decode.
+     -----------------------------------------------------------------------*/
+    double getLastEncodeMillis() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns how long the last save held the containers.
+
+      Precondition:  None.
+      Postcondition: Returns the encode time of the last save in milliseconds.
+     -----------------------------------------------------------------------*/
+
+private:
+    SystemSnapshot(const SystemSnapshot&);            // Not copyable.
+    SystemSnapshot& operator=(const SystemSnapshot&);
+
+    void writeImage(string*, CompletedOrdersStack::Frozen, string);
+    /*------------------------------------------------------------------------
+      Purpose:       Finishes encoding a snapshot and writes it to its file.
+
+      Precondition:  Runs on the writer thread, which owns the image. The
+                     image holds the header, the menu and the active queue.
+      Postcondition: The frozen orders, length and checksum have been added,
+                     and the image has been written to a temporary file,
+                     synced and renamed over the snapshot, and then deleted.
+     -----------------------------------------------------------------------*/
+
+    DynamicArrayList& menu;               // The menu being saved.
+    ActiveOrdersQueue& activeOrders;      // The active queue being saved.
+    CompletedOrdersStack& completedOrders; // The completed stack being saved.
+    thread writer;                        // Background writer thread.
+    atomic<bool> saveSucceeded;           // Result of the last background write.
+    double lastEncodeMillis;              // Encode time of the last save.
+    size_t lastImageSize;                 // Bytes in the last snapshot saved or loaded.
+};
+
+#endif /* SYSTEMSNAPSHOT_H */
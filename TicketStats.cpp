@@ -0,0 +1,118 @@
+// This is the implementation file for the TicketStats class.
+// For function behaviors and details about the methods used, please refer to this file.
+// The corresponding header file, TicketStats.h, provides the class structure and function declarations.
+
+//
+//  TicketStats.cpp
+//
+
+#include "TicketStats.h"
+#include <cstdio>
+
+// Constructor, no orders and no target
+TicketStats::TicketStats() {
+    targetMillis = 0;
+    lateCount = 0;
+}
+
+// Counts the stage times of a completed order
+void TicketStats::record(const Order& order) {
+    long long placed = order.getPlacedAt();
+    long long started = order.getStartedAt();
+    long long completed = order.getCompletedAt();
+    if (placed < 0 || completed < 0) {
+        return;  // No times to count
+    }
+    ticketTimes.record(completed - placed);
+    if (started >= 0) {
+        waitTimes.record(started - placed);
+        cookTimes.record(completed - started);
+    }
+    if (targetMillis > 0 && completed - placed > targetMillis) {
+        lateCount++;
+    }
+}
+
+// Takes back an order counted by record
+void TicketStats::remove(const Order& order) {
+    long long placed = order.getPlacedAt();
+    long long started = order.getStartedAt();
+    long long completed = order.getCompletedAt();
+    if (placed < 0 || completed < 0) {
+        return;  // It was never counted
+    }
+    ticketTimes.remove(completed - placed);
+    if (started >= 0) {
+        waitTimes.remove(started - placed);
+        cookTimes.remove(completed - started);
+    }
+    if (targetMillis > 0 && completed - placed > targetMillis && lateCount > 0) {
+        lateCount--;
+    }
+}
+
+// Removes every order, keeping the target
+void TicketStats::clear() {
+    waitTimes.clear();
+    cookTimes.clear();
+    ticketTimes.clear();
+    lateCount = 0;
+}
+
+// Sets the target ticket time in milliseconds
+void TicketStats::setTargetMillis(long long millis) {
+    targetMillis = millis > 0 ? millis : 0;
+}
+
+// Returns the target ticket time in milliseconds
+long long TicketStats::getTargetMillis() const {
+    return targetMillis;
+}
+
+// Returns the number of orders counted
+long long TicketStats::getCount() const {
+    return ticketTimes.getCount();
+}
+
+// Returns the number of orders over the target
+long long TicketStats::getLateCount() const {
+    return lateCount;
+}
+
+// Returns the placed-to-started histogram
+const LatencyHistogram& TicketStats::getWaitTimes() const {
+    return waitTimes;
+}
+
+// Returns the started-to-completed histogram
+const LatencyHistogram& TicketStats::getCookTimes() const {
+    return cookTimes;
+}
+
+// Returns the placed-to-completed histogram
+const LatencyHistogram& TicketStats::getTicketTimes() const {
+    return ticketTimes;
+}
+
+// Writes one line per stage, times in seconds
+void TicketStats::writeReport(ostream& out) const {
+    const char* const names[] = {"wait", "cook", "ticket"};
+    const LatencyHistogram* stages[] = {&waitTimes, &cookTimes, &ticketTimes};
+    char line[160];
+    snprintf(line, sizeof(line), "%-8s %8s %9s %9s %9s %9s %9s\n",
+             "stage", "orders", "mean s", "p50 s", "p90 s", "p99 s", "max s");
+    out << line;
+    for (int i = 0; i < 3; ++i) {
+        const LatencyHistogram& h = *stages[i];
+        snprintf(line, sizeof(line), "%-8s %8lld %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+                 names[i], h.getCount(), h.getMean() / 1000, h.getPercentile(0.5) / 1000.0,
+                 h.getPercentile(0.9) / 1000.0, h.getPercentile(0.99) / 1000.0, h.getMax() / 1000.0);
+        out << line;
+    }
+    if (targetMillis > 0) {
+        long long count = getCount();
+        snprintf(line, sizeof(line), "%lld of %lld orders over the %.1f minute target (%.1f%%)\n",
+                 lateCount, count, targetMillis / 60000.0, count > 0 ? 100.0 * lateCount / count : 0.0);
+        out << line;
+    }
+}
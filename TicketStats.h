@@ -0,0 +1,143 @@
+/*--------------------------------------------------------------------------
+   This is the header file for the TicketStats class implementation.
+   For function implementations and detailed behavior, please refer to the corresponding .cpp file
+   TicketStats.cpp where the logic of each method is fully defined.
+   TicketStats.h contains the declaration of the TicketStats class.
+   This class keeps running statistics of how long completed orders took,
+   from the lifecycle stamps on each Order. Three stages are tracked, in
+   milliseconds, each in a LatencyHistogram:
+     - wait:   placed to started (time in the queue),
+     - cook:   started to completed,
+     - ticket: placed to completed (what the customer sees).
+   Recording or removing an order is constant time, and the mean, max and
+   any percentile can be read at any moment without walking the orders, so
+   the kitchen can be watched live. An optional target ticket time counts
+   the orders that missed it.
+   Orders without stamps, such as those restored from files written before
+   the stamps existed, are not counted.
+
+   Basic operations:
+     - Constructor:     Constructs empty statistics with no target.
+     - record:          Adds a completed order.
+     - remove:          Takes back an order added earlier.
+     - clear:           Removes every order.
+     - setTargetMillis: Sets the target ticket time.
+     - getTargetMillis: Returns the target ticket time.
+     - getCount:        Returns the number of orders counted.
+     - getLateCount:    Returns the number of orders over the target.
+     - getWaitTimes:    Returns the placed-to-started histogram.
+     - getCookTimes:    Returns the started-to-completed histogram.
+     - getTicketTimes:  Returns the placed-to-completed histogram.
+     - writeReport:     Writes a table of the three stages.
+
+   Data members:
+     - waitTimes:    Milliseconds from placed to started.
+     - cookTimes:    Milliseconds from started to completed.
+     - ticketTimes:  Milliseconds from placed to completed.
+     - targetMillis: Target ticket time, 0 for none.
+     - lateCount:    Orders whose ticket time is over the target.
+
+--------------------------------------------------------------------------*/
+
+#ifndef TICKETSTATS_H
+#define TICKETSTATS_H
+
+#include <iostream>
+#include "LatencyHistogram.h"
+#include "Order.h"
+using namespace std;
+
+class TicketStats {
+public:
+    TicketStats();
+    /*------------------------------------------------------------------------
+      Purpose:       Constructs empty statistics.
+
+      Precondition:  None.
+      Postcondition: No orders are counted and there is no target.
+     -----------------------------------------------------------------------*/
+    void record(const Order&);
+    /*------------------------------------------------------------------------
+      Purpose:       Adds a completed order.
+
+      Precondition:  None.
+      Postcondition: If the order has placed and completed stamps its ticket
+                     time is counted, and its wait and cook times if it also
+                     has a started stamp. Other orders are ignored.
+     -----------------------------------------------------------------------*/
+    void remove(const Order&);
+    /*------------------------------------------------------------------------
+      Purpose:       Takes back an order added earlier.
+
+      Precondition:  The order was recorded with the same stamps and not
+                     removed since.
+      Postcondition: The order no longer counts. The max times stay the
+                     largest ever recorded.
+     -----------------------------------------------------------------------*/
+    void clear();
+    /*------------------------------------------------------------------------
+      Purpose:       Removes every order.
+
+      Precondition:  None.
+      Postcondition: No orders are counted; the target is kept.
+     -----------------------------------------------------------------------*/
+    void setTargetMillis(long long);
+    /*------------------------------------------------------------------------
+      Purpose:       Sets the target ticket time.
+
+      Precondition:  The target is in milliseconds; 0 means no target.
+                     Orders recorded before the target changed are counted
+                     against the old one, so set it before recording or
+                     clear and record again.
+      Postcondition: Later orders over the target count as late.
+     -----------------------------------------------------------------------*/
+    long long getTargetMillis() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the target ticket time.
+
+      Precondition:  None.
+      Postcondition: Returns milliseconds, or 0 if there is no target.
+     -----------------------------------------------------------------------*/
+    long long getCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the number of orders counted.
+
+      Precondition:  None.
+      Postcondition: Orders without stamps are not included.
+     -----------------------------------------------------------------------*/
+    long long getLateCount() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Returns the number of orders that missed the target.
+
+      Precondition:  None.
+      Postcondition: Returns the orders whose ticket time is over the
+                     target; 0 if there is no target.
+     -----------------------------------------------------------------------*/
+    const LatencyHistogram& getWaitTimes() const;
+    const LatencyHistogram& getCookTimes() const;
+    const LatencyHistogram& getTicketTimes() const;
+    /*------------------------------------------------------------------------
+      Purpose:       Return the histograms of the three stages.
+
+      Precondition:  None.
+      Postcondition: Values are in milliseconds.
+     -----------------------------------------------------------------------*/
+    void writeReport(ostream&) const;
+    /*------------------------------------------------------------------------
+      Purpose:       Writes a table of the three stages.
+
+      Precondition:  None.
+      Postcondition: One line per stage with count, mean, p50, p90, p99 and
+                     max in seconds, then the late orders if there is a
+                     target.
+     -----------------------------------------------------------------------*/
+
+private:
+    LatencyHistogram waitTimes;    // Milliseconds from placed to started.
+    LatencyHistogram cookTimes;    // Milliseconds from started to completed.
+    LatencyHistogram ticketTimes;  // Milliseconds from placed to completed.
+    long long targetMillis;        // Target ticket time, 0 for none.
+    long long lateCount;           // Orders over the target.
+};
+
+#endif /* TICKETSTATS_H */
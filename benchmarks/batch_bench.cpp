@@ -0,0 +1,170 @@
+// This benchmark replays a generated day of traffic through the headless
+// BatchRunner: a few menu edits, 100k orders by default, a cancellation now
+// and then, the kitchen processing orders in bursts and an hourly report. It
+// runs the stream without persistence, with the order write-ahead log
+// (synced once per group of results, as main uses in batch mode), and with
+// the log and a kitchen worker pool preparing processed orders (as main
+// runs it). It reports commands per second and fsyncs, and checks that every
+// order ends up completed or cancelled, and that replaying the log rebuilds
+// the completed orders with the completion times of the run and appends each
+// to the completed-order log once.
+//
+// Build from the repository root:
+//   make batch_bench
+// Run:
+//   ./batch_bench [orders]
+
+//
+//  batch_bench.cpp
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "ActiveOrdersQueue.h"
+#include "AppendOnlyLog.h"
+#include "BatchRunner.h"
+#include "CompletedOrdersStack.h"
+#include "ConcurrentOrdersQueue.h"
+#include "DynamicArrayList.h"
+#include "KitchenWorkerPool.h"
+#include "MenuItem.h"
+#include "OrderWAL.h"
+
+using namespace std;
+
+static const string WAL_FILE = "batch_bench.wal";
+static const string ORDER_LOG_FILE = "batch_bench.log";
+
+// Writes the command stream of one day with `orders` orders; returns the number of cancellations.
+static int makeDay(int orders, string& day) {
+    ostringstream out;
+    out << "# generated day\n";
+    for (int i = 1; i <= 40; ++i) {
+        out << "item,Dish " << i << ",Made to order," << (5 + i % 12) << "." << (i % 4) * 25 << '\n';
+    }
+    int cancelled = 0;
+    for (int i = 1; i <= orders; ++i) {
+        out << "order,Guest " << i % 500 << ',';
+        for (int k = 0; k < 1 + i % 6; ++k) {
+            out << (k ? " " : "") << 1 + (i * 7 + k * 3) % 40;
+        }
+        out << '\n';
+        if (i % 50 == 0) {
+            out << "cancel," << i << '\n';  // The newest order is still queued
+            cancelled++;
+        }
+        if (i % 8 == 0) {
+            out << "process,8\n";
+        }
+        if (i % 5000 == 0) {
+            out << "price," << 1 + i % 40 << ",9.5\nreport\n";
+        }
+    }
+    out << "process," << orders << "\nreport\n";
+    day = out.str();
+    return cancelled;
+}
+
+// Runs the day; returns commands per second and sets whether every order was accounted for.
+static double runDay(const string& day, int orders, int cancelled, bool withWal, int kitchenWorkers,
+                     bool& balanced, long& commands, long long& fsyncs) {
+    DynamicArrayList menu(50);
+    ActiveOrdersQueue activeOrders;
+    CompletedOrdersStack completedOrders;
+    ConcurrentOrdersQueue kitchenQueue;
+    KitchenWorkerPool kitchen(kitchenQueue, completedOrders, kitchenWorkers > 0 ? kitchenWorkers : 1);
+    remove(WAL_FILE.c_str());
+    OrderWAL wal(WAL_FILE, FSYNC_EACH_COMMIT, 0, BatchRunner::ACK_GROUP_SIZE);
+    BatchRunner runner(menu, activeOrders, completedOrders);
+    if (withWal) {
+        wal.recover(activeOrders, completedOrders, &menu);
+        runner.setOrderWAL(&wal);
+    }
+    if (kitchenWorkers > 0) {
+        if (withWal) {
+            kitchen.setOrderWAL(&wal);  // The workers log each order once it is completed
+        }
+        kitchen.start();
+        runner.setKitchen(&kitchen);
+    }
+
+    istringstream in(day);
+    ostringstream out;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    int errors = runner.run(in, out);  // Returns once the kitchen is idle
+    kitchen.shutdown();
+    wal.close();
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    // Replaying the log must rebuild the same day, with the completion times of the original run.
+    // It is replayed twice onto a completed-order log, as main does after a crash: the first
+    // replay appends every completed order to it, the second finds them there already.
+    bool replayed = true;
+    if (withWal) {
+        remove(ORDER_LOG_FILE.c_str());
+        for (int pass = 0; pass < 2 && replayed; ++pass) {
+            unordered_set<int> loggedIds;
+            CompletedOrdersStack::readLoggedOrderIds(ORDER_LOG_FILE, loggedIds);
+            AppendOnlyLog orderLog;
+            orderLog.open(ORDER_LOG_FILE);
+            ActiveOrdersQueue recoveredActive;
+            CompletedOrdersStack recoveredCompleted;
+            recoveredCompleted.setOrderLog(&orderLog);
+            OrderWAL replay(WAL_FILE);
+            replay.recover(recoveredActive, recoveredCompleted, &menu, &loggedIds);
+            replay.close();
+            recoveredCompleted.setOrderLog(NULL);  // The pops below are only a check
+            orderLog.close();
+            replayed = recoveredActive.isEmpty() && recoveredCompleted.getSize() == completedOrders.getSize()
+                       && recoveredCompleted.getTotalRevenueCents() == completedOrders.getTotalRevenueCents();
+            while (replayed && !recoveredCompleted.isEmpty()) {
+                replayed = recoveredCompleted.pop().getCompletedAt() >= 0;
+            }
+        }
+        vector<string> logged;
+        replayed = replayed && AppendOnlyLog::readRecords(ORDER_LOG_FILE, logged)
+                   && static_cast<int>(logged.size()) == completedOrders.getSize();
+        remove(ORDER_LOG_FILE.c_str());
+    }
+    remove(WAL_FILE.c_str());
+
+    commands = runner.getCommandCount();
+    fsyncs = wal.getStats().fsyncs;
+    balanced = errors == 0 && replayed && activeOrders.isEmpty()
+               && completedOrders.getSize() == orders - cancelled;
+    return commands / chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    int orders = argc > 1 ? atoi(argv[1]) : 100000;
+    if (orders < 1) {
+        cerr << "orders must be positive" << endl;
+        return 1;
+    }
+
+    string day;
+    int cancelled = makeDay(orders, day);
+    bool plainOk, walOk;
+    long commands;
+    bool kitchenOk;
+    long long unused, fsyncs, kitchenFsyncs;
+    double plain = runDay(day, orders, cancelled, false, 0, plainOk, commands, unused);
+    double logged = runDay(day, orders, cancelled, true, 0, walOk, commands, fsyncs);
+    double cooked = runDay(day, orders, cancelled, true, 2, kitchenOk, commands, kitchenFsyncs);
+
+    printf("orders: %d, commands: %ld, stream: %.1f MB\n", orders, commands, day.size() / 1e6);
+    printf("no persistence:     %10.0f commands/s  (%.2f s for the day)\n", plain, commands / plain);
+    printf("write-ahead log:    %10.0f commands/s  (%.2f s for the day, %lld fsyncs)\n", logged,
+           commands / logged, fsyncs);
+    printf("log + 2 kitchen workers: %5.0f commands/s  (%.2f s for the day, %lld fsyncs)\n", cooked,
+           commands / cooked, kitchenFsyncs);
+    bool ok = plainOk && walOk && kitchenOk;
+    printf("every order completed or cancelled: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
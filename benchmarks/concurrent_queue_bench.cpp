@@ -0,0 +1,95 @@
+// This benchmark drives ConcurrentOrdersQueue with 1..N producer threads and
+// 1..N consumer threads and reports the throughput of each combination.
+// It doubles as a stress check: every order ID handed out must be dequeued
+// exactly once, and the queue must be empty at the end. The program exits
+// with a non-zero status if either check fails.
+//
+// Build from the repository root:
+//   make concurrent_queue_bench
+// Run:
+//   ./concurrent_queue_bench [max threads per side] [orders per producer]
+
+//
+//  concurrent_queue_bench.cpp
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "ConcurrentOrdersQueue.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : 4;
+    int ordersPerProducer = argc > 2 ? atoi(argv[2]) : 200000;
+    bool allPassed = true;
+
+    DynamicArrayList menu(10);
+    menu.addMenuItem(MenuItem("Burger", "Beef burger", 9.5));
+    menu.addMenuItem(MenuItem("Fries", "Crispy fries", 3.0));
+    Order ticket("Terminal");
+    ticket.addItem(1, menu);
+    ticket.addItem(2, menu);
+
+    cout << "producers, consumers, orders, M orders/s, check" << endl;
+    for (int producers = 1; producers <= maxThreads; producers *= 2) {
+        for (int consumers = 1; consumers <= maxThreads; consumers *= 2) {
+            ConcurrentOrdersQueue queue;
+            long total = (long)producers * ordersPerProducer;
+            vector<atomic<char> > seen(total + 1);
+            for (long i = 0; i <= total; ++i) {
+                seen[i].store(0);
+            }
+            atomic<long> consumed(0);
+            atomic<bool> duplicate(false);
+
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            vector<thread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.push_back(thread([&]() {
+                    for (int i = 0; i < ordersPerProducer; ++i) {
+                        queue.enqueue(ticket);
+                    }
+                }));
+            }
+            for (int c = 0; c < consumers; ++c) {
+                threads.push_back(thread([&]() {
+                    Order order;
+                    while (consumed.load(memory_order_relaxed) < total) {
+                        if (queue.dequeue(order)) {
+                            int id = order.getOrderId();
+                            if (id < 1 || id > total || seen[id].exchange(1) != 0) {
+                                duplicate.store(true);
+                            }
+                            consumed.fetch_add(1, memory_order_relaxed);
+                        } else {
+                            this_thread::yield();
+                        }
+                    }
+                }));
+            }
+            for (size_t t = 0; t < threads.size(); ++t) {
+                threads[t].join();
+            }
+            chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+            bool passed = !duplicate.load() && consumed.load() == total && queue.isEmpty();
+            for (long i = 1; i <= total && passed; ++i) {
+                passed = seen[i].load() == 1;  // Nothing lost.
+            }
+            allPassed = allPassed && passed;
+
+            double seconds = chrono::duration<double>(end - start).count();
+            cout << producers << ", " << consumers << ", " << total << ", "
+                 << total / seconds / 1e6 << ", " << (passed ? "ok" : "FAILED") << endl;
+        }
+    }
+    return allPassed ? 0 : 1;
+}
@@ -0,0 +1,429 @@
+// This benchmark measures every core data structure across input sizes from
+// 10 to 10M and writes the results as JSON, one result per line, so runs of
+// different versions can be kept and compared:
+//   DynamicArrayList      add, find, delete, save, load   (size = menu items)
+//   Order                 construct, copy                 (size = line items)
+//   ActiveOrdersQueue     enqueue, dequeue, deleteOrder,  (size = queued orders)
+//                         priorityDeq (priority scheduling, mixed classes)
+//   CompletedOrdersStack  push, pop, revenue, recalculate (size = stacked orders)
+// Small sizes are repeated until about two million operations have been timed,
+// so every row is measured over a comparable amount of work. Operations that
+// shift the menu array (delete) are repeated fewer times at large sizes. The
+// 10M rows need about 4 GB of memory; pass a smaller maximum size to skip them.
+//
+// Build from the repository root:
+//   make core_bench
+// Run:
+//   ./core_bench [max size] [output.json] [label]
+//   ./core_bench --compare baseline.json current.json [slowdown threshold]
+// The label is stored in the output, e.g. the output of git rev-parse --short HEAD.
+// The compare mode lists every row of both files and exits non-zero if a row got
+// slower than the threshold (default 1.5, i.e. 50% slower; single runs are noisy).
+
+//
+//  core_bench.cpp
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ActiveOrdersQueue.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+static const long long WORK = 2000000;      // Operations timed per row, at least
+static const long long FILE_WORK = 100000;  // Items saved or loaded per row, at least
+static const string MENU_FILE = "core_bench_menu.txt";
+
+// One row of the results.
+struct Result {
+    string structure;
+    string operation;
+    long long size;
+    long long ops;     // Operations timed
+    string unit;       // What one operation is
+    double nsPerOp;
+};
+
+static vector<Result> results;
+static long long sink = 0;  // Keeps the compiler from dropping the measured work
+static mt19937 rng(42);
+
+static double elapsedNs(Clock::time_point start) {
+    return chrono::duration<double, nano>(Clock::now() - start).count();
+}
+
+static void record(const char* structure, const char* operation, long long size, long long ops,
+                   const char* unit, double ns) {
+    Result result = {structure, operation, size, ops, unit, ns / ops};
+    results.push_back(result);
+    printf("%-21s %-12s %10lld %11lld %-6s %12.1f\n", structure, operation, size, ops, unit,
+           result.nsPerOp);
+    fflush(stdout);
+}
+
+static long long repsFor(long long size, long long work) {
+    return max(1LL, work / size);
+}
+
+static void fillMenu(DynamicArrayList& menu, long long size) {
+    for (long long i = 0; i < size; ++i) {
+        menu.addMenuItem(MenuItem("Dish", "Benchmark item", 1.0 + i % 50));
+    }
+}
+
+// A three-item order; the short name keeps copies free of string allocations.
+static Order sampleOrder(const DynamicArrayList& menu) {
+    const int ids[] = {1, 2, 3};
+    Order order("Guest");
+    order.addItems(ids, 3, menu);
+    return order;
+}
+
+static void benchMenu(long long size) {
+    long long reps = repsFor(size, WORK);
+    double ns = 0;
+    for (long long r = 0; r < reps; ++r) {
+        DynamicArrayList menu(10);
+        Clock::time_point start = Clock::now();
+        fillMenu(menu, size);
+        ns += elapsedNs(start);
+        sink += menu.getSize();
+    }
+    record("DynamicArrayList", "add", size, reps * size, "item", ns);
+
+    DynamicArrayList menu(10);
+    fillMenu(menu, size);
+    vector<int> ids(WORK);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = 1 + static_cast<int>(rng() % size);
+    }
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        const MenuItem* item = menu.findMenuItem(ids[i]);
+        sink += item ? item->getId() : 0;
+    }
+    record("DynamicArrayList", "find", size, ids.size(), "lookup", elapsedNs(start));
+
+    // Each delete shifts the items behind it, so large menus get few deletes.
+    long long deletes = max(1LL, min(size, WORK / size));
+    reps = max(1LL, min(WORK / 10 / deletes, WORK / size));
+    vector<int> order(size);
+    ns = 0;
+    for (long long r = 0; r < reps; ++r) {
+        DynamicArrayList victims(10);
+        fillMenu(victims, size);
+        for (long long i = 0; i < size; ++i) {
+            order[i] = static_cast<int>(i + 1);
+        }
+        shuffle(order.begin(), order.end(), rng);
+        start = Clock::now();
+        for (long long i = 0; i < deletes; ++i) {
+            sink += victims.deleteMenuItem(order[i]);
+        }
+        ns += elapsedNs(start);
+    }
+    record("DynamicArrayList", "delete", size, reps * deletes, "item", ns);
+
+    reps = repsFor(size, FILE_WORK);
+    ns = 0;
+    for (long long r = 0; r < reps; ++r) {
+        start = Clock::now();
+        sink += menu.saveMenuToFile(MENU_FILE);
+        ns += elapsedNs(start);
+    }
+    record("DynamicArrayList", "save", size, reps * size, "item", ns);
+
+    DynamicArrayList loaded(10);
+    ns = 0;
+    for (long long r = 0; r < reps; ++r) {
+        start = Clock::now();
+        sink += loaded.loadMenuFromFile(MENU_FILE);
+        ns += elapsedNs(start);
+    }
+    record("DynamicArrayList", "load", size, reps * size, "item", ns);
+    remove(MENU_FILE.c_str());
+    if (loaded.getSize() != size) {
+        fprintf(stderr, "load read %d of %lld items\n", loaded.getSize(), size);
+    }
+}
+
+static void benchOrder(long long size, const DynamicArrayList& menu) {
+    vector<int> ids(size);
+    for (long long i = 0; i < size; ++i) {
+        ids[i] = 1 + static_cast<int>(i % 100);
+    }
+    long long reps = repsFor(size, WORK);
+    Clock::time_point start = Clock::now();
+    for (long long r = 0; r < reps; ++r) {
+        Order order("Guest");
+        order.addItems(ids.data(), static_cast<int>(size), menu);
+        sink += order.getTotalCents();
+    }
+    record("Order", "construct", size, reps * size, "item", elapsedNs(start));
+
+    Order original("Guest");
+    original.addItems(ids.data(), static_cast<int>(size), menu);
+    start = Clock::now();
+    for (long long r = 0; r < reps; ++r) {
+        Order copy(original);
+        sink += copy.getItemCount();
+    }
+    record("Order", "copy", size, reps * size, "item", elapsedNs(start));
+}
+
+static void benchQueue(long long size, const DynamicArrayList& menu) {
+    Order order = sampleOrder(menu);
+    long long reps = repsFor(size, WORK);
+    double enqueueNs = 0, dequeueNs = 0;
+    Order out;
+    for (long long r = 0; r < reps; ++r) {
+        ActiveOrdersQueue queue;
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < size; ++i) {
+            sink += queue.enqueue(order);
+        }
+        enqueueNs += elapsedNs(start);
+        start = Clock::now();
+        while (queue.dequeue(out)) {
+            sink += out.getOrderId();
+        }
+        dequeueNs += elapsedNs(start);
+    }
+    record("ActiveOrdersQueue", "enqueue", size, reps * size, "order", enqueueNs);
+    record("ActiveOrdersQueue", "dequeue", size, reps * size, "order", dequeueNs);
+
+    // Cancel every order in random order, so most come from the middle of the queue.
+    vector<int> ids(size);
+    double ns = 0;
+    for (long long r = 0; r < reps; ++r) {
+        ActiveOrdersQueue queue;
+        for (long long i = 0; i < size; ++i) {
+            ids[i] = queue.enqueue(order);
+        }
+        shuffle(ids.begin(), ids.end(), rng);
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < size; ++i) {
+            sink += queue.deleteOrder(ids[i]);
+        }
+        ns += elapsedNs(start);
+    }
+    record("ActiveOrdersQueue", "deleteOrder", size, reps * size, "order", ns);
+
+    // Priority scheduling with every class queued, so dequeue compares the level fronts.
+    Order classes[PRIORITY_LEVELS];
+    for (int p = 0; p < PRIORITY_LEVELS; ++p) {
+        classes[p] = order;
+        classes[p].setPriority(static_cast<OrderPriority>(p));
+    }
+    ns = 0;
+    for (long long r = 0; r < reps; ++r) {
+        ActiveOrdersQueue queue;
+        queue.setSchedulingMode(SCHEDULE_PRIORITY);
+        for (long long i = 0; i < size; ++i) {
+            queue.enqueue(classes[i % PRIORITY_LEVELS]);
+        }
+        Clock::time_point start = Clock::now();
+        while (queue.dequeue(out)) {
+            sink += out.getOrderId();
+        }
+        ns += elapsedNs(start);
+    }
+    record("ActiveOrdersQueue", "priorityDeq", size, reps * size, "order", ns);
+}
+
+static void benchStack(long long size, const DynamicArrayList& menu) {
+    Order order = sampleOrder(menu);
+    order.setStatus("completed");
+    long long reps = repsFor(size, WORK);
+    double pushNs = 0, popNs = 0;
+    for (long long r = 0; r < reps; ++r) {
+        CompletedOrdersStack stack;
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < size; ++i) {
+            stack.push(order);
+        }
+        pushNs += elapsedNs(start);
+        start = Clock::now();
+        while (!stack.isEmpty()) {
+            sink += stack.pop().getItemCount();
+        }
+        popNs += elapsedNs(start);
+    }
+    record("CompletedOrdersStack", "push", size, reps * size, "order", pushNs);
+    record("CompletedOrdersStack", "pop", size, reps * size, "order", popNs);
+
+    CompletedOrdersStack stack;
+    for (long long i = 0; i < size; ++i) {
+        stack.push(order);
+    }
+    Clock::time_point start = Clock::now();
+    for (long long r = 0; r < WORK; ++r) {
+        sink += static_cast<long long>(stack.calculateTotalRevenue());
+    }
+    record("CompletedOrdersStack", "revenue", size, WORK, "call", elapsedNs(start));
+
+    start = Clock::now();
+    for (long long r = 0; r < reps; ++r) {
+        sink += stack.recalculateTotalRevenueCents();
+    }
+    record("CompletedOrdersStack", "recalculate", size, reps * size, "order", elapsedNs(start));
+    if (stack.recalculateTotalRevenueCents() != stack.getTotalRevenueCents()) {
+        fprintf(stderr, "running revenue does not match the recalculated revenue\n");
+    }
+}
+
+static string jsonEscape(const string& text) {
+    string escaped;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '"' || text[i] == '\\') {
+            escaped += '\\';
+        }
+        escaped += text[i];
+    }
+    return escaped;
+}
+
+static bool writeJson(const string& fileName, const string& label, long long maxSize) {
+    ofstream file(fileName.c_str());
+    if (!file.is_open()) {
+        return false;
+    }
+    char stamp[32];
+    time_t now = time(NULL);
+    strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    file << "{\n"
+         << "  \"benchmark\": \"core_bench\",\n"
+         << "  \"label\": \"" << jsonEscape(label) << "\",\n"
+         << "  \"timestamp\": \"" << stamp << "\",\n"
+         << "  \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n"
+         << "  \"max_size\": " << maxSize << ",\n"
+         << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        char ns[32];
+        snprintf(ns, sizeof(ns), "%.3f", r.nsPerOp);
+        file << "    {\"structure\": \"" << r.structure << "\", \"operation\": \"" << r.operation
+             << "\", \"size\": " << r.size << ", \"ops\": " << r.ops << ", \"unit\": \"" << r.unit
+             << "\", \"ns_per_op\": " << ns << "}" << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    file << "  ]\n}\n";
+    return file.good();
+}
+
+// Reads the value of "key": from a result line written by writeJson.
+static string field(const string& line, const string& key) {
+    size_t at = line.find("\"" + key + "\": ");
+    if (at == string::npos) {
+        return "";
+    }
+    at += key.size() + 4;
+    if (line[at] == '"') {
+        return line.substr(at + 1, line.find('"', at + 1) - at - 1);
+    }
+    return line.substr(at, line.find_first_of(",}", at) - at);
+}
+
+// Reads the rows of a results file, keyed by structure, operation and size.
+static bool readJson(const string& fileName, map<string, double>& rows, string& label) {
+    ifstream file(fileName.c_str());
+    if (!file.is_open()) {
+        fprintf(stderr, "cannot read %s\n", fileName.c_str());
+        return false;
+    }
+    string line;
+    while (getline(file, line)) {
+        if (line.find("\"label\": ") != string::npos) {
+            label = field(line, "label");
+        } else if (line.find("\"structure\": ") != string::npos) {
+            char key[128];
+            snprintf(key, sizeof(key), "%-21s %-12s %10s", field(line, "structure").c_str(),
+                     field(line, "operation").c_str(), field(line, "size").c_str());
+            rows[key] = atof(field(line, "ns_per_op").c_str());
+        }
+    }
+    return true;
+}
+
+static int compare(const string& baseFile, const string& currentFile, double threshold) {
+    map<string, double> base, current;
+    string baseLabel, currentLabel;
+    if (!readJson(baseFile, base, baseLabel) || !readJson(currentFile, current, currentLabel)) {
+        return 2;
+    }
+    printf("baseline: %s   current: %s   threshold: %.2fx\n", baseLabel.c_str(),
+           currentLabel.c_str(), threshold);
+    printf("%-21s %-12s %10s %12s %12s %8s\n", "structure", "operation", "size", "base ns/op",
+           "ns/op", "ratio");
+    int slower = 0;
+    for (map<string, double>::const_iterator it = current.begin(); it != current.end(); ++it) {
+        map<string, double>::const_iterator old = base.find(it->first);
+        if (old == base.end() || old->second <= 0) {
+            printf("%s %12s %12.1f %8s\n", it->first.c_str(), "-", it->second, "new");
+            continue;
+        }
+        double ratio = it->second / old->second;
+        bool regressed = ratio > threshold;
+        slower += regressed;
+        printf("%s %12.1f %12.1f %7.2fx%s\n", it->first.c_str(), old->second, it->second, ratio,
+               regressed ? "  SLOWER" : "");
+    }
+    printf("%d of %zu rows slower than %.2fx\n", slower, current.size(), threshold);
+    return slower == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--compare") == 0) {
+        if (argc < 4) {
+            fprintf(stderr, "usage: core_bench --compare baseline.json current.json [threshold]\n");
+            return 2;
+        }
+        return compare(argv[2], argv[3], argc > 4 ? atof(argv[4]) : 1.5);
+    }
+
+    long long maxSize = argc > 1 ? atoll(argv[1]) : 10000000;
+    string outFile = argc > 2 ? argv[2] : "core_bench.json";
+    string label = argc > 3 ? argv[3] : "unlabelled";
+    if (maxSize < 10 || maxSize > 2000000000) {
+        fprintf(stderr, "max size must be between 10 and 2000000000\n");
+        return 1;
+    }
+
+    ostringstream quiet;
+    streambuf* console = cout.rdbuf(quiet.rdbuf());  // saveMenuToFile reports every save
+
+    DynamicArrayList menu(100);
+    fillMenu(menu, 100);
+    printf("%-21s %-12s %10s %11s %-6s %12s\n", "structure", "operation", "size", "ops", "unit",
+           "ns/op");
+    for (long long size = 10; size <= maxSize; size *= 10) {
+        benchMenu(size);
+        benchOrder(size, menu);
+        benchQueue(size, menu);
+        benchStack(size, menu);
+        quiet.str("");
+    }
+    cout.rdbuf(console);
+
+    if (!writeJson(outFile, label, maxSize)) {
+        fprintf(stderr, "cannot write %s\n", outFile.c_str());
+        return 1;
+    }
+    printf("%zu results written to %s (checksum %lld)\n", results.size(), outFile.c_str(), sink);
+    return 0;
+}
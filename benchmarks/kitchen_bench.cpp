@@ -0,0 +1,70 @@
+// This benchmark feeds orders into a ConcurrentOrdersQueue from POS terminal
+// threads while a KitchenWorkerPool drains it, for several worker counts. It
+// reports kitchen throughput and queue-wait latency, then shuts the pool down
+// and checks that every order ended up on the completed stack.
+//
+// Build from the repository root:
+//   make kitchen_bench
+// Run:
+//   ./kitchen_bench [orders] [prep micros per item]
+
+//
+//  kitchen_bench.cpp
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "CompletedOrdersStack.h"
+#include "ConcurrentOrdersQueue.h"
+#include "DynamicArrayList.h"
+#include "KitchenWorkerPool.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int orderCount = argc > 1 ? atoi(argv[1]) : 20000;
+    int prepMicros = argc > 2 ? atoi(argv[2]) : 20;
+    const int terminals = 2;
+    const int workerCounts[] = {1, 2, 4, 8};
+    bool allPassed = true;
+
+    DynamicArrayList menu(10);
+    menu.addMenuItem(MenuItem("Burger", "Beef burger", 9.5));
+    menu.addMenuItem(MenuItem("Fries", "Crispy fries", 3.0));
+    Order ticket("Terminal");
+    ticket.addItem(1, menu);
+    ticket.addItem(2, menu);
+
+    cout << "workers, orders/s, avg wait us, max wait us, completed" << endl;
+    for (int w = 0; w < 4; ++w) {
+        ConcurrentOrdersQueue active;
+        CompletedOrdersStack completed;
+        KitchenWorkerPool kitchen(active, completed, workerCounts[w], prepMicros);
+        kitchen.start();
+
+        vector<thread> pos;
+        for (int t = 0; t < terminals; ++t) {
+            pos.push_back(thread([&]() {
+                for (int i = 0; i < orderCount / terminals; ++i) {
+                    active.enqueue(ticket);
+                }
+            }));
+        }
+        for (size_t t = 0; t < pos.size(); ++t) {
+            pos[t].join();
+        }
+        kitchen.shutdown();  // Drains whatever is still queued
+
+        KitchenStats stats = kitchen.getStats();
+        bool passed = completed.getSize() == (orderCount / terminals) * terminals && active.isEmpty();
+        allPassed = allPassed && passed;
+        cout << workerCounts[w] << ", " << stats.ordersPerSecond << ", " << stats.averageWaitMicros
+             << ", " << stats.maxWaitMicros << ", " << completed.getSize()
+             << (passed ? "" : " FAILED") << endl;
+    }
+    return allPassed ? 0 : 1;
+}
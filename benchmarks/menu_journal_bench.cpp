@@ -0,0 +1,127 @@
+// This benchmark measures the cost of persisting one menu edit. For menus of
+// 1k, 10k and 100k items it times price changes saved by rewriting the whole
+// file with saveMenuToFile (the old behaviour) against the same changes
+// appended to a MenuJournal. It then recovers a second menu from the snapshot
+// and journal and checks that it matches the edited menu. Finally it resets
+// the menu while a compaction is running and checks that it reloads empty.
+//
+// Build from the repository root:
+//   make menu_journal_bench
+// Run:
+//   ./menu_journal_bench [edits]
+
+//
+//  menu_journal_bench.cpp
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "MenuJournal.h"
+
+using namespace std;
+
+static const string SNAPSHOT = "menu_journal_bench.txt";
+
+// Removes the snapshot and all journal files.
+static void cleanUp() {
+    remove(SNAPSHOT.c_str());
+    remove((SNAPSHOT + ".journal").c_str());
+    remove((SNAPSHOT + ".journal.compacting").c_str());
+    remove((SNAPSHOT + ".tmp").c_str());
+}
+
+// Times edits at one menu size; returns false if recovery does not match.
+static bool runSize(int items, int edits) {
+    cleanUp();
+    DynamicArrayList menu(items);
+    for (int i = 1; i <= items; ++i) {
+        menu.addMenuItem(MenuItem("Item " + to_string(i), "House special with seasonal sides", 5 + i % 40));
+    }
+    ostringstream discard;  // saveMenuToFile reports every save on cout
+    streambuf* console = cout.rdbuf(discard.rdbuf());
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for (int e = 0; e < edits; ++e) {
+        menu.updateMenuItemPrice(1 + (e * 7919) % items, 10 + e % 7);
+        menu.saveMenuToFile(SNAPSHOT);
+        discard.str("");
+    }
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    cout.rdbuf(console);
+
+    bool same = true;
+    {
+        MenuJournal journal(menu, SNAPSHOT, edits * 2);  // No compaction during the timed loop
+        journal.recover();
+        chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+        for (int e = 0; e < edits; ++e) {
+            int id = 1 + (e * 104729) % items;
+            double price = 20 + e % 11;
+            menu.updateMenuItemPrice(id, price);
+            journal.recordPriceChange(id, price);
+        }
+        chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+
+        DynamicArrayList recovered(10);
+        MenuJournal reader(recovered, SNAPSHOT);
+        reader.recover();
+        same = recovered.getSize() == menu.getSize();
+        for (int id = 1; same && id <= items; ++id) {
+            same = recovered.findMenuItem(id) && menu.findMenuItem(id)
+                   && recovered.findMenuItem(id)->getPrice() == menu.findMenuItem(id)->getPrice();
+        }
+
+        double rewrite = chrono::duration<double, micro>(t1 - t0).count() / edits;
+        double append = chrono::duration<double, micro>(t3 - t2).count() / edits;
+        cout << "items: " << items
+             << "  full rewrite: " << rewrite << " us/edit"
+             << "  journal append: " << append << " us/edit"
+             << "  recovered menu matches: " << (same ? "yes" : "NO") << endl;
+    }
+    cleanUp();
+    return same;
+}
+
+// Resets the menu while a compaction is writing the old one; returns false if it comes back.
+static bool resetDuringCompaction(int items) {
+    cleanUp();
+    DynamicArrayList menu(items);
+    MenuJournal journal(menu, SNAPSHOT, items + 1);  // Only the compaction started below
+    journal.recover();
+    for (int i = 1; i <= items; ++i) {
+        journal.recordAdd(*menu.findMenuItem(menu.addMenuItem(MenuItem("Item " + to_string(i), "Old menu", 9))));
+    }
+    journal.compact();  // Still writing the full menu when reset runs
+    ostringstream discard;  // resetMenu reports the reset on cout
+    streambuf* console = cout.rdbuf(discard.rdbuf());
+    bool cleared = journal.reset();
+    cout.rdbuf(console);
+    journal.waitForCompaction();
+
+    DynamicArrayList recovered(10);
+    MenuJournal reader(recovered, SNAPSHOT);
+    reader.recover();
+    bool empty = cleared && menu.getSize() == 0 && recovered.getSize() == 0;
+    cout << "reset during a compaction of " << items << " items, menu reloads empty: "
+         << (empty ? "yes" : "NO") << endl;
+    cleanUp();
+    return empty;
+}
+
+int main(int argc, char* argv[]) {
+    int edits = argc > 1 ? atoi(argv[1]) : 200;
+    if (edits < 1) {
+        edits = 1;
+    }
+    bool ok = true;
+    ok = runSize(1000, edits) && ok;
+    ok = runSize(10000, edits) && ok;
+    ok = runSize(100000, edits) && ok;
+    ok = resetDuringCompaction(100000) && ok;
+    return ok ? 0 : 1;
+}
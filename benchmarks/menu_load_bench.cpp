@@ -0,0 +1,84 @@
+// This benchmark writes a menu file with many rows (1M by default) and times
+// DynamicArrayList::loadMenuFromFile on it. For comparison it also times a
+// reference loader that reads the same file with ifstream >> and getline and
+// adds items one by one, the way the menu used to be loaded. It checks that
+// both loaders end up with the same menu.
+//
+// Build from the repository root:
+//   make menu_load_bench
+// Run:
+//   ./menu_load_bench [rows] [file]
+
+//
+//  menu_load_bench.cpp
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+
+using namespace std;
+
+// Reads the menu the way loadMenuFromFile used to: stream extraction per field.
+static bool streamLoad(const string& fileName, DynamicArrayList& menu) {
+    ifstream file(fileName.c_str());
+    if (!file.is_open()) {
+        return false;
+    }
+    int id;
+    string name, description;
+    double price;
+    while (file >> id) {
+        file.ignore();
+        getline(file, name, ',');
+        getline(file, description, ',');
+        file >> price;
+        file.ignore();
+        menu.addMenuItem(MenuItem(name, description, price));
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int rows = argc > 1 ? atoi(argv[1]) : 1000000;
+    string fileName = argc > 2 ? argv[2] : "menu_load_bench.txt";
+
+    {
+        ofstream out(fileName.c_str());
+        for (int i = 1; i <= rows; ++i) {
+            out << i << ",Item " << i << ",House special number " << i
+                << " with seasonal sides," << (5 + i % 40) << "." << (i % 100) << '\n';
+        }
+    }
+
+    DynamicArrayList mapped(10);
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    bool loaded = mapped.loadMenuFromFile(fileName);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    DynamicArrayList streamed(10);
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+    streamLoad(fileName, streamed);
+    chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+
+    bool same = loaded && mapped.getSize() == streamed.getSize();
+    for (int id = 1; same && id <= rows; id += 997) {
+        const MenuItem* a = mapped.findMenuItem(id);
+        const MenuItem* b = streamed.findMenuItem(id);
+        same = a && b && a->getName() == b->getName() && a->getDesc() == b->getDesc()
+               && a->getPrice() == b->getPrice();
+    }
+
+    cout << "rows: " << rows << endl;
+    cout << "loadMenuFromFile (mmap): " << chrono::duration<double, milli>(t1 - t0).count() << " ms" << endl;
+    cout << "stream reference:        " << chrono::duration<double, milli>(t3 - t2).count() << " ms" << endl;
+    cout << "menus match: " << (same ? "yes" : "NO") << endl;
+
+    remove(fileName.c_str());
+    return same ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+// This benchmark measures DynamicArrayList::findMenuItem as the menu grows.
+// With the ID index the time per lookup should stay flat from a few hundred
+// items up to a million.
+//
+// Build from the repository root:
+//   make menu_lookup_bench
+
+//
+//  menu_lookup_bench.cpp
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+
+using namespace std;
+
+int main() {
+    const int sizes[] = {100, 1000, 10000, 100000, 1000000};
+    const int lookups = 1000000;
+
+    cout << "menu size, ns per lookup" << endl;
+    for (int s = 0; s < 5; ++s) {
+        int menuSize = sizes[s];
+        DynamicArrayList menu(10);
+        for (int i = 0; i < menuSize; ++i) {
+            menu.addMenuItem(MenuItem("Item", "Benchmark item", 1.0 + i % 50));
+        }
+
+        // Pre-generate the IDs so that rand() is not part of the timing.
+        int* ids = new int[lookups];
+        srand(42);
+        for (int i = 0; i < lookups; ++i) {
+            ids[i] = 1 + rand() % menuSize;
+        }
+
+        double checksum = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < lookups; ++i) {
+            MenuItem* item = menu.findMenuItem(ids[i]);
+            if (item) {
+                checksum += item->getPrice();
+            }
+        }
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+        delete[] ids;
+
+        double ns = chrono::duration<double, nano>(end - start).count() / lookups;
+        cout << menuSize << ", " << ns << "   (checksum " << checksum << ")" << endl;
+    }
+    return 0;
+}
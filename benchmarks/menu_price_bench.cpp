@@ -0,0 +1,206 @@
+// This benchmark checks and times the price queries of DynamicArrayList
+// (findItemsByPrice, findCheapestItems, findPriciestItems) on a large
+// generated menu (100k items by default, priced $3 to $60 in quarter-dollar
+// steps, so many items share a price). Each query is compared with a linear
+// scan over a contiguous copy of the items that filters, then sorts, as the
+// menu would have to do without the index; both are timed. It then changes
+// prices and stations, deletes and adds items, and checks the incrementally
+// updated index against the scan and against a freshly built one. The program
+// exits with a non-zero status if any result differs.
+//
+// Build from the repository root:
+//   make menu_price_bench
+// Run:
+//   ./menu_price_bench [items]
+
+//
+//  menu_price_bench.cpp
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "MenuPriceIndex.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+enum QueryKind { QUERY_RANGE, QUERY_CHEAPEST, QUERY_PRICIEST };
+
+struct Query {
+    const char* label;
+    QueryKind kind;
+    double minPrice, maxPrice;  // QUERY_RANGE
+    int count;                  // QUERY_CHEAPEST, QUERY_PRICIEST
+    PrepStation station;        // STATION_COUNT for the whole menu
+};
+
+// Answers a query through the menu's price index
+static int runIndexed(DynamicArrayList& menu, const Query& q, vector<int>& ids) {
+    if (q.kind == QUERY_RANGE) {
+        return menu.findItemsByPrice(q.minPrice, q.maxPrice, ids, q.station);
+    }
+    return q.kind == QUERY_CHEAPEST ? menu.findCheapestItems(q.count, ids, q.station)
+                                    : menu.findPriciestItems(q.count, ids, q.station);
+}
+
+// Answers a query by scanning every item; same order as the index
+static int runScan(const vector<MenuItem>& items, const Query& q, vector<int>& ids) {
+    vector<pair<long long, int> > hits;  // (cents, id); cents negated for priciest
+    long long minCents = MenuPriceIndex::toCents(q.minPrice), maxCents = MenuPriceIndex::toCents(q.maxPrice);
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (q.station != STATION_COUNT && items[i].getStation() != q.station) {
+            continue;
+        }
+        long long cents = MenuPriceIndex::toCents(items[i].getPrice());
+        if (q.kind == QUERY_RANGE && (cents < minCents || cents > maxCents)) {
+            continue;
+        }
+        hits.push_back(make_pair(q.kind == QUERY_PRICIEST ? -cents : cents, items[i].getId()));
+    }
+    size_t keep = q.kind == QUERY_RANGE ? hits.size() : min(hits.size(), static_cast<size_t>(q.count));
+    partial_sort(hits.begin(), hits.begin() + keep, hits.end());
+    ids.clear();
+    for (size_t i = 0; i < keep; ++i) {
+        ids.push_back(hits[i].second);
+    }
+    return static_cast<int>(ids.size());
+}
+
+// Copies the live items into one contiguous array for the scan
+static vector<MenuItem> copyItems(const DynamicArrayList& menu, const vector<int>& liveIds) {
+    vector<MenuItem> items;
+    items.reserve(liveIds.size());
+    for (size_t i = 0; i < liveIds.size(); ++i) {
+        items.push_back(*menu.findMenuItem(liveIds[i]));
+    }
+    return items;
+}
+
+// Mean microseconds per call of f, repeated for at least 20 ms
+template <typename F>
+static double timeMicros(F f) {
+    int reps = 0;
+    double elapsed = 0;
+    Clock::time_point start = Clock::now();
+    while (elapsed < 0.02 || reps < 3) {
+        f();
+        reps++;
+        elapsed = chrono::duration<double>(Clock::now() - start).count();
+    }
+    return elapsed * 1e6 / reps;
+}
+
+// Runs every query through the index and the scan; prints one line each if timed
+static bool checkQueries(DynamicArrayList& menu, const vector<int>& liveIds, const Query queries[],
+                         int queryCount, bool timed) {
+    vector<MenuItem> items = copyItems(menu, liveIds);
+    bool ok = true;
+    vector<int> found, expected;
+    for (int q = 0; q < queryCount; ++q) {
+        int count = runIndexed(menu, queries[q], found);
+        runScan(items, queries[q], expected);
+        bool same = count == static_cast<int>(found.size()) && found == expected;
+        ok = ok && same;
+        if (!timed) {
+            continue;
+        }
+        double indexUs = timeMicros([&]() { runIndexed(menu, queries[q], found); });
+        double scanUs = timeMicros([&]() { runScan(items, queries[q], expected); });
+        printf("%-30s %8d %12.2f %12.1f %9.0fx  %s\n", queries[q].label, count, indexUs, scanUs,
+               scanUs / indexUs, same ? "ok" : "MISMATCH");
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    int itemCount = argc > 1 ? atoi(argv[1]) : 100000;
+    if (itemCount < 100) {
+        itemCount = 100;
+    }
+
+    mt19937 rng(25);
+    uniform_int_distribution<int> quarters(12, 240);  // $3.00 to $60.00
+    uniform_int_distribution<int> stations(0, STATION_COUNT - 1);
+    DynamicArrayList menu(itemCount);
+    vector<int> liveIds;
+    for (int i = 0; i < itemCount; ++i) {
+        liveIds.push_back(menu.addMenuItem(MenuItem("Dish " + to_string(i + 1), "Benchmark item",
+                                                    quarters(rng) * 0.25,
+                                                    static_cast<PrepStation>(stations(rng)))));
+    }
+
+    const Query queries[] = {
+        {"range $8-$12", QUERY_RANGE, 8, 12, 0, STATION_COUNT},
+        {"range $8-$12 cold", QUERY_RANGE, 8, 12, 0, STATION_COLD},
+        {"range $20.00-$20.25", QUERY_RANGE, 20, 20.25, 0, STATION_COUNT},
+        {"range $59.99-$60.01 bar", QUERY_RANGE, 59.99, 60.01, 0, STATION_BAR},
+        {"range $70-$80 (empty)", QUERY_RANGE, 70, 80, 0, STATION_COUNT},
+        {"range $0-$100 (everything)", QUERY_RANGE, 0, 100, 0, STATION_COUNT},
+        {"20 cheapest", QUERY_CHEAPEST, 0, 0, 20, STATION_COUNT},
+        {"20 cheapest cold", QUERY_CHEAPEST, 0, 0, 20, STATION_COLD},
+        {"20 priciest", QUERY_PRICIEST, 0, 0, 20, STATION_COUNT},
+        {"20 priciest grill", QUERY_PRICIEST, 0, 0, 20, STATION_GRILL},
+        {"1000 priciest", QUERY_PRICIEST, 0, 0, 1000, STATION_COUNT},
+    };
+    const int queryCount = sizeof(queries) / sizeof(queries[0]);
+
+    vector<int> found;
+    Clock::time_point start = Clock::now();
+    menu.findCheapestItems(1, found);  // Builds the index
+    double buildMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    printf("%d items, price index built by the first query in %.1f ms\n\n", itemCount, buildMs);
+
+    printf("%-30s %8s %12s %12s %10s\n", "query", "items", "index us", "scan us", "speedup");
+    bool ok = checkQueries(menu, liveIds, queries, queryCount, true);
+
+    // Incremental updates: price and station changes, deletes and adds, then check again
+    int changes = itemCount / 10;
+    start = Clock::now();
+    for (int i = 0; i < changes; ++i) {
+        menu.updateMenuItemPrice(liveIds[rng() % liveIds.size()], quarters(rng) * 0.25);
+    }
+    double priceUs = chrono::duration<double, micro>(Clock::now() - start).count() / changes;
+    for (int i = 0; i < changes / 2; ++i) {
+        menu.updateMenuItemStation(liveIds[rng() % liveIds.size()], static_cast<PrepStation>(stations(rng)));
+    }
+    shuffle(liveIds.begin(), liveIds.end(), rng);
+    int deletes = itemCount / 50;  // Deleting shifts the array, so keep this part short
+    for (int i = 0; i < deletes; ++i) {
+        menu.deleteMenuItem(liveIds.back());
+        liveIds.pop_back();
+    }
+    int adds = itemCount / 10;
+    start = Clock::now();
+    for (int i = 0; i < adds; ++i) {
+        liveIds.push_back(menu.addMenuItem(MenuItem("Special " + to_string(i), "Added later",
+                                                    quarters(rng) * 0.25,
+                                                    static_cast<PrepStation>(stations(rng)))));
+    }
+    double addUs = chrono::duration<double, micro>(Clock::now() - start).count() / adds;
+    bool updatedOk = checkQueries(menu, liveIds, queries, queryCount, false);
+
+    // A copy starts without an index and builds its own on the first query
+    DynamicArrayList rebuilt(menu);
+    bool rebuiltOk = true;
+    vector<int> fresh;
+    for (int q = 0; q < queryCount; ++q) {
+        runIndexed(menu, queries[q], found);
+        runIndexed(rebuilt, queries[q], fresh);
+        rebuiltOk = rebuiltOk && found == fresh;
+    }
+    printf("\n%d price changes (%.2f us each), %d station changes, %d deletes, %d adds (%.2f us each)\n",
+           changes, priceUs, changes / 2, deletes, adds, addUs);
+    printf("incrementally updated index matches the scan: %s, matches a rebuilt index: %s\n",
+           updatedOk ? "yes" : "NO", rebuiltOk ? "yes" : "NO");
+    ok = ok && updatedOk && rebuiltOk;
+    printf("\nprice queries %s\n", ok ? "match the full scan" : "DO NOT MATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+// This benchmark checks and times DynamicArrayList::searchMenu on a large
+// generated menu (100k items by default). Names and descriptions are built
+// from word lists, so queries range from word prefixes that match a third of
+// the menu to substrings that match a handful of items. For each query it
+// compares the ranked results with a full scan that folds and ranks every
+// item, then times both. It deletes and adds items after the index is built
+// and checks the incrementally updated index against the scan and against a
+// freshly built one. The program exits with a non-zero status if any result
+// differs.
+//
+// Build from the repository root:
+//   make menu_search_bench
+// Run:
+//   ./menu_search_bench [items]
+
+//
+//  menu_search_bench.cpp
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "MenuSearchIndex.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+static const char* const STYLES[] = {"Grilled", "Crispy", "Smoked", "Roast", "Spicy", "Braised",
+                                     "Pan-Fried", "Steamed", "Garlic", "Lemon", "Honey", "Chili"};
+static const char* const DISHES[] = {"Chicken", "Salmon", "Tofu", "Pork Belly", "Lamb", "Prawns",
+                                     "Duck", "Beef Brisket", "Cauliflower", "Halloumi", "Squid", "Eggplant"};
+static const char* const SIDES[] = {"Rice", "Fries", "Salad", "Noodles", "Flatbread", "Polenta"};
+static const char* const EXTRAS[] = {"parmesan", "pickled onion", "toasted sesame", "crème fraîche",
+                                     "chimichurri", "smoked paprika", "fresh herbs", "house dressing"};
+
+// Ranks an item the way the index does, from scratch; -1 if it does not match.
+static int scanRank(const MenuItem& item, const string& core, bool wordsOnly) {
+    string name = MenuSearchIndex::fold(item.getName());
+    string text = name + '\n' + MenuSearchIndex::fold(item.getDesc());
+    int best = -1;
+    for (size_t at = text.find(core); at != string::npos; at = text.find(core, at + 1)) {
+        bool wordStart = text[at - 1] == ' ';
+        if (wordsOnly && !wordStart) {
+            continue;
+        }
+        int rank = at < name.size()
+                   ? (at == 1 && name.size() == core.size() + 1 ? 0 : at == 1 ? 1 : wordStart ? 2 : 3)
+                   : (wordStart ? 4 : 5);
+        best = best < 0 ? rank : min(best, rank);
+    }
+    return best;
+}
+
+// Searches by folding and ranking every item; same results as searchMenu.
+static int scanSearch(const DynamicArrayList& menu, const vector<int>& liveIds, const string& query,
+                      vector<int>& ids, int limit) {
+    ids.clear();
+    string folded = MenuSearchIndex::fold(query);
+    if (folded.size() <= 1) {
+        return 0;
+    }
+    string core = folded.substr(1);
+    vector<pair<pair<int, int>, int> > matches;  // ((rank, name length), id)
+    for (size_t i = 0; i < liveIds.size(); ++i) {
+        const MenuItem* item = menu.findMenuItem(liveIds[i]);
+        int rank = scanRank(*item, core, core.size() < 3);
+        if (rank >= 0) {
+            int nameLength = static_cast<int>(MenuSearchIndex::fold(item->getName()).size());
+            matches.push_back(make_pair(make_pair(rank, nameLength), liveIds[i]));
+        }
+    }
+    sort(matches.begin(), matches.end());
+    for (size_t i = 0; i < matches.size() && static_cast<int>(i) < limit; ++i) {
+        ids.push_back(matches[i].second);
+    }
+    return static_cast<int>(matches.size());
+}
+
+// Runs every query through the index and the scan; prints one line each.
+static bool checkQueries(DynamicArrayList& menu, const vector<int>& liveIds, const char* const queries[],
+                         int queryCount, bool timed) {
+    bool ok = true;
+    vector<int> found, expected;
+    for (int q = 0; q < queryCount; ++q) {
+        int matches = menu.searchMenu(queries[q], found, 20);
+        int scanned = scanSearch(menu, liveIds, queries[q], expected, 20);
+        bool same = matches == scanned && found == expected;
+        ok = ok && same;
+        if (!timed) {
+            continue;
+        }
+
+        int reps = 0;
+        Clock::time_point start = Clock::now();
+        double elapsed = 0;
+        while (elapsed < 0.05 || reps < 5) {  // At least 50 ms of searching
+            menu.searchMenu(queries[q], found, 20);
+            reps++;
+            elapsed = chrono::duration<double>(Clock::now() - start).count();
+        }
+        double indexUs = elapsed * 1e6 / reps;
+        start = Clock::now();
+        scanSearch(menu, liveIds, queries[q], expected, 20);
+        double scanUs = chrono::duration<double, micro>(Clock::now() - start).count();
+        const MenuItem* top = found.empty() ? NULL : menu.findMenuItem(found[0]);
+        printf("%-16s %8d %12.1f %12.0f   %-28s %s\n", (string("\"") + queries[q] + "\"").c_str(),
+               matches, indexUs, scanUs, top ? top->getName().substr(0, 28).c_str() : "-",
+               same ? "ok" : "MISMATCH");
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    int itemCount = argc > 1 ? atoi(argv[1]) : 100000;
+    if (itemCount < 100) {
+        itemCount = 100;
+    }
+
+    mt19937 rng(5);
+    DynamicArrayList menu(itemCount);
+    vector<int> liveIds;
+    for (int i = 0; i < itemCount; ++i) {
+        string name = string(STYLES[rng() % 12]) + " " + DISHES[rng() % 12];
+        if (rng() % 3 == 0) {
+            name += " with " + string(SIDES[rng() % 6]);
+        }
+        name += " No. " + to_string(i + 1);  // Unique names, like a real catalogue
+        string desc = string("Served with ") + EXTRAS[rng() % 8] + " and " + EXTRAS[rng() % 8];
+        liveIds.push_back(menu.addMenuItem(MenuItem(name, desc, 5 + rng() % 30)));
+    }
+
+    const char* const queries[] = {"c", "sa", "chicken", "Pork Belly", "rmes", "crème",
+                                   "chili prawns", "no. 4217", "smoked paprika", "halloumi with poll",
+                                   "zzz"};
+    const int queryCount = sizeof(queries) / sizeof(queries[0]);
+
+    vector<int> found;
+    Clock::time_point start = Clock::now();
+    menu.searchMenu("warm up", found);  // Builds the index
+    double buildMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    printf("%d items, index built by the first search in %.1f ms\n\n", itemCount, buildMs);
+
+    printf("%-16s %8s %12s %12s   %-28s\n", "query", "matches", "index us", "scan us", "best match");
+    bool ok = checkQueries(menu, liveIds, queries, queryCount, true);
+
+    // Incremental updates: delete a third of the items, add new ones, check again
+    shuffle(liveIds.begin(), liveIds.end(), rng);
+    int deletes = itemCount / 3;
+    start = Clock::now();
+    for (int i = 0; i < deletes; ++i) {
+        menu.deleteMenuItem(liveIds.back());
+        liveIds.pop_back();
+    }
+    double deleteUs = chrono::duration<double, micro>(Clock::now() - start).count() / deletes;
+    int adds = itemCount / 10;
+    start = Clock::now();
+    for (int i = 0; i < adds; ++i) {
+        liveIds.push_back(menu.addMenuItem(MenuItem("Smoked Chicken Special " + to_string(i),
+                                                    "Served with crème fraîche", 12)));
+    }
+    double addUs = chrono::duration<double, micro>(Clock::now() - start).count() / adds;
+    sort(liveIds.begin(), liveIds.end());
+    bool updatedOk = checkQueries(menu, liveIds, queries, queryCount, false);
+
+    // A copy starts without an index and builds its own on the first search
+    DynamicArrayList rebuilt(menu);
+    bool rebuiltOk = true;
+    vector<int> fresh;
+    for (int q = 0; q < queryCount; ++q) {
+        int a = menu.searchMenu(queries[q], found, 50);
+        int b = rebuilt.searchMenu(queries[q], fresh, 50);
+        rebuiltOk = rebuiltOk && a == b && found == fresh;
+    }
+    printf("\n%d deletes and %d adds (menu delete shifts the array; add %.1f us each, delete %.1f us each)\n",
+           deletes, adds, addUs, deleteUs);
+    printf("incrementally updated index matches the scan: %s, matches a rebuilt index: %s\n",
+           updatedOk ? "yes" : "NO", rebuiltOk ? "yes" : "NO");
+    ok = ok && updatedOk && rebuiltOk;
+    printf("\nsearch results %s\n", ok ? "match the full scan" : "DO NOT MATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+// This benchmark checks the operation statistics layer. It first records a
+// million synthetic latencies spread over six orders of magnitude and checks
+// that the percentiles read from the histogram are within one bucket (1/16)
+// of the exact ones. It then times the hottest instrumented calls - menu
+// lookups and an enqueue/dequeue pair - taking the best of several rounds.
+// It is built twice to see what the instrumentation costs: the _off build
+// compiles it out with RMS_NO_STATS.
+//
+// Build from the repository root:
+//   make operation_stats_bench operation_stats_bench_off
+// Run:
+//   ./operation_stats_bench && ./operation_stats_bench_off
+
+//
+//  operation_stats_bench.cpp
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "ActiveOrdersQueue.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "OperationStats.h"
+#include "Order.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// Records log-normal latencies and compares the histogram percentiles with the exact ones.
+static bool checkPercentiles() {
+    OperationStats::reset();
+    mt19937_64 rng(7);
+    lognormal_distribution<double> latency(7.0, 2.0);  // Median ~1 us, tail into seconds
+    vector<long long> samples(1000000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<long long>(latency(rng));
+        OperationStats::recordLatency(STAT_LOAD_MENU, samples[i]);
+    }
+    sort(samples.begin(), samples.end());
+    StatSummary summary = OperationStats::getSummary(STAT_LOAD_MENU);
+
+    const double fractions[] = {0.5, 0.9, 0.99, 0.999};
+    const long long reported[] = {summary.p50Ns, summary.p90Ns, summary.p99Ns, summary.p999Ns};
+    bool accurate = summary.maxNs == samples.back();
+    printf("percentile      exact ns   histogram ns   error\n");
+    for (int i = 0; i < 4; ++i) {
+        long long exact = samples[static_cast<size_t>(fractions[i] * samples.size() + 0.5) - 1];
+        double error = exact > 0 ? fabs(static_cast<double>(reported[i] - exact)) / exact : 0;
+        accurate = accurate && (error <= 1.0 / LatencyHistogram::SUB_BUCKETS || reported[i] - exact <= 1);
+        printf("p%-12g %11lld %14lld %6.2f%%\n", fractions[i] * 100, exact, reported[i], error * 100);
+    }
+    OperationStats::reset();
+    return accurate;
+}
+
+int main() {
+    bool accurate = checkPercentiles();
+
+    DynamicArrayList menu(1000);
+    for (int i = 1; i <= 1000; ++i) {
+        menu.addMenuItem(MenuItem("Dish", "Benchmark item", 1.0 + i % 50));
+    }
+    Order order("Guest");
+    const int ids[] = {1, 2, 3};
+    order.addItems(ids, 3, menu);
+
+    const int calls = 2000000;
+    double bestFind = 1e30, bestQueue = 1e30;
+    long long checksum = 0;
+    for (int round = 0; round < 7; ++round) {
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < calls; ++i) {
+            const MenuItem* item = menu.findMenuItem(1 + (i * 7919LL) % 1000);
+            checksum += item ? item->getId() : 0;
+        }
+        bestFind = min(bestFind, chrono::duration<double, nano>(Clock::now() - start).count() / calls);
+
+        ActiveOrdersQueue queue;
+        Order out;
+        start = Clock::now();
+        for (int i = 0; i < calls; ++i) {
+            queue.enqueue(order);
+            queue.dequeue(out);
+            checksum += out.getOrderId();
+        }
+        bestQueue = min(bestQueue, chrono::duration<double, nano>(Clock::now() - start).count() / calls);
+    }
+
+    printf("\nstatistics %s in this build\n", OperationStats::isEnabled() ? "enabled" : "compiled out");
+    printf("findMenuItem:       %6.1f ns/call\n", bestFind);
+    printf("enqueue + dequeue:  %6.1f ns/pair\n", bestQueue);
+    if (OperationStats::isEnabled()) {
+        StatSummary find = OperationStats::getSummary(STAT_FIND_MENU_ITEM);
+        printf("find calls counted: %lld, timed: %lld (checksum %lld)\n", find.calls, find.timed, checksum);
+    } else {
+        printf("(checksum %lld)\n", checksum);
+    }
+    printf("histogram percentiles within one bucket: %s\n", accurate ? "yes" : "NO");
+    return accurate ? 0 : 1;
+}
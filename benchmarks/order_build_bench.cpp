@@ -0,0 +1,151 @@
+// This benchmark measures the cost of building orders of different sizes. It
+// compares the old line storage, which reallocated and copied the whole array
+// for every item added, with the current Order: items added one at a time with
+// addItem and all at once with addItems. It reports time per order and heap
+// allocations per order, counted by replacing the global operator new. Order
+// times include constructing the Order with its name and status strings, which
+// the bare array of the old way does not pay for. It also checks that copies,
+// moves and the binary round trip keep every line item.
+//
+// Build from the repository root:
+//   make order_build_bench
+// Run:
+//   ./order_build_bench [orders per size]
+
+//
+//  order_build_bench.cpp
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+
+static long long allocations = 0;  // Calls to the global operator new
+
+void* operator new(size_t size) {
+    allocations++;
+    void* block = malloc(size ? size : 1);
+    if (block == NULL) {
+        throw bad_alloc();
+    }
+    return block;
+}
+
+void operator delete(void* block) noexcept {
+    free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+
+// The old way: a new array one line larger for every item added.
+static long long buildGrowByOne(const int ids[], int count, const DynamicArrayList& menu) {
+    OrderLine* lines = NULL;
+    int lineCount = 0;
+    long long cents = 0;
+    for (int i = 0; i < count; ++i) {
+        const MenuItem* item = menu.findMenuItem(ids[i]);
+        OrderLine* temp = new OrderLine[lineCount + 1];
+        for (int k = 0; k < lineCount; ++k) {
+            temp[k] = lines[k];
+        }
+        temp[lineCount].menuItemId = ids[i];
+        temp[lineCount].quantity = 1;
+        temp[lineCount].unitPrice = item->getPrice();
+        delete[] lines;
+        lines = temp;
+        lineCount++;
+        cents += static_cast<long long>(item->getPrice() * 100 + 0.5);
+    }
+    delete[] lines;
+    return cents;
+}
+
+// Times `orders` builds of one way; returns microseconds per order and sets allocations per order.
+template <typename Build>
+static double timeBuilds(int orders, Build build, double& allocationsPerOrder) {
+    long long before = allocations;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for (int i = 0; i < orders; ++i) {
+        build(i);
+    }
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    allocationsPerOrder = static_cast<double>(allocations - before) / orders;
+    return chrono::duration<double, micro>(t1 - t0).count() / orders;
+}
+
+int main(int argc, char* argv[]) {
+    int orders = argc > 1 ? atoi(argv[1]) : 100000;
+    if (orders < 1) {
+        fprintf(stderr, "orders must be positive\n");
+        return 1;
+    }
+
+    DynamicArrayList menu(100);
+    for (int i = 1; i <= 100; ++i) {
+        menu.addMenuItem(MenuItem("Dish " + to_string(i), "Fresh", 2 + i % 17 + 0.5 * (i % 2)));
+    }
+
+    const int sizes[] = {1, 4, 8, 16, 30, 100};
+    int ids[100];
+    bool same = true;
+    long long sink = 0;  // Keeps the builds from being optimized away
+    printf("items   grow-by-one us/allocs   addItem us/allocs   addItems us/allocs\n");
+    for (int s = 0; s < 6; ++s) {
+        int count = sizes[s];
+        int runs = count > 30 ? orders / 10 : orders;
+        for (int k = 0; k < count; ++k) {
+            ids[k] = 1 + (k * 37) % 100;  // Distinct neighbours, so no lines are merged
+        }
+        double oldAllocs, oneAllocs, bulkAllocs;
+        double oldTime = timeBuilds(runs, [&](int) {
+            sink += buildGrowByOne(ids, count, menu);
+        }, oldAllocs);
+        double oneTime = timeBuilds(runs, [&](int) {
+            Order order("Guest");
+            for (int k = 0; k < count; ++k) {
+                order.addItem(ids[k], menu);
+            }
+            sink += order.getTotalCents();
+        }, oneAllocs);
+        double bulkTime = timeBuilds(runs, [&](int) {
+            Order order("Guest");
+            order.addItems(ids, count, menu);
+            sink += order.getTotalCents();
+        }, bulkAllocs);
+        printf("%5d   %10.3f / %-7.2f   %8.3f / %-7.2f   %8.3f / %-7.2f\n", count,
+               oldTime, oldAllocs, oneTime, oneAllocs, bulkTime, bulkAllocs);
+
+        // Copies, moves and the binary round trip keep every line item.
+        Order built("Check");
+        built.addItems(ids, count, menu);
+        long long expected = buildGrowByOne(ids, count, menu);
+        Order copied(built);
+        Order assigned;
+        assigned = copied;
+        Order moved(std::move(copied));
+        Order moveAssigned;
+        moveAssigned = std::move(assigned);
+        string image;
+        built.writeBinary(image);
+        BinaryReader reader(image);
+        Order decoded;
+        decoded.readBinary(reader, &menu);
+        same = same && built.getTotalCents() == expected && moved.getTotalCents() == expected
+               && moveAssigned.getTotalCents() == expected && decoded.getTotalCents() == expected
+               && decoded.getItemCount() == count && copied.getItemCount() == 0
+               && assigned.getItemCount() == 0;
+    }
+
+    printf("line items survive copy, move and round trip: %s\n", same ? "yes" : "NO");
+    return same && sink != 0 ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+// This benchmark follows orders through their whole lifecycle - built at
+// intake, enqueued, dequeued and pushed onto the completed stack - and counts
+// heap allocations by replacing the global operator new. The copy path hands
+// the containers named orders (enqueue(const Order&), push(const Order&)); the
+// move path hands them temporaries, so the rvalue overloads take over the
+// order's strings and line items. Orders have a long customer name and more
+// line items than fit inline, so every deep copy shows up as allocations.
+// After intake each order costs one allocation for its entry in the queue's
+// ID index, plus a share of the occasional node block or stack chunk. The
+// program fails if the move path allocates more than that.
+//
+// Build from the repository root:
+//   make order_lifecycle_bench
+// Run:
+//   ./order_lifecycle_bench [orders] [items per order]
+
+//
+//  order_lifecycle_bench.cpp
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include "ActiveOrdersQueue.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+
+static long long allocations = 0;  // Calls to the global operator new
+
+void* operator new(size_t size) {
+    allocations++;
+    void* block = malloc(size ? size : 1);
+    if (block == NULL) {
+        throw bad_alloc();
+    }
+    return block;
+}
+
+void operator delete(void* block) noexcept {
+    free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+
+// Allocation counts and time of one run.
+struct LifecycleCost {
+    double intakeAllocs;     // Per order, building the order.
+    double afterAllocs;      // Per order, enqueue + dequeue + push.
+    double microsPerOrder;   // Whole lifecycle.
+    long long revenueCents;  // Checked to be equal for both paths.
+};
+
+// Builds the i-th order: a long customer name and `items` distinct items.
+static Order makeOrder(int i, int items, const DynamicArrayList& menu, const int ids[]) {
+    Order order("Customer with a long enough name #" + to_string(i));
+    order.addItems(ids + i % 7, items, menu);
+    return order;
+}
+
+// Runs `orders` orders through the lifecycle, in batches of 64 queued orders.
+static LifecycleCost runLifecycle(int orders, int items, bool move, const DynamicArrayList& menu,
+                                  const int ids[]) {
+    ActiveOrdersQueue activeOrders;
+    CompletedOrdersStack completedOrders;
+    long long intake = 0, after = 0;
+    Order processed;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for (int done = 0; done < orders; done += 64) {
+        int batch = min(64, orders - done);
+        for (int i = done; i < done + batch; ++i) {
+            long long before = allocations;
+            Order order = makeOrder(i, items, menu, ids);
+            long long built = allocations;
+            if (move) {
+                activeOrders.enqueue(std::move(order));
+            } else {
+                activeOrders.enqueue(order);
+            }
+            intake += built - before;
+            after += allocations - built;
+        }
+        long long before = allocations;
+        while (activeOrders.dequeue(processed)) {
+            processed.setStatus("completed");
+            if (move) {
+                completedOrders.push(std::move(processed));
+            } else {
+                completedOrders.push(processed);
+            }
+        }
+        after += allocations - before;
+    }
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    LifecycleCost cost;
+    cost.intakeAllocs = static_cast<double>(intake) / orders;
+    cost.afterAllocs = static_cast<double>(after) / orders;
+    cost.microsPerOrder = chrono::duration<double, micro>(t1 - t0).count() / orders;
+    cost.revenueCents = completedOrders.getTotalRevenueCents();
+    return cost;
+}
+
+int main(int argc, char* argv[]) {
+    int orders = argc > 1 ? atoi(argv[1]) : 200000;
+    int items = argc > 2 ? atoi(argv[2]) : 20;
+    if (orders < 1 || items < 1 || items > 90) {
+        fprintf(stderr, "orders must be positive and items between 1 and 90\n");
+        return 1;
+    }
+
+    DynamicArrayList menu(100);
+    int ids[100];
+    for (int i = 1; i <= 100; ++i) {
+        menu.addMenuItem(MenuItem("Dish " + to_string(i), "Seasonal", 4 + i % 19 + 0.25 * (i % 4)));
+        ids[i - 1] = i;
+    }
+
+    LifecycleCost copied = runLifecycle(orders, items, false, menu, ids);
+    LifecycleCost moved = runLifecycle(orders, items, true, menu, ids);
+    printf("orders: %d, items per order: %d (inline capacity %d)\n", orders, items, Order::INLINE_LINES);
+    printf("path   intake allocs/order   lifecycle allocs/order   us/order\n");
+    printf("copy   %19.3f   %22.3f   %8.3f\n", copied.intakeAllocs, copied.afterAllocs, copied.microsPerOrder);
+    printf("move   %19.3f   %22.3f   %8.3f\n", moved.intakeAllocs, moved.afterAllocs, moved.microsPerOrder);
+
+    // One ID index entry per order; node blocks and stack chunks are shared by hundreds of orders.
+    bool noCopies = moved.afterAllocs < 1.05;
+    bool same = copied.revenueCents == moved.revenueCents;
+    printf("move path copies no order after intake: %s\n", noCopies ? "yes" : "NO");
+    printf("both paths archive the same revenue: %s\n", same ? "yes" : "NO");
+    return noCopies && same ? 0 : 1;
+}
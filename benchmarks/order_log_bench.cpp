@@ -0,0 +1,168 @@
+// This benchmark compares two ways of persisting completed orders as the day's
+// history grows. The old way rewrites the whole text file with
+// saveCompletedOrdersToFile after every batch of new orders; the new way
+// streams each pushed order into an AppendOnlyLog. It reports the cost per
+// batch at several history sizes, then the throughput of the log under each
+// fsync policy and group size. Finally it pops a few orders and checks that
+// the report rebuilt from the log is identical to the one written from the
+// stack, and that a torn last record is cut off when the log is reopened.
+//
+// Build from the repository root:
+//   make order_log_bench
+// Run:
+//   ./order_log_bench [orders] [batch]
+
+//
+//  order_log_bench.cpp
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AppendOnlyLog.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+
+static const string LOG_FILE = "order_log_bench.log";
+static const string TEXT_FILE = "order_log_bench.txt";
+static const string REPORT_FILE = "order_log_bench_report.txt";
+
+// Builds the i-th test order with a few items from the menu.
+static Order makeOrder(int i, const DynamicArrayList& menu) {
+    Order order("Customer " + to_string(i));
+    order.setOrderId(i + 1);
+    for (int k = 0; k < 3 + i % 4; ++k) {
+        int id = 1 + (i * 7 + k) % menu.getSize();
+        order.addItem(id, menu);
+    }
+    order.setStatus("completed");
+    return order;
+}
+
+// Reads a whole file into a string.
+static string readFile(const string& fileName) {
+    ifstream in(fileName.c_str(), ios::binary);
+    ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+// Pushes `orders` orders through a log with the given settings; returns orders per second.
+static double logThroughput(int orders, int groupSize, FsyncPolicy policy, const DynamicArrayList& menu,
+                            LogStats& stats) {
+    remove(LOG_FILE.c_str());
+    AppendOnlyLog log(groupSize, policy, 20);
+    log.open(LOG_FILE);
+    CompletedOrdersStack stack;
+    stack.setOrderLog(&log);
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for (int i = 0; i < orders; ++i) {
+        stack.push(makeOrder(i, menu));
+    }
+    log.close();
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    stats = log.getStats();
+    return orders / chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    int orders = argc > 1 ? atoi(argv[1]) : 20000;
+    int batch = argc > 2 ? atoi(argv[2]) : 1000;
+    if (orders < 1 || batch < 1) {
+        cerr << "orders and batch must be positive" << endl;
+        return 1;
+    }
+
+    DynamicArrayList menu(50);
+    for (int i = 1; i <= 50; ++i) {
+        menu.addMenuItem(MenuItem("Dish " + to_string(i), "Chef's choice", 4 + i % 20 + 0.25 * (i % 4)));
+    }
+
+    // Cost of persisting each batch of new orders as the history grows.
+    remove(LOG_FILE.c_str());
+    AppendOnlyLog log(64, FSYNC_EACH_COMMIT, 20);
+    log.open(LOG_FILE);
+    CompletedOrdersStack logged;
+    logged.setOrderLog(&log);
+    CompletedOrdersStack rewritten;
+
+    cout << "history   rewrite/batch   log/batch" << endl;
+    for (int done = 0; done < orders; done += batch) {
+        int count = min(batch, orders - done);
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        for (int i = done; i < done + count; ++i) {
+            rewritten.push(makeOrder(i, menu));
+        }
+        rewritten.saveCompletedOrdersToFile(TEXT_FILE);
+        chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+        for (int i = done; i < done + count; ++i) {
+            logged.push(makeOrder(i, menu));
+        }
+        log.sync();
+        chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+        if ((done / batch) % 4 == 0 || done + count >= orders) {
+            printf("%7d   %10.2f ms   %8.2f ms\n", done + count,
+                   chrono::duration<double, milli>(t1 - t0).count(),
+                   chrono::duration<double, milli>(t2 - t1).count());
+        }
+    }
+    for (int i = 0; i < 3 && !logged.isEmpty(); ++i) {
+        logged.pop();  // Logged as removals, so they leave the report too
+        rewritten.pop();
+    }
+    rewritten.saveCompletedOrdersToFile(TEXT_FILE);
+    log.close();
+
+    // The report rebuilt from the log must match the one written from the stack.
+    CompletedOrdersStack::saveLogReportToFile(LOG_FILE, REPORT_FILE, &menu);
+    bool same = readFile(TEXT_FILE) == readFile(REPORT_FILE);
+    cout << "report from log matches text save: " << (same ? "yes" : "NO") << endl;
+
+    // A torn last record is cut off by open, and records appended afterwards can be read.
+    vector<string> before, after;
+    AppendOnlyLog::readRecords(LOG_FILE, before);
+    {
+        ofstream tail(LOG_FILE.c_str(), ios::binary | ios::app);
+        const char torn[] = {48, 0, 0, 0, 1, 2, 3, 4, 'h', 'a', 'l', 'f'};  // Promises 48 bytes
+        tail.write(torn, sizeof(torn));
+    }
+    chrono::steady_clock::time_point openStart = chrono::steady_clock::now();
+    AppendOnlyLog reopened;
+    bool reopenedOk = reopened.open(LOG_FILE);
+    double openMs = chrono::duration<double, milli>(chrono::steady_clock::now() - openStart).count();
+    reopened.append("after the tear");
+    reopened.close();
+    AppendOnlyLog::readRecords(LOG_FILE, after);
+    bool tornOk = reopenedOk && after.size() == before.size() + 1 && after.back() == "after the tear";
+    printf("torn tail cut off by open (%.2f ms for %zu records): %s\n", openMs, before.size(),
+           tornOk ? "yes" : "NO");
+
+    // Log throughput under each fsync policy and group size.
+    int throughputOrders = min(orders, 5000);
+    const int groups[] = {1, 16, 256};
+    const FsyncPolicy policies[] = {FSYNC_NEVER, FSYNC_INTERVAL, FSYNC_EACH_COMMIT};
+    const char* policyNames[] = {"never", "interval", "each-commit"};
+    cout << "policy        group   orders/s   commits   fsyncs" << endl;
+    for (int p = 0; p < 3; ++p) {
+        for (int g = 0; g < 3; ++g) {
+            LogStats stats;
+            double rate = logThroughput(throughputOrders, groups[g], policies[p], menu, stats);
+            printf("%-12s %6d %10.0f %9lld %8lld\n", policyNames[p], groups[g], rate,
+                   stats.commits, stats.fsyncs);
+        }
+    }
+
+    remove(LOG_FILE.c_str());
+    remove(TEXT_FILE.c_str());
+    remove(REPORT_FILE.c_str());
+    return same && tornOk ? 0 : 1;
+}
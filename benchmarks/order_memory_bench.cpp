@@ -0,0 +1,79 @@
+// This benchmark measures the resident memory used by a day of completed orders.
+// "compact" stores real Order objects (line items that refer to the menu by ID)
+// in a CompletedOrdersStack. "copies" stores the same orders as arrays of full
+// MenuItem copies, which is how orders were represented before line items.
+// Run each mode in its own process so the peak RSS figures do not mix.
+//
+// Build from the repository root:
+//   make order_memory_bench
+// Run:
+//   ./order_memory_bench compact 100000
+//   ./order_memory_bench copies 100000
+
+//
+//  order_memory_bench.cpp
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/resource.h>
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+
+// Returns the peak resident set size of this process in kilobytes.
+static long peakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // Reported in bytes on macOS.
+#else
+    return usage.ru_maxrss;         // Reported in kilobytes on Linux.
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    const char* mode = argc > 1 ? argv[1] : "compact";
+    int orderCount = argc > 2 ? atoi(argv[2]) : 100000;
+    const int itemsPerOrder = 4;
+
+    DynamicArrayList menu(10);
+    for (int i = 0; i < 200; ++i) {
+        menu.addMenuItem(MenuItem("Grilled Chicken Caesar Salad",
+                                  "Romaine, parmesan, croutons and house dressing with grilled chicken",
+                                  8.5 + i % 10));
+    }
+
+    long before = peakRssKb();
+    srand(7);
+    if (strcmp(mode, "copies") == 0) {
+        MenuItem** orders = new MenuItem*[orderCount];
+        for (int o = 0; o < orderCount; ++o) {
+            orders[o] = new MenuItem[itemsPerOrder];
+            for (int i = 0; i < itemsPerOrder; ++i) {
+                orders[o][i] = *menu.findMenuItem(1 + rand() % menu.getSize());
+            }
+        }
+        cout << "orders: " << orderCount << ", mode: copies" << endl;
+        cout << "peak RSS growth: " << (peakRssKb() - before) << " KB" << endl;
+    } else {
+        CompletedOrdersStack completed;
+        for (int o = 0; o < orderCount; ++o) {
+            Order order("Customer");
+            for (int i = 0; i < itemsPerOrder; ++i) {
+                int id = 1 + rand() % menu.getSize();
+                order.addItem(id, menu);
+            }
+            order.setOrderId(o + 1);
+            order.setStatus("completed");
+            completed.push(order);
+        }
+        cout << "orders: " << completed.getSize() << ", mode: compact" << endl;
+        cout << "peak RSS growth: " << (peakRssKb() - before) << " KB" << endl;
+    }
+    return 0;
+}
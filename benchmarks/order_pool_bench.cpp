@@ -0,0 +1,69 @@
+// This benchmark runs enqueue -> dequeue -> push cycles through ActiveOrdersQueue
+// and CompletedOrdersStack and reports the time per cycle together with the
+// node pool statistics for several pool block sizes. The completed stack is
+// popped back down at the end of every shift so memory stays bounded while
+// millions of orders pass through.
+//
+// Build from the repository root:
+//   make order_pool_bench
+// Run:
+//   ./order_pool_bench [orders]
+
+//
+//  order_pool_bench.cpp
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "ActiveOrdersQueue.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    long orderCount = argc > 1 ? atol(argv[1]) : 4000000;
+    const int queueDepth = 64;      // Orders waiting in the queue at any time.
+    const int shiftLength = 100000; // Completed orders archived per shift.
+    const int blockSizes[] = {16, 256, 4096};
+
+    DynamicArrayList menu(10);
+    for (int i = 0; i < 50; ++i) {
+        menu.addMenuItem(MenuItem("Item", "Benchmark item", 5.0 + i));
+    }
+    Order ticket("Customer");
+    for (int i = 1; i <= 3; ++i) {
+        ticket.addItem(i, menu);
+    }
+
+    cout << "block size, ns per cycle, blocks, slots, allocations, reuses" << endl;
+    for (int b = 0; b < 3; ++b) {
+        ActiveOrdersQueue active(blockSizes[b]);
+        CompletedOrdersStack completed;
+        Order processed;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (long i = 0; i < orderCount; ++i) {
+            active.enqueue(ticket);
+            if (active.getSize() > queueDepth && active.dequeue(processed)) {
+                processed.setStatus("completed");
+                completed.push(processed);
+                if (completed.getSize() == shiftLength) {
+                    while (!completed.isEmpty()) {
+                        completed.pop();
+                    }
+                }
+            }
+        }
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+        PoolStats stats = active.getNodePoolStats();
+        double ns = chrono::duration<double, nano>(end - start).count() / orderCount;
+        cout << blockSizes[b] << ", " << ns << ", " << stats.blocks << ", " << stats.slots
+             << ", " << stats.allocations << ", " << stats.reuses << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+// This benchmark measures the active-order write-ahead log. It first reports
+// the cost per order of taking and processing orders (enqueue, dequeue, push)
+// with no log and with the log under each fsync policy. It then logs a day of
+// order changes (100k orders by default, some cancelled, most processed),
+// recovers them into empty containers and reports the recovery time. Finally
+// it checks that the recovered queue and stack match the originals and that
+// replaying the same log a second time changes nothing.
+//
+// Build from the repository root:
+//   make order_wal_bench
+// Run:
+//   ./order_wal_bench [recovery orders] [overhead orders]
+
+//
+//  order_wal_bench.cpp
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "ActiveOrdersQueue.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+#include "OrderWAL.h"
+
+using namespace std;
+
+static const string WAL_FILE = "order_wal_bench.wal";
+
+// Builds the i-th test order with a few items from the menu.
+static Order makeOrder(int i, const DynamicArrayList& menu) {
+    Order order("Table " + to_string(i % 40));
+    for (int k = 0; k < 2 + i % 4; ++k) {
+        int id = 1 + (i * 11 + k) % menu.getSize();
+        order.addItem(id, menu);
+    }
+    return order;
+}
+
+// Takes and processes `orders` orders, logging each change if a log is given;
+// returns microseconds per order.
+static double orderCycle(int orders, OrderWAL* wal, const DynamicArrayList& menu) {
+    ActiveOrdersQueue activeOrders;
+    CompletedOrdersStack completedOrders;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for (int i = 0; i < orders; ++i) {
+        int id = activeOrders.enqueue(makeOrder(i, menu));
+        if (wal) {
+            wal->recordEnqueue(*activeOrders.findOrder(id));
+        }
+        if (i % 4 == 3) {
+            // The kitchen catches up every few orders
+            Order processed;
+            while (activeOrders.dequeue(processed)) {
+                processed.setStatus("completed");
+                processed.markCompleted();
+                completedOrders.push(processed);
+                if (wal) {
+                    wal->recordProcess(processed);
+                }
+            }
+        }
+    }
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    return chrono::duration<double, micro>(t1 - t0).count() / orders;
+}
+
+int main(int argc, char* argv[]) {
+    int recoveryOrders = argc > 1 ? atoi(argv[1]) : 100000;
+    int overheadOrders = argc > 2 ? atoi(argv[2]) : 2000;
+    if (recoveryOrders < 1 || overheadOrders < 1) {
+        cerr << "order counts must be positive" << endl;
+        return 1;
+    }
+
+    DynamicArrayList menu(60);
+    for (int i = 1; i <= 60; ++i) {
+        menu.addMenuItem(MenuItem("Dish " + to_string(i), "House special", 5 + i % 25 + 0.75 * (i % 2)));
+    }
+
+    // Cost per order of logging every change before it is acknowledged.
+    double baseline = orderCycle(overheadOrders, NULL, menu);
+    printf("policy        us/order   overhead   fsyncs\n");
+    printf("%-12s %9.2f %10s %8s\n", "no log", baseline, "-", "-");
+    const FsyncPolicy policies[] = {FSYNC_NEVER, FSYNC_INTERVAL, FSYNC_EACH_COMMIT};
+    const char* policyNames[] = {"never", "interval", "each-commit"};
+    for (int p = 0; p < 3; ++p) {
+        remove(WAL_FILE.c_str());
+        ActiveOrdersQueue empty;
+        CompletedOrdersStack none;
+        OrderWAL wal(WAL_FILE, policies[p], 20);
+        wal.recover(empty, none, &menu);
+        double logged = orderCycle(overheadOrders, &wal, menu);
+        wal.close();
+        printf("%-12s %9.2f %9.2fx %8lld\n", policyNames[p], logged, logged / baseline,
+               wal.getStats().fsyncs);
+    }
+
+    // Log a day of order changes without fsyncs, then time the recovery.
+    remove(WAL_FILE.c_str());
+    ActiveOrdersQueue activeOrders;
+    CompletedOrdersStack completedOrders;
+    {
+        ActiveOrdersQueue empty;
+        CompletedOrdersStack none;
+        OrderWAL wal(WAL_FILE, FSYNC_NEVER);
+        wal.recover(empty, none, &menu);
+        for (int i = 0; i < recoveryOrders; ++i) {
+            int id = activeOrders.enqueue(makeOrder(i, menu));
+            wal.recordEnqueue(*activeOrders.findOrder(id));
+            if (i % 10 == 5) {
+                activeOrders.deleteOrder(id - 2);  // A customer changes their mind
+                wal.recordCancel(id - 2);
+            }
+            if (i % 8 == 7) {
+                Order processed;
+                for (int k = 0; k < 7 && activeOrders.dequeue(processed); ++k) {
+                    processed.setStatus("completed");
+                    processed.markCompleted();
+                    completedOrders.push(processed);
+                    wal.recordProcess(processed);
+                }
+            }
+        }
+        wal.close();
+    }
+
+    ActiveOrdersQueue recoveredActive;
+    CompletedOrdersStack recoveredCompleted;
+    OrderWAL recovery(WAL_FILE);
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    bool recovered = recovery.recover(recoveredActive, recoveredCompleted, &menu);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    int replayed = recovery.getReplayedCount();
+    recovery.close();
+
+    bool same = recovered
+        && recoveredActive.getSize() == activeOrders.getSize()
+        && recoveredActive.getNextOrderId() == activeOrders.getNextOrderId()
+        && recoveredCompleted.getSize() == completedOrders.getSize()
+        && recoveredCompleted.getTotalRevenueCents() == completedOrders.getTotalRevenueCents()
+        && recoveredCompleted.getTotalItemCount() == completedOrders.getTotalItemCount();
+    Order original, restored;
+    while (activeOrders.dequeue(original) && recoveredActive.dequeue(restored)) {
+        same = same && original.getOrderId() == restored.getOrderId()
+               && original.getTotalCents() == restored.getTotalCents();
+    }
+    same = same && recoveredActive.isEmpty();
+
+    // Replaying on top of the recovered state must be a no-op.
+    OrderWAL again(WAL_FILE);
+    ActiveOrdersQueue recoveredAgain;
+    CompletedOrdersStack completedAgain;
+    again.recover(recoveredAgain, completedAgain, &menu);
+    int firstSize = recoveredAgain.getSize();
+    again.close();
+    again.recover(recoveredAgain, completedAgain, &menu);
+    again.close();
+    bool idempotent = again.getReplayedCount() == 0 && recoveredAgain.getSize() == firstSize
+                      && completedAgain.getSize() == completedOrders.getSize();
+
+    cout << "logged orders: " << recoveryOrders << ", records replayed: " << replayed << endl;
+    cout << "recovery:      " << chrono::duration<double, milli>(t1 - t0).count() << " ms" << endl;
+    cout << "recovered state matches: " << (same ? "yes" : "NO") << endl;
+    cout << "second replay is a no-op: " << (idempotent ? "yes" : "NO") << endl;
+
+    remove(WAL_FILE.c_str());
+    return same && idempotent ? 0 : 1;
+}
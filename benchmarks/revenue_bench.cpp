@@ -0,0 +1,68 @@
+// This benchmark checks and times the running revenue totals of
+// CompletedOrdersStack. For each stack size it pushes random orders, pops a
+// share of them again, and verifies that the maintained totals match a full
+// recompute. It then compares the time of calculateTotalRevenue (running
+// total) with recalculateTotalRevenueCents (full walk). The program exits with
+// a non-zero status if the totals ever disagree.
+//
+// Build from the repository root:
+//   make revenue_bench
+
+//
+//  revenue_bench.cpp
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+
+int main() {
+    const int sizes[] = {1000, 10000, 100000, 1000000};
+    bool allPassed = true;
+
+    DynamicArrayList menu(10);
+    for (int i = 0; i < 100; ++i) {
+        menu.addMenuItem(MenuItem("Item", "Benchmark item", 0.99 + i * 0.37));  // Prices that are not exact in binary
+    }
+
+    srand(11);
+    cout << "orders, running total ns, full recompute ns, revenue, check" << endl;
+    for (int s = 0; s < 4; ++s) {
+        CompletedOrdersStack completed;
+        long items = 0;
+        for (int o = 0; o < sizes[s]; ++o) {
+            Order order("Customer");
+            int lines = 1 + rand() % 5;
+            for (int i = 0; i < lines; ++i) {
+                int id = 1 + rand() % menu.getSize();
+                order.addItem(id, menu);
+            }
+            items += order.getItemCount();
+            completed.push(order);
+            if (rand() % 10 == 0) {
+                items -= completed.pop().getItemCount();  // Exercise the pop path too
+            }
+        }
+
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        double revenue = completed.calculateTotalRevenue();
+        chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+        long long recomputed = completed.recalculateTotalRevenueCents();
+        chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+        bool passed = completed.getTotalRevenueCents() == recomputed
+                      && completed.getTotalItemCount() == items;
+        allPassed = allPassed && passed;
+        cout << completed.getSize() << ", "
+             << chrono::duration<double, nano>(t1 - t0).count() << ", "
+             << chrono::duration<double, nano>(t2 - t1).count() << ", "
+             << revenue << ", " << (passed ? "ok" : "FAILED") << endl;
+    }
+    return allPassed ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+// This benchmark measures restart time from a binary system snapshot. It fills
+// a menu, an active orders queue and a completed orders stack (1M completed
+// orders by default), saves a snapshot and reports how long the containers
+// were held and how long the background encode and write took. While the
+// snapshot is written, orders are pushed onto and popped off the completed
+// stack. It then loads the snapshot into empty containers, reports the load
+// time and checks that sizes, revenue, order IDs and the ID counters match
+// the state at the moment of the save. Finally it loads a copy whose last
+// order is cut off (with a valid checksum) and checks that nothing changed,
+// and feeds each container a section whose count is far larger than its
+// bytes, which must be rejected without allocating for it.
+//
+// Build from the repository root:
+//   make snapshot_bench
+// Run:
+//   ./snapshot_bench [completed orders] [active orders] [file]
+
+//
+//  snapshot_bench.cpp
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ActiveOrdersQueue.h"
+#include "BinaryIO.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+#include "SystemSnapshot.h"
+
+using namespace std;
+
+// Copies a snapshot without its last bytes, fixing up the length and the checksum so only decoding fails.
+static bool writeCutSnapshot(const string& fileName, const string& cutFile) {
+    ifstream in(fileName.c_str(), ios::binary);
+    string image((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    const size_t header = 8 + 4 + 8 + 4;  // Magic, version, length, checksum
+    if (image.size() < header + 16) {
+        return false;
+    }
+    image.resize(image.size() - 16);
+    char* at = storeInt64(&image[8 + 4], static_cast<int64_t>(image.size() - header));
+    storeInt32(at, static_cast<int32_t>(checksumWords(image.data() + header, image.size() - header)));
+    ofstream out(cutFile.c_str(), ios::binary);
+    out.write(image.data(), image.size());
+    return static_cast<bool>(out);
+}
+
+// Builds the i-th test order with a few items from the menu.
+static Order makeOrder(int i, const DynamicArrayList& menu) {
+    Order order("Guest " + to_string(i % 1000));
+    for (int k = 0; k < 2 + i % 4; ++k) {
+        int id = 1 + (i * 13 + k) % menu.getSize();
+        order.addItem(id, menu);
+    }
+    return order;
+}
+
+int main(int argc, char* argv[]) {
+    int completedCount = argc > 1 ? atoi(argv[1]) : 1000000;
+    int activeCount = argc > 2 ? atoi(argv[2]) : 10000;
+    string fileName = argc > 3 ? argv[3] : "snapshot_bench.bin";
+
+    DynamicArrayList menu(200);
+    for (int i = 1; i <= 200; ++i) {
+        menu.addMenuItem(MenuItem("Dish " + to_string(i), "Served with bread", 3 + i % 30 + 0.5 * (i % 2)));
+    }
+    ActiveOrdersQueue activeOrders;
+    CompletedOrdersStack completedOrders;
+    for (int i = 0; i < completedCount; ++i) {
+        Order order = makeOrder(i, menu);
+        order.setOrderId(i + 1);
+        order.setStatus("completed");
+        completedOrders.push(order);
+    }
+    vector<Order> lateOrders;  // Completed while the snapshot is being written
+    for (int i = 0; i < 3000; ++i) {
+        lateOrders.push_back(makeOrder(i, menu));
+        lateOrders.back().setOrderId(completedCount + i + 1);
+        lateOrders.back().setStatus("completed");
+    }
+    for (int i = 0; i < activeCount + 10; ++i) {
+        activeOrders.enqueue(makeOrder(i, menu));
+    }
+    for (int id = 1; id <= 10; ++id) {
+        activeOrders.deleteOrder(id * 3);  // Cancelled orders leave gaps in the order IDs
+    }
+    menu.deleteMenuItem(7);  // and a deleted item leaves one in the menu IDs
+
+    int savedSize = completedOrders.getSize();
+    long long savedRevenue = completedOrders.getTotalRevenueCents();
+    long savedItems = completedOrders.getTotalItemCount();
+
+    SystemSnapshot saver(menu, activeOrders, completedOrders);
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    saver.save(fileName);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    // The stack keeps changing while the writer encodes it; the snapshot must not see this.
+    for (int i = 0; i < 1000 && completedOrders.getSize() > 0; ++i) {
+        completedOrders.pop();
+    }
+    for (size_t i = 0; i < lateOrders.size(); ++i) {
+        completedOrders.push(lateOrders[i]);
+    }
+    bool saved = saver.waitForSave();
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+    DynamicArrayList restoredMenu(10);
+    ActiveOrdersQueue restoredActive;
+    CompletedOrdersStack restoredCompleted;
+    SystemSnapshot loader(restoredMenu, restoredActive, restoredCompleted);
+    chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+    bool loaded = loader.load(fileName);
+    chrono::steady_clock::time_point t4 = chrono::steady_clock::now();
+
+    bool same = saved && loaded
+        && restoredMenu.getSize() == menu.getSize()
+        && restoredMenu.findMenuItem(7) == NULL
+        && restoredMenu.findMenuItem(200) && restoredMenu.findMenuItem(200)->getName() == "Dish 200"
+        && restoredActive.getSize() == activeOrders.getSize()
+        && restoredActive.findOrder(3) == NULL && restoredActive.findOrder(4) != NULL
+        && restoredCompleted.getSize() == savedSize
+        && restoredCompleted.getTotalRevenueCents() == savedRevenue
+        && restoredCompleted.getTotalItemCount() == savedItems;
+
+    // The ID counters continue where the saved system stopped.
+    int nextMenuId = menu.addMenuItem(MenuItem("New", "New", 1));
+    int restoredMenuId = restoredMenu.addMenuItem(MenuItem("New", "New", 1));
+    activeOrders.enqueue(makeOrder(1, menu));
+    restoredActive.enqueue(makeOrder(1, restoredMenu));
+    Order original, restored;
+    while (activeOrders.dequeue(original) && restoredActive.dequeue(restored)) {
+        same = same && original.getOrderId() == restored.getOrderId()
+               && original.getTotalCents() == restored.getTotalCents();
+    }
+    same = same && nextMenuId == restoredMenuId;
+
+    // A snapshot whose last section does not decode must leave every container as it was.
+    string cutFile = fileName + ".cut";
+    int menuSize = restoredMenu.getSize();
+    int completedSize = restoredCompleted.getSize();
+    restoredActive.enqueue(makeOrder(2, restoredMenu));
+    bool unchanged = writeCutSnapshot(fileName, cutFile) && !loader.load(cutFile)
+        && restoredMenu.getSize() == menuSize && restoredMenu.findMenuItem(restoredMenuId) != NULL
+        && restoredActive.getSize() == 1 && restoredCompleted.getSize() == completedSize;
+    same = same && unchanged;
+
+    // A count no real section could hold is rejected before anything is allocated for it.
+    string oversized;
+    appendInt32(oversized, 1);                 // Next ID (menu and queue)
+    appendInt32(oversized, 0x7fffffff);        // Count
+    oversized.append(64, '\0');
+    BinaryReader stackReader(oversized.data() + 4, oversized.size() - 4);
+    BinaryReader queueReader(oversized.data(), oversized.size());
+    string menuSection;
+    appendInt32(menuSection, 1);               // Next ID
+    appendString(menuSection, "");             // Synced file
+    appendInt64(menuSection, 0);               // and its stamp
+    appendInt64(menuSection, 0);
+    appendInt32(menuSection, 0x7fffffff);      // Count
+    menuSection.append(64, '\0');
+    BinaryReader menuReader(menuSection.data(), menuSection.size());
+    bool oversizedRejected = !restoredCompleted.readBinary(stackReader, &restoredMenu)
+        && !restoredActive.readBinary(queueReader, &restoredMenu)
+        && !restoredMenu.readBinary(menuReader)
+        && restoredCompleted.getSize() == completedSize && restoredActive.getSize() == 1
+        && restoredMenu.getSize() == menuSize;
+    same = same && oversizedRejected;
+
+    cout << "completed orders: " << completedCount << ", active orders: " << activeCount << endl;
+    cout << "save, containers held: " << saver.getLastEncodeMillis() << " ms" << endl;
+    cout << "save, call returned:   " << chrono::duration<double, milli>(t1 - t0).count() << " ms" << endl;
+    cout << "save, on disk:         " << chrono::duration<double, milli>(t2 - t0).count() << " ms" << endl;
+    cout << "load:                  " << chrono::duration<double, milli>(t4 - t3).count() << " ms" << endl;
+    cout << "cut snapshot rejected, state unchanged: " << (unchanged ? "yes" : "NO") << endl;
+    cout << "oversized counts rejected: " << (oversizedRejected ? "yes" : "NO") << endl;
+    cout << "restored state matches: " << (same ? "yes" : "NO") << endl;
+
+    remove(fileName.c_str());
+    remove(cutFile.c_str());
+    return same ? 0 : 1;
+}
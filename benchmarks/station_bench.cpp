@@ -0,0 +1,201 @@
+// This benchmark compares the two kitchen engines on mixed tickets. Orders of
+// one to five items are drawn from a menu spread evenly over the prep
+// stations. KitchenWorkerPool gives each order to one of STATION_COUNT
+// workers, which prepares its items one after another; StationRouter splits
+// each order into one ticket per station and the station workers prepare them
+// in parallel. The third engine is the path menu option 6 and the batch
+// command process take: the orders are submitted to a worker pool bound to
+// the StationRouter, which splits them into station tickets as they are
+// submitted. All use the same preparation time per item.
+//   burst: every order is submitted at once; orders/s is the kitchen's capacity.
+//   paced: orders arrive at half the pool's capacity; the order time shows
+//          how long a customer waits for a complete order.
+// The pool only measures queue waits, so its order time is estimated as the
+// mean queue wait plus the preparation time of the mean order. The program
+// exits with a non-zero status if an engine loses an order, the router
+// prepares a different number of tickets than the orders need, or the pool
+// changes an order's ID on its way to the stations.
+//
+// Build from the repository root:
+//   make station_bench
+// Run:
+//   ./station_bench [orders] [prep micros per item]
+
+//
+//  station_bench.cpp
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "CompletedOrdersStack.h"
+#include "ConcurrentOrdersQueue.h"
+#include "DynamicArrayList.h"
+#include "KitchenWorkerPool.h"
+#include "MenuItem.h"
+#include "Order.h"
+#include "StationRouter.h"
+
+using namespace std;
+
+static const int ITEMS_PER_STATION = 4;
+static const int ROUTING_WORKERS = 2;  // As in main.cpp
+
+// Submits the orders, spaced `gapMicros` apart (0 for all at once).
+template <typename Submit>
+static void feed(const vector<Order>& orders, int gapMicros, Submit submit) {
+    chrono::steady_clock::time_point next = chrono::steady_clock::now();
+    for (size_t i = 0; i < orders.size(); ++i) {
+        if (gapMicros > 0) {
+            next += chrono::microseconds(gapMicros);
+            this_thread::sleep_until(next);
+        }
+        submit(orders[i]);
+    }
+}
+
+// Runs the orders through a worker pool; returns orders/s and the estimated order time.
+static bool runPool(const vector<Order>& orders, int prepMicros, int gapMicros, double meanItems,
+                    double& perSecond, double& orderMicros, long long& maxWaitMicros) {
+    ConcurrentOrdersQueue active;
+    CompletedOrdersStack completed;
+    KitchenWorkerPool kitchen(active, completed, STATION_COUNT, prepMicros);
+    kitchen.start();
+    feed(orders, gapMicros, [&](const Order& order) { active.enqueue(order); });
+    kitchen.shutdown();  // Drains whatever is still queued
+
+    KitchenStats stats = kitchen.getStats();
+    perSecond = stats.ordersPerSecond;
+    orderMicros = stats.averageWaitMicros + meanItems * prepMicros;
+    maxWaitMicros = stats.maxWaitMicros;
+    return completed.getSize() == static_cast<int>(orders.size()) && active.isEmpty();
+}
+
+// Runs the orders through the station router; returns orders/s and the measured order time.
+static bool runRouter(const vector<Order>& orders, const DynamicArrayList& menu, int prepMicros,
+                      int gapMicros, long expectedTickets, double& perSecond, double& orderMicros,
+                      long long& maxOrderMicros, StationStats& stats) {
+    CompletedOrdersStack completed;
+    StationRouter kitchen(menu, completed, prepMicros);
+    kitchen.start();
+    feed(orders, gapMicros, [&](const Order& order) { kitchen.submit(order); });
+    kitchen.shutdown();
+
+    stats = kitchen.getStats();
+    perSecond = stats.ordersPerSecond;
+    orderMicros = stats.averageOrderMicros;
+    maxOrderMicros = stats.maxOrderMicros;
+    return completed.getSize() == static_cast<int>(orders.size()) && kitchen.getOpenOrders() == 0
+           && stats.ticketsCompleted == expectedTickets;
+}
+
+// Submits the orders to a pool bound to the router, as main does.
+static bool runPoolRouter(const vector<Order>& orders, const DynamicArrayList& menu, int prepMicros,
+                          int gapMicros, long expectedTickets, double& perSecond, double& orderMicros,
+                          long long& maxOrderMicros) {
+    ConcurrentOrdersQueue active;
+    CompletedOrdersStack completed;
+    StationRouter stations(menu, completed, prepMicros);
+    KitchenWorkerPool kitchen(active, stations, ROUTING_WORKERS);
+    stations.start();
+    kitchen.start();
+    int nextId = 1;  // Given by ActiveOrdersQueue in main
+    long long idSum = 0;
+    feed(orders, gapMicros, [&](const Order& order) {
+        Order processed(order);
+        processed.setOrderId(nextId);
+        processed.markPlaced();
+        idSum += nextId++;
+        kitchen.submit(std::move(processed));
+    });
+    kitchen.shutdown();  // Returns once the stations have pushed every order
+    stations.shutdown();
+
+    StationStats stats = stations.getStats();
+    KitchenStats routed = kitchen.getStats();  // Counts orders the stations finished, not dispatches
+    perSecond = stats.ordersPerSecond;
+    orderMicros = stats.averageOrderMicros + routed.averageWaitMicros;
+    maxOrderMicros = stats.maxOrderMicros;
+    long long pushedIds = 0;
+    while (!completed.isEmpty()) {
+        pushedIds += completed.pop().getOrderId();
+    }
+    return stats.ordersCompleted == static_cast<long>(orders.size()) && active.isEmpty()
+           && stats.ticketsCompleted == expectedTickets && pushedIds == idSum
+           && routed.ordersCompleted == stats.ordersCompleted && routed.itemsPrepared == stats.itemsPrepared;
+}
+
+int main(int argc, char* argv[]) {
+    int orderCount = argc > 1 ? atoi(argv[1]) : 4000;
+    int prepMicros = argc > 2 ? atoi(argv[2]) : 200;
+    if (orderCount < 1 || prepMicros < 1) {
+        fprintf(stderr, "orders and prep micros must be positive\n");
+        return 1;
+    }
+
+    // Menu item k is prepared at station k % STATION_COUNT
+    DynamicArrayList menu(STATION_COUNT * ITEMS_PER_STATION);
+    for (int k = 0; k < STATION_COUNT * ITEMS_PER_STATION; ++k) {
+        PrepStation station = static_cast<PrepStation>(k % STATION_COUNT);
+        menu.addMenuItem(MenuItem(string(MenuItem::getStationName(station)) + " dish", "Benchmark item",
+                                  6.0 + k, station));
+    }
+
+    mt19937 rng(23);
+    uniform_int_distribution<int> itemCount(1, 5);
+    uniform_int_distribution<int> itemId(1, menu.getSize());
+    vector<Order> orders(orderCount);
+    long items = 0, tickets = 0;
+    for (int o = 0; o < orderCount; ++o) {
+        bool used[STATION_COUNT] = {false};
+        int count = itemCount(rng);
+        for (int i = 0; i < count; ++i) {
+            int id = itemId(rng);
+            orders[o].addItem(id, menu);
+            used[menu.findMenuItem(id)->getStation()] = true;
+        }
+        items += count;
+        for (int s = 0; s < STATION_COUNT; ++s) {
+            tickets += used[s];
+        }
+    }
+    double meanItems = static_cast<double>(items) / orderCount;
+    printf("%d orders, %.2f items and %.2f station tickets per order, %d us per item, %d stations\n\n",
+           orderCount, meanItems, static_cast<double>(tickets) / orderCount, prepMicros, STATION_COUNT);
+
+    bool ok = true;
+    double perSecond, orderMicros;
+    long long maxMicros;
+    StationStats stats;
+    printf("%-7s %-14s %10s %14s %14s\n", "load", "engine", "orders/s", "order time us", "max us");
+    ok = runPool(orders, prepMicros, 0, meanItems, perSecond, orderMicros, maxMicros) && ok;
+    double poolCapacity = perSecond;
+    printf("%-7s %-14s %10.0f %14s %14s\n", "burst", "per order", perSecond, "-", "-");
+    ok = runRouter(orders, menu, prepMicros, 0, tickets, perSecond, orderMicros, maxMicros, stats) && ok;
+    printf("%-7s %-14s %10.0f %14s %14s\n", "burst", "per station", perSecond, "-", "-");
+    ok = runPoolRouter(orders, menu, prepMicros, 0, tickets, perSecond, orderMicros, maxMicros) && ok;
+    printf("%-7s %-14s %10.0f %14s %14s\n", "burst", "pool+stations", perSecond, "-", "-");
+
+    int gapMicros = static_cast<int>(2e6 / poolCapacity);  // Half the pool's capacity
+    ok = runPool(orders, prepMicros, gapMicros, meanItems, perSecond, orderMicros, maxMicros) && ok;
+    printf("%-7s %-14s %10.0f %14.0f %14lld  (estimated; max is the queue wait)\n", "paced",
+           "per order", perSecond, orderMicros, maxMicros);
+    ok = runRouter(orders, menu, prepMicros, gapMicros, tickets, perSecond, orderMicros, maxMicros,
+                   stats) && ok;
+    printf("%-7s %-14s %10.0f %14.0f %14lld\n", "paced", "per station", perSecond, orderMicros,
+           maxMicros);
+    ok = runPoolRouter(orders, menu, prepMicros, gapMicros, tickets, perSecond, orderMicros, maxMicros)
+         && ok;
+    printf("%-7s %-14s %10.0f %14.0f %14lld  (split into tickets on submit)\n", "paced",
+           "pool+stations", perSecond, orderMicros, maxMicros);
+
+    printf("\ntickets by station:");
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        printf(" %s %ld", MenuItem::getStationName(static_cast<PrepStation>(s)), stats.ticketsByStation[s]);
+    }
+    printf("\nevery order completed, tickets as expected: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+// This benchmark checks and times the order lifecycle stamps and the
+// ticket-time statistics of CompletedOrdersStack. It pushes a day's worth of
+// orders with log-normal wait and cook times, then checks that the streamed
+// mean, percentiles and max match the exact values computed from the sorted
+// times (percentiles within one bucket, 1/16). It pops a share of the orders
+// and checks again, then round-trips the stack through a binary snapshot and
+// decodes an order record in the format written before the stamps existed.
+// Finally it times push with the statistics against reading a percentile and
+// against recomputing it by sorting every ticket, the rescan the streaming
+// statistics replace. The program exits with a non-zero status if any check
+// fails.
+//
+// Build from the repository root:
+//   make ticket_stats_bench
+// Run:
+//   ./ticket_stats_bench [orders]
+
+//
+//  ticket_stats_bench.cpp
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+#include "TicketStats.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+static const long long DAY_START = 1700000000000LL;  // Any fixed epoch time in ms
+
+// Compares a streamed histogram with the exact times; prints one line.
+static bool checkStage(const char* name, const LatencyHistogram& h, vector<long long> exact) {
+    sort(exact.begin(), exact.end());
+    bool ok = h.getCount() == static_cast<long long>(exact.size());
+    double mean = 0;
+    for (size_t i = 0; i < exact.size(); ++i) {
+        mean += exact[i];
+    }
+    mean = exact.empty() ? 0 : mean / exact.size();
+    ok = ok && fabs(h.getMean() - mean) <= 1e-6 * (mean + 1);
+
+    const double fractions[] = {0.5, 0.9, 0.99};
+    double worst = 0;
+    for (int i = 0; i < 3 && !exact.empty(); ++i) {
+        long long rank = static_cast<long long>(fractions[i] * exact.size() + 0.5);
+        long long truth = exact[max(rank, 1LL) - 1];
+        long long streamed = h.getPercentile(fractions[i]);
+        double error = truth > 0 ? fabs(static_cast<double>(streamed - truth)) / truth : 0;
+        worst = max(worst, error);
+        ok = ok && (error <= 1.0 / LatencyHistogram::SUB_BUCKETS || streamed - truth <= 1);
+    }
+    printf("%-7s %8lld orders  mean %8.1f s  p50 %7.1f s  p99 %7.1f s  worst error %5.2f%%  %s\n",
+           name, h.getCount(), h.getMean() / 1000, h.getPercentile(0.5) / 1000.0,
+           h.getPercentile(0.99) / 1000.0, worst * 100, ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+// Checks the three stages of a stack against the stamps of its orders.
+static bool checkStack(CompletedOrdersStack& stack, const vector<Order>& orders, int count) {
+    vector<long long> waits, cooks, tickets;
+    long long late = 0;
+    const TicketStats stats = stack.getTicketStats();  // A copy taken under the stack's lock
+    for (int i = 0; i < count; ++i) {
+        const Order& o = orders[i];
+        waits.push_back(o.getStartedAt() - o.getPlacedAt());
+        cooks.push_back(o.getCompletedAt() - o.getStartedAt());
+        tickets.push_back(o.getCompletedAt() - o.getPlacedAt());
+        late += tickets.back() > stats.getTargetMillis();
+    }
+    bool ok = checkStage("wait", stats.getWaitTimes(), waits);
+    ok = checkStage("cook", stats.getCookTimes(), cooks) && ok;
+    ok = checkStage("ticket", stats.getTicketTimes(), tickets) && ok;
+    printf("late    %8lld of %d (exact %lld)\n", stats.getLateCount(), count, late);
+    return ok && stats.getLateCount() == late;
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 400000;
+    if (count < 10) {
+        count = 10;
+    }
+    DynamicArrayList menu(20);
+    for (int i = 1; i <= 20; ++i) {
+        menu.addMenuItem(MenuItem("Dish", "Benchmark item", 5.0 + i));
+    }
+
+    // A day of orders: arrivals over 12 hours, a few minutes in the queue,
+    // ten or so minutes at the stove, and a long tail on both.
+    mt19937_64 rng(11);
+    uniform_int_distribution<long long> arrival(0, 12 * 3600 * 1000LL);
+    lognormal_distribution<double> wait(log(120000.0), 0.9);
+    lognormal_distribution<double> cook(log(600000.0), 0.4);
+    vector<Order> orders(count);
+    for (int i = 0; i < count; ++i) {
+        const int ids[] = {1 + i % 20, 1 + (i * 7) % 20};
+        orders[i].addItems(ids, 2, menu);
+        orders[i].setOrderId(i + 1);
+        long long placed = DAY_START + arrival(rng);
+        long long started = placed + static_cast<long long>(wait(rng));
+        orders[i].markPlaced(placed);
+        orders[i].markStarted(started);
+        orders[i].markCompleted(started + static_cast<long long>(cook(rng)));
+    }
+
+    printf("sizeof(Order) = %zu bytes, lifecycle stamps included\n\n", sizeof(Order));
+
+    CompletedOrdersStack stack;
+    stack.setTicketTargetMillis(15 * 60000LL);
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < count; ++i) {
+        stack.push(orders[i]);
+    }
+    double pushNs = chrono::duration<double, nano>(Clock::now() - start).count() / count;
+
+    printf("after %d pushes:\n", count);
+    bool ok = checkStack(stack, orders, count);
+
+    int kept = count - count / 4;
+    for (int i = count; i > kept; --i) {
+        stack.pop();
+    }
+    printf("\nafter popping down to %d:\n", kept);
+    ok = checkStack(stack, orders, kept) && ok;
+
+    // A snapshot round trip rebuilds the statistics from the decoded stamps
+    string image;
+    stack.writeBinary(image);
+    CompletedOrdersStack restored;
+    restored.setTicketTargetMillis(15 * 60000LL);
+    BinaryReader reader(image);
+    bool decoded = restored.readBinary(reader, &menu);
+    printf("\nafter a snapshot round trip:\n");
+    ok = decoded && checkStack(restored, orders, kept) && ok;
+
+    // An order record from before the stamps: no tag in front, no stamps or priority behind
+    string record;
+    orders[0].writeBinary(record);
+    string oldRecord = record.substr(4, record.size() - 4 - 16 - 4);
+    BinaryReader oldReader(oldRecord);
+    Order oldOrder;
+    bool oldOk = oldOrder.readBinary(oldReader, &menu) && oldReader.remaining() == 0
+                 && oldOrder.getOrderId() == 1 && oldOrder.getPlacedAt() == -1
+                 && oldOrder.getCompletedAt() == -1
+                 && oldOrder.getTotalCents() == orders[0].getTotalCents();
+    printf("old-format order record: %s\n", oldOk ? "loads unstamped" : "FAILED");
+    ok = ok && oldOk;
+
+    // Reading the statistics against the rescan they replace
+    const int reads = 1000;
+    long long sink = 0;
+    start = Clock::now();
+    for (int i = 0; i < reads; ++i) {
+        sink += restored.getTicketStats().getTicketTimes().getPercentile(0.99);
+    }
+    double streamedUs = chrono::duration<double, micro>(Clock::now() - start).count() / reads;
+    start = Clock::now();
+    vector<long long> scan(kept);
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < kept; ++j) {
+            scan[j] = orders[j].getCompletedAt() - orders[j].getPlacedAt();
+        }
+        nth_element(scan.begin(), scan.begin() + kept * 99 / 100, scan.end());
+        sink += scan[kept * 99 / 100];
+    }
+    double rescanUs = chrono::duration<double, micro>(Clock::now() - start).count() / 10;
+
+    printf("\npush with stamps and statistics: %6.1f ns/order\n", pushNs);
+    printf("p99 from the histogram:          %9.2f us\n", streamedUs);
+    printf("p99 by rescanning %d orders: %9.2f us   (sink %lld)\n", kept, rescanUs, sink);
+    printf("\nticket statistics %s\n", ok ? "match the exact values" : "DO NOT MATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,498 @@
+// This program simulates restaurant traffic against the real DynamicArrayList,
+// Order, ActiveOrdersQueue and CompletedOrdersStack classes. Simulated time
+// follows a configurable traffic model; every operation the model triggers is
+// run on the real classes and its wall-clock time is measured:
+//   intake      build an order from the menu and enqueue it
+//   processing  dequeue the next order for a free cook, push it when cooked
+//   cancel      delete an order that has not been started
+//   reporting   the revenue summary (revenue, orders, average ticket, queue)
+// It prints the throughput and p50/p99/p999 latency of each operation, the
+// ticket times the simulated customers saw, and the headroom between the peak
+// arrival rate and the rate one core can sustain. Raise locations= to see
+// whether one server can carry the peak of several restaurants.
+//
+// Traffic model (all settable as key=value arguments):
+//   Orders arrive as a Poisson process whose rate follows the day: a base rate
+//   from opening at 10:00 to closing at 22:00, plus a lunch peak around 12:30
+//   and a dinner peak around 19:00 (Gaussian bumps, heights relative to the
+//   base rate). Basket sizes are 1 + Poisson(basket - 1) items, picked from
+//   the menu with Zipf popularity. A share of customers (cancel_rate) cancel
+//   after an exponential patience; cancels of orders already at a cook fail.
+//   Each order is cooked by the next free cook, taking exponential setup plus
+//   exponential time per item.
+//
+// Scheduling: a share of orders are delivery pickups (pickup_share) or VIP
+// tables (vip_share), and other single-item orders are quick orders. With
+// scheduling=2 (the default) the same traffic is run twice, once with the
+// queue in FIFO mode and once in priority mode with aging_minutes of waiting
+// worth one class, and the queue waits of each class are compared. Arrivals
+// and cooking times are drawn per order, so both runs see identical work.
+//
+// Build from the repository root:
+//   make traffic_sim
+// Run:
+//   ./traffic_sim [key=value ...]      (./traffic_sim help lists the keys)
+// For example, twenty locations on one server with a busier dinner:
+//   ./traffic_sim locations=20 dinner_peak=6
+// and a tight kitchen where scheduling matters, priority mode only:
+//   ./traffic_sim cooks=5 scheduling=1
+
+//
+//  traffic_sim.cpp
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ActiveOrdersQueue.h"
+#include "CompletedOrdersStack.h"
+#include "DynamicArrayList.h"
+#include "MenuItem.h"
+#include "Order.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+static const double OPEN_MINUTES = 12 * 60;      // 10:00 to 22:00
+static const double LUNCH_AT = 2.5 * 60;         // 12:30, minutes after opening
+static const double LUNCH_WIDTH = 40;
+static const double DINNER_AT = 9 * 60;          // 19:00
+static const double DINNER_WIDTH = 60;
+
+// The traffic model; every field can be set from the command line.
+struct TrafficModel {
+    double ordersPerDay;    // Expected orders per location and day
+    double lunchPeak;       // Height of the lunch peak over the base rate
+    double dinnerPeak;      // Height of the dinner peak over the base rate
+    double basket;          // Mean items per order
+    double cancelRate;      // Share of customers who try to cancel
+    double patience;        // Mean minutes before such a customer cancels
+    double setupSeconds;    // Mean setup time of an order
+    double itemSeconds;     // Mean cooking time per item
+    double cooks;           // Cooks per location
+    double locations;       // Restaurants served by this one system
+    double days;            // Days simulated
+    double reportMinutes;   // Minutes between revenue reports
+    double menuItems;       // Items on the menu
+    double pickupShare;     // Share of delivery pickup orders
+    double vipShare;        // Share of VIP table orders
+    double scheduling;      // 0 FIFO, 1 priority, 2 both
+    double agingMinutes;    // Waiting worth one priority class
+    double seed;
+};
+
+struct Setting {
+    const char* key;
+    double TrafficModel::*field;
+    double initial;
+    const char* help;
+};
+
+static const Setting SETTINGS[] = {
+    {"orders_per_day", &TrafficModel::ordersPerDay, 400, "expected orders per location and day"},
+    {"lunch_peak", &TrafficModel::lunchPeak, 3, "lunch peak height, times the base rate"},
+    {"dinner_peak", &TrafficModel::dinnerPeak, 4, "dinner peak height, times the base rate"},
+    {"basket", &TrafficModel::basket, 2.5, "mean items per order"},
+    {"cancel_rate", &TrafficModel::cancelRate, 0.03, "share of customers who try to cancel"},
+    {"patience", &TrafficModel::patience, 4, "mean minutes before a cancel"},
+    {"setup_seconds", &TrafficModel::setupSeconds, 60, "mean setup time per order"},
+    {"item_seconds", &TrafficModel::itemSeconds, 90, "mean cooking time per item"},
+    {"cooks", &TrafficModel::cooks, 8, "cooks per location"},
+    {"locations", &TrafficModel::locations, 1, "restaurants served by one system"},
+    {"days", &TrafficModel::days, 250, "days simulated"},
+    {"report_minutes", &TrafficModel::reportMinutes, 15, "minutes between revenue reports"},
+    {"menu_items", &TrafficModel::menuItems, 60, "items on the menu"},
+    {"pickup_share", &TrafficModel::pickupShare, 0.1, "share of delivery pickup orders"},
+    {"vip_share", &TrafficModel::vipShare, 0.05, "share of VIP table orders"},
+    {"scheduling", &TrafficModel::scheduling, 2, "0 FIFO, 1 priority with aging, 2 compare both"},
+    {"aging_minutes", &TrafficModel::agingMinutes, 5, "minutes of waiting worth one priority class"},
+    {"seed", &TrafficModel::seed, 42, "random seed"},
+};
+static const int SETTING_COUNT = sizeof(SETTINGS) / sizeof(SETTINGS[0]);
+
+// Kinds of simulated events, in the order they run when they fall on the same time.
+enum EventType { COOKED, ARRIVAL, CANCEL, REPORT };
+
+struct Event {
+    double at;       // Minutes since the first opening
+    EventType type;
+    int orderId;     // ID of the order for COOKED and CANCEL
+    int cook;        // Cook that finished, for COOKED
+
+    bool operator>(const Event& other) const {
+        return at != other.at ? at > other.at : type > other.type;
+    }
+};
+
+// Wall-clock latencies of one kind of operation, in nanoseconds.
+struct Latencies {
+    vector<double> samples;
+    double totalNs = 0;
+
+    void add(double ns) {
+        samples.push_back(ns);
+        totalNs += ns;
+    }
+};
+
+// Everything one simulated run measures.
+struct Run {
+    Latencies intake, processing, cancel, reporting;
+    vector<double> waitMinutes[PRIORITY_LEVELS];  // Queue wait of each priority class
+    vector<double> ticketMinutes;
+    long arrived = 0, cancelled = 0, cancelsTooLate = 0, reports = 0;
+    int maxQueue = 0;
+    double busiestMinute = 0;   // Arrivals in the busiest minute of the run
+    double peakPerMinute = 0;   // Peak of the arrival rate
+    double checksum = 0;
+    double wallSeconds = 0;
+    bool balanced = false;
+};
+
+static double elapsedNs(Clock::time_point start) {
+    return chrono::duration<double, nano>(Clock::now() - start).count();
+}
+
+// The p-th quantile of sorted samples.
+static double quantile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(ceil(p * sorted.size()));
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void printLatencies(const char* name, Latencies& latencies) {
+    vector<double>& s = latencies.samples;
+    sort(s.begin(), s.end());
+    double mean = s.empty() ? 0 : latencies.totalNs / s.size();
+    printf("%-11s %9zu %12.0f %9.2f %9.2f %9.2f %9.2f %9.2f\n", name, s.size(),
+           mean > 0 ? 1e9 / mean : 0, mean / 1000, quantile(s, 0.5) / 1000,
+           quantile(s, 0.99) / 1000, quantile(s, 0.999) / 1000, s.empty() ? 0 : s.back() / 1000);
+}
+
+// Relative arrival rate at `minute` after opening; 1 is the base rate.
+static double dayShape(const TrafficModel& model, double minute) {
+    double lunch = (minute - LUNCH_AT) / LUNCH_WIDTH;
+    double dinner = (minute - DINNER_AT) / DINNER_WIDTH;
+    return 1 + model.lunchPeak * exp(-0.5 * lunch * lunch)
+             + model.dinnerPeak * exp(-0.5 * dinner * dinner);
+}
+
+static void usage() {
+    printf("usage: traffic_sim [key=value ...]\n");
+    for (int i = 0; i < SETTING_COUNT; ++i) {
+        printf("  %-15s %-8g %s\n", SETTINGS[i].key, SETTINGS[i].initial, SETTINGS[i].help);
+    }
+}
+
+static bool parseModel(int argc, char* argv[], TrafficModel& model) {
+    for (int i = 0; i < SETTING_COUNT; ++i) {
+        model.*SETTINGS[i].field = SETTINGS[i].initial;
+    }
+    for (int a = 1; a < argc; ++a) {
+        const char* equals = strchr(argv[a], '=');
+        int found = -1;
+        for (int i = 0; equals != NULL && i < SETTING_COUNT; ++i) {
+            if (strncmp(argv[a], SETTINGS[i].key, equals - argv[a]) == 0
+                && SETTINGS[i].key[equals - argv[a]] == '\0') {
+                found = i;
+            }
+        }
+        char* end = NULL;
+        double value = found >= 0 ? strtod(equals + 1, &end) : 0;
+        if (found < 0 || *end != '\0' || value < 0) {
+            fprintf(stderr, "bad argument: %s\n", argv[a]);
+            return false;
+        }
+        model.*SETTINGS[found].field = value;
+    }
+    if (model.ordersPerDay <= 0 || model.basket < 1 || model.cancelRate > 1 || model.cooks < 1
+        || model.locations < 1 || model.days < 1 || model.reportMinutes <= 0
+        || model.menuItems < 1 || model.patience <= 0
+        || model.pickupShare + model.vipShare > 1 || model.scheduling > 2) {
+        fprintf(stderr, "orders_per_day, basket, cooks, locations, days, report_minutes, "
+                        "menu_items and patience must be positive (basket at least 1), "
+                        "cancel_rate and pickup_share + vip_share at most 1, "
+                        "scheduling 0, 1 or 2\n");
+        return false;
+    }
+    return true;
+}
+
+// Simulates every day of the model with the queue in the given scheduling mode.
+static void simulate(const TrafficModel& model, SchedulingMode mode, Run& run) {
+    // Arrivals and the work of each order come from their own stream, so two
+    // runs with different scheduling see exactly the same orders.
+    mt19937_64 rng(static_cast<unsigned long long>(model.seed));
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    poisson_distribution<int> extraItems(model.basket - 1);
+    exponential_distribution<double> patience(1.0 / model.patience);
+    exponential_distribution<double> setup(60.0 / max(model.setupSeconds, 1e-9));
+    exponential_distribution<double> perItem(60.0 / max(model.itemSeconds, 1e-9));
+
+    // Menu with Zipf popularity: item k is ordered in proportion to 1/k.
+    int menuItems = static_cast<int>(model.menuItems);
+    DynamicArrayList menu(menuItems);
+    vector<double> weights(menuItems);
+    for (int k = 1; k <= menuItems; ++k) {
+        menu.addMenuItem(MenuItem("Dish " + to_string(k), "House special", 4 + k % 17 + 0.25 * (k % 4)));
+        weights[k - 1] = 1.0 / k;
+    }
+    discrete_distribution<int> popularity(weights.begin(), weights.end());
+
+    // Arrival rate per minute is scale * dayShape(t); thinning draws it from a constant peak rate.
+    double area = 0, peakShape = 0;
+    for (double t = 0; t < OPEN_MINUTES; t += 0.25) {
+        double shape = dayShape(model, t + 0.125);
+        area += shape * 0.25;
+        peakShape = max(peakShape, shape);
+    }
+    double scale = model.ordersPerDay * model.locations / area;
+    double peakRate = scale * peakShape * 1.01;
+    exponential_distribution<double> candidateGap(peakRate);
+    run.peakPerMinute = scale * peakShape;
+
+    int cooks = static_cast<int>(model.cooks * model.locations);
+    int days = static_cast<int>(model.days);
+    ActiveOrdersQueue activeOrders;
+    activeOrders.setSchedulingMode(mode, static_cast<long long>(model.agingMinutes * 60000));
+    CompletedOrdersStack completedOrders;
+    vector<double> arrivedAt(1, 0.0);     // By order ID; IDs start at 1
+    vector<double> startedAt(1, 0.0);     // -1 until a cook takes the order
+    vector<double> cookMinutes(1, 0.0);   // Drawn when the order arrives
+    vector<Order> atCook(cooks);          // The order each cook is working on
+    vector<double> dequeueNs(cooks);      // First half of that order's processing sample
+    vector<int> freeCooks;
+    vector<int> ids;
+
+    Clock::time_point simStart = Clock::now();
+    for (int day = 0; day < days; ++day) {
+        double opening = day * 24 * 60.0;
+        priority_queue<Event, vector<Event>, greater<Event> > events;
+        freeCooks.clear();
+        for (int c = cooks - 1; c >= 0; --c) {
+            freeCooks.push_back(c);
+        }
+        Event first = {opening + candidateGap(rng), ARRIVAL, 0, 0};
+        events.push(first);
+        for (double t = model.reportMinutes; t <= OPEN_MINUTES; t += model.reportMinutes) {
+            Event report = {opening + t, REPORT, 0, 0};
+            events.push(report);
+        }
+        double minuteStart = opening;
+        int minuteArrivals = 0;
+
+        while (!events.empty()) {
+            Event event = events.top();
+            events.pop();
+            double now = event.at;
+
+            if (event.type == ARRIVAL) {
+                if (now - opening >= OPEN_MINUTES) {
+                    continue;  // Closed; the kitchen finishes what is queued
+                }
+                Event nextArrival = {now + candidateGap(rng), ARRIVAL, 0, 0};
+                events.push(nextArrival);
+                if (uniform(rng) * peakShape * 1.01 > dayShape(model, now - opening)) {
+                    continue;  // Thinned out: the rate is below the peak now
+                }
+                int count = 1 + extraItems(rng);
+                ids.resize(count);
+                for (int i = 0; i < count; ++i) {
+                    ids[i] = 1 + popularity(rng);
+                }
+                double kind = uniform(rng);
+                OrderPriority priority = kind < model.pickupShare ? PRIORITY_PICKUP
+                                         : kind < model.pickupShare + model.vipShare ? PRIORITY_VIP
+                                         : count == 1 ? PRIORITY_QUICK : PRIORITY_NORMAL;
+                double minutes = setup(rng);
+                for (int i = 0; i < count; ++i) {
+                    minutes += perItem(rng);
+                }
+                bool leaves = uniform(rng) < model.cancelRate;
+                double leaveAfter = patience(rng);
+
+                Clock::time_point start = Clock::now();
+                Order order("Guest " + to_string(run.arrived % 1000));
+                order.addItems(ids.data(), count, menu);
+                order.setPriority(priority);
+                int orderId = activeOrders.enqueue(std::move(order));
+                run.intake.add(elapsedNs(start));
+                // Scheduling ages orders by their placed time, so it must be simulated time
+                activeOrders.findOrder(orderId)->markPlaced(llround(now * 60000));
+
+                run.arrived++;
+                arrivedAt.push_back(now);
+                startedAt.push_back(-1);
+                cookMinutes.push_back(minutes);
+                run.maxQueue = max(run.maxQueue, activeOrders.getSize());
+                if (now - minuteStart >= 1) {
+                    minuteStart = now;
+                    minuteArrivals = 0;
+                }
+                run.busiestMinute = max(run.busiestMinute, static_cast<double>(++minuteArrivals));
+                if (leaves) {
+                    Event leave = {now + leaveAfter, CANCEL, orderId, 0};
+                    events.push(leave);
+                }
+            } else if (event.type == CANCEL) {
+                if (startedAt[event.orderId] >= 0) {
+                    run.cancelsTooLate++;  // A cook has it already
+                    continue;
+                }
+                Clock::time_point start = Clock::now();
+                bool deleted = activeOrders.deleteOrder(event.orderId);
+                run.cancel.add(elapsedNs(start));
+                run.cancelled += deleted;
+            } else if (event.type == COOKED) {
+                Order& cooked = atCook[event.cook];
+                int orderId = cooked.getOrderId();
+                cooked.markCompleted(llround(now * 60000));  // Push keeps this time
+                Clock::time_point start = Clock::now();
+                cooked.setStatus("completed");
+                completedOrders.push(std::move(cooked));
+                run.processing.add(dequeueNs[event.cook] + elapsedNs(start));
+                run.ticketMinutes.push_back(now - arrivedAt[orderId]);
+                freeCooks.push_back(event.cook);
+            } else {
+                Clock::time_point start = Clock::now();
+                run.checksum += completedOrders.calculateTotalRevenue() + completedOrders.getSize()
+                                + completedOrders.getAverageTicket() + activeOrders.getSize();
+                run.reporting.add(elapsedNs(start));
+                run.reports++;
+            }
+
+            // Free cooks take the orders the queue schedules next.
+            while (!freeCooks.empty() && !activeOrders.isEmpty()) {
+                int cook = freeCooks.back();
+                freeCooks.pop_back();
+                Clock::time_point start = Clock::now();
+                activeOrders.dequeue(atCook[cook]);
+                dequeueNs[cook] = elapsedNs(start);
+
+                Order& started = atCook[cook];
+                int orderId = started.getOrderId();
+                started.markPlaced(llround(arrivedAt[orderId] * 60000));  // Restamp in simulated time
+                started.markStarted(llround(now * 60000));
+                startedAt[orderId] = now;
+                run.waitMinutes[started.getPriority()].push_back(now - arrivedAt[orderId]);
+                Event done = {now + cookMinutes[orderId], COOKED, orderId, cook};
+                events.push(done);
+            }
+        }
+    }
+    run.wallSeconds = chrono::duration<double>(Clock::now() - simStart).count();
+    run.balanced = activeOrders.isEmpty()
+                   && completedOrders.getSize() + run.cancelled == run.arrived
+                   && completedOrders.getTotalRevenueCents()
+                      == completedOrders.recalculateTotalRevenueCents();
+}
+
+// Prints the queue waits of the priority classes first through last.
+static void printWaits(const char* policy, const char* name, const Run& run, int first, int last) {
+    vector<double> waits;
+    for (int p = first; p <= last; ++p) {
+        waits.insert(waits.end(), run.waitMinutes[p].begin(), run.waitMinutes[p].end());
+    }
+    sort(waits.begin(), waits.end());
+    double mean = 0;
+    for (size_t i = 0; i < waits.size(); ++i) {
+        mean += waits[i];
+    }
+    mean = waits.empty() ? 0 : mean / waits.size();
+    printf("%-9s %-8s %9zu %9.2f %9.1f %9.1f %9.1f %9.1f\n", policy, name, waits.size(), mean,
+           quantile(waits, 0.5), quantile(waits, 0.99), quantile(waits, 0.999),
+           waits.empty() ? 0 : waits.back());
+}
+
+// Prints what one run measured.
+static void printRun(const char* policy, Run& run, int days) {
+    printf("=== %s scheduling ===\n", policy);
+    printf("simulated %d days: %ld orders, %ld cancelled (%ld too late), %ld reports\n", days,
+           run.arrived, run.cancelled, run.cancelsTooLate, run.reports);
+    printf("peak arrival rate %.1f orders/min (busiest minute %.0f), longest queue %d orders\n",
+           run.peakPerMinute, run.busiestMinute, run.maxQueue);
+    printf("wall time %.2f s for the whole run\n\n", run.wallSeconds);
+
+    printf("%-11s %9s %12s %9s %9s %9s %9s %9s\n", "operation", "count", "ops/s", "mean us",
+           "p50 us", "p99 us", "p999 us", "max us");
+    printLatencies("intake", run.intake);
+    printLatencies("processing", run.processing);
+    printLatencies("cancel", run.cancel);
+    printLatencies("reporting", run.reporting);
+
+    vector<double> waits;
+    for (int p = 0; p < PRIORITY_LEVELS; ++p) {
+        waits.insert(waits.end(), run.waitMinutes[p].begin(), run.waitMinutes[p].end());
+    }
+    sort(waits.begin(), waits.end());
+    sort(run.ticketMinutes.begin(), run.ticketMinutes.end());
+    printf("\n%-11s %9s %9s %9s %9s\n", "customers", "p50 min", "p99 min", "p999 min", "max min");
+    printf("%-11s %9.1f %9.1f %9.1f %9.1f\n", "queue wait", quantile(waits, 0.5),
+           quantile(waits, 0.99), quantile(waits, 0.999), waits.empty() ? 0 : waits.back());
+    printf("%-11s %9.1f %9.1f %9.1f %9.1f\n", "ticket time", quantile(run.ticketMinutes, 0.5),
+           quantile(run.ticketMinutes, 0.99), quantile(run.ticketMinutes, 0.999),
+           run.ticketMinutes.empty() ? 0 : run.ticketMinutes.back());
+
+    // One core must take each order in, and process it, before the next one arrives at the peak.
+    double nsPerOrder = (run.intake.totalNs + run.processing.totalNs + run.cancel.totalNs) / max(run.arrived, 1L)
+                        + run.reporting.totalNs / max(run.arrived, 1L);
+    double capacity = 1e9 / nsPerOrder;
+    double peakPerSecond = run.peakPerMinute / 60;
+    printf("\none core sustains %.0f orders/s; the peak needs %.2f orders/s (headroom %.0fx)\n",
+           capacity, peakPerSecond, capacity / peakPerSecond);
+    printf("every order completed or cancelled, revenue consistent: %s  (checksum %.0f)\n\n",
+           run.balanced ? "yes" : "NO", run.checksum);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && (strcmp(argv[1], "help") == 0 || strcmp(argv[1], "--help") == 0)) {
+        usage();
+        return 0;
+    }
+    TrafficModel model;
+    if (!parseModel(argc, argv, model)) {
+        usage();
+        return 1;
+    }
+
+    printf("model:");
+    for (int i = 0; i < SETTING_COUNT; ++i) {
+        printf(" %s=%g", SETTINGS[i].key, model.*SETTINGS[i].field);
+    }
+    printf("\n\n");
+
+    const char* const policies[] = {"fifo", "priority"};
+    const SchedulingMode modes[] = {SCHEDULE_FIFO, SCHEDULE_PRIORITY};
+    int scheduling = static_cast<int>(model.scheduling);
+    int firstPolicy = scheduling == 1 ? 1 : 0;
+    int lastPolicy = scheduling == 0 ? 0 : 1;
+    Run runs[2];
+    bool balanced = true;
+    for (int p = firstPolicy; p <= lastPolicy; ++p) {
+        simulate(model, modes[p], runs[p]);
+        printRun(policies[p], runs[p], static_cast<int>(model.days));
+        balanced = balanced && runs[p].balanced;
+    }
+
+    printf("queue wait by priority class, minutes\n");
+    printf("%-9s %-8s %9s %9s %9s %9s %9s %9s\n", "policy", "class", "orders", "mean",
+           "p50", "p99", "p999", "max");
+    for (int p = firstPolicy; p <= lastPolicy; ++p) {
+        for (int level = PRIORITY_LEVELS - 1; level >= 0; --level) {
+            printWaits(policies[p], Order::getPriorityName(static_cast<OrderPriority>(level)),
+                       runs[p], level, level);
+        }
+        printWaits(policies[p], "all", runs[p], 0, PRIORITY_LEVELS - 1);
+    }
+    return balanced ? 0 : 1;
+}
@@ -3,7 +3,9 @@
 //users to manage a dynamic menu, handle active and completed orders, and
 //calculate total revenue. It provides functionalities such as adding,
 //deleting, and resetting menu items, managing customer orders, processing
-//orders, and saving completed orders to a file
+//orders, and saving completed orders to a file.
+//Run with --batch [file] to execute a command stream (see BatchRunner.h)
+//from the file or standard input instead of the interactive menu.
 
 //
 //  main.cpp
@@ -11,17 +13,40 @@
 //
  
 
+#include <chrono>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #include "DynamicArrayList.h"       // Header for managing the restaurant's menu.
 #include "ActiveOrdersQueue.h"      // Header for handling active orders using a queue.
 #include "MenuItem.h"               // Header defining the structure and attributes of menu items.
 #include "CompletedOrdersStack.h"   // Header for managing completed orders using a stack.
 #include "Order.h"                  // Header for managing individual orders.
+#include "MenuJournal.h"            // Header for journaling menu edits.
+#include "AppendOnlyLog.h"          // Header for the binary completed-order log.
+#include "SystemSnapshot.h"         // Header for saving and restoring the whole system.
+#include "OrderWAL.h"               // Header for the active-order write-ahead log.
+#include "ConcurrentOrdersQueue.h"  // Header for the queue of orders handed to the kitchen.
+#include "KitchenWorkerPool.h"      // Header for the kitchen worker threads.
+#include "StationRouter.h"          // Header for the per-station kitchen queues.
+#include "BatchRunner.h"            // Header for the non-interactive command mode.
+#include "OperationStats.h"         // Header for the per-operation latency statistics.
 
 using namespace std;
 
+const string MENU_FILE = "/Users/reine/Downloads/menu.txt";  // Menu snapshot file.
+const string ORDER_LOG_FILE = "/Users/reine/Downloads/completedOrders.log";  // Binary completed-order log.
+const string ORDER_REPORT_FILE = "/Users/reine/Downloads/completedOrders.txt"; // Text report.
+const string SNAPSHOT_FILE = "/Users/reine/Downloads/system.snapshot";        // Binary system snapshot.
+const string ORDER_WAL_FILE = "/Users/reine/Downloads/activeOrders.wal";      // Active-order write-ahead log.
+const string STATS_FILE = "/Users/reine/Downloads/stats.json";                // Operation statistics dump.
+const int TICKET_TARGET_MINUTES = 15;  // Orders taking longer count as late.
+const int KITCHEN_WORKERS = 2;         // Threads routing orders queued for the kitchen.
+
 // Displays the main menu for the Restaurant Order Management System.
 void showMenu() {
     cout << "\n--- Restaurant Order Management System ---\n";
@@ -36,20 +61,119 @@ void showMenu() {
     cout << "9. Calculate Total Amount of Sold Orders\n";
     cout << "10. Save Completed Orders to File\n";
     cout << "11. Exit\n";
+    cout << "12. Change Menu Item Price\n";
+    cout << "13. Save System Snapshot\n";
+    cout << "14. Show Operation Statistics\n";
+    cout << "15. Show Ticket Times\n";
+    cout << "16. Change Order Scheduling\n";
+    cout << "17. Search Menu\n";
+    cout << "18. Find Menu Items by Price\n";
     cout << "Enter your choice: ";
 }
 
-int main() {
+// Saves everything that must survive until the next session.
+void shutDown(KitchenWorkerPool& kitchen, MenuJournal& menuJournal, AppendOnlyLog& orderLog,
+              SystemSnapshot& snapshot, OrderWAL& orderWal) {
+    kitchen.shutdown();                // Every processed order is on the stack.
+    menuJournal.compact();             // Fold the journal into the menu file.
+    menuJournal.waitForCompaction();
+    orderLog.close();                  // Write and sync the last batch of orders.
+    snapshot.save(SNAPSHOT_FILE);      // Keep the orders for the next session.
+    if (snapshot.waitForSave()) {
+        orderWal.checkpoint();         // Its changes are in the snapshot now.
+    } else {
+        cout << "Failed to save the system snapshot.\n";
+    }
+    orderWal.close();
+}
+
+int main(int argc, char* argv[]) {
+    bool batchMode = argc > 1 && string(argv[1]) == "--batch";
+    if (batchMode) {
+        ios::sync_with_stdio(false);   // Buffered output; nobody is waiting for a prompt.
+    }
+
     // Initialize main system components.
     DynamicArrayList menu(10);             // Menu is managed using a dynamic array.
     ActiveOrdersQueue activeOrders;        // Active orders are handled in a queue.
+    AppendOnlyLog orderLog;                // Completed orders are streamed to a binary log.
     CompletedOrdersStack completedOrders;  // Completed orders are stored in a stack.
+    completedOrders.setTicketTargetMillis(TICKET_TARGET_MINUTES * 60000LL);
+    MenuJournal menuJournal(menu, MENU_FILE); // Menu edits are appended to a journal.
+    SystemSnapshot snapshot(menu, activeOrders, completedOrders); // Whole-system save and restore.
+    // Order changes are logged before they are acknowledged. A batch replays
+    // a whole day, so it commits the log in groups and holds back each
+    // group's results until the group is on disk.
+    OrderWAL orderWal(ORDER_WAL_FILE, FSYNC_EACH_COMMIT, 0, batchMode ? BatchRunner::ACK_GROUP_SIZE : 1);
+
+    // Restore the orders and menu of the last session. The menu file and its
+    // journal are checked afterwards and win if they changed since.
+    if (snapshot.load(SNAPSHOT_FILE)) {
+        cout << "Restored " << activeOrders.getSize() << " active and "
+             << completedOrders.getSize() << " completed orders." << endl;
+    }
+
+    // Stream completed orders to the log as they are pushed. It is attached
+    // before replay so orders completed after the snapshot reach it too; the
+    // ones it already holds are not appended again.
+    unordered_set<int> loggedIds;
+    CompletedOrdersStack::readLoggedOrderIds(ORDER_LOG_FILE, loggedIds);  // None for a new log
+    if (orderLog.open(ORDER_LOG_FILE)) {
+        completedOrders.setOrderLog(&orderLog);
+    } else {
+        cout << "Completed orders will not be logged." << endl;
+    }
 
-    // Load the menu from a file and notify if loading fails.
-    if (!menu.loadMenuFromFile("/Users/reine/Downloads/menu.txt")) {
+    // Replay the order changes made after that snapshot.
+    if (orderWal.recover(activeOrders, completedOrders, &menu, &loggedIds)) {
+        if (orderWal.getReplayedCount() > 0) {
+            cout << "Recovered " << orderWal.getReplayedCount() << " order changes from the log." << endl;
+        }
+    } else {
+        cout << "Order changes will not be logged." << endl;
+    }
+
+    // Load the menu from its snapshot and journal and notify if loading fails.
+    if (!menuJournal.recover()) {
         cout << "Failed to load Menu" << endl;
     }
 
+    // Processed orders are split into station tickets as they are handed to
+    // the kitchen. The stations prepare them in parallel and push the order
+    // onto the completed stack while the next command runs. The router reads
+    // the menu, so menu edits wait until the kitchen is idle.
+    ConcurrentOrdersQueue kitchenQueue;
+    StationRouter stations(menu, completedOrders);
+    KitchenWorkerPool kitchen(kitchenQueue, stations, KITCHEN_WORKERS);
+    kitchen.setOrderWAL(&orderWal);  // Orders are logged as processed once the stations finish them.
+    stations.start();
+    kitchen.start();
+
+    // Batch mode: run the command stream and save, without the menu.
+    if (batchMode) {
+        BatchRunner runner(menu, activeOrders, completedOrders);
+        runner.setMenuJournal(&menuJournal);
+        runner.setOrderWAL(&orderWal);
+        runner.setKitchen(&kitchen);
+        runner.setReportFiles(&orderLog, ORDER_LOG_FILE, ORDER_REPORT_FILE);
+        ifstream file;
+        if (argc > 2) {
+            file.open(argv[2]);
+            if (!file) {
+                cerr << "Cannot open command file: " << argv[2] << endl;
+                shutDown(kitchen, menuJournal, orderLog, snapshot, orderWal);
+                return 1;
+            }
+        }
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int errors = runner.run(argc > 2 ? static_cast<istream&>(file) : cin, cout);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << runner.getCommandCount() << " commands, " << errors << " errors, "
+             << seconds << " s" << endl;
+        shutDown(kitchen, menuJournal, orderLog, snapshot, orderWal);
+        return errors == 0 ? 0 : 1;
+    }
+
     int choice;  // Variable for storing user input.
     do {
         showMenu();  // Display the main menu.
@@ -66,8 +190,11 @@ int main() {
 
         switch (choice) {
             case 1: // Display the menu.
-                if (menu.loadMenuFromFile("/Users/reine/Downloads/menu.txt")) {
+                kitchen.waitUntilIdle();      // refresh may reload the menu the stations read.
+                if (menuJournal.refresh()) {  // Reads the file only if it changed.
                     menu.displayMenu();
+                    cout << "(menu file reloads: " << menu.getReloadCount()
+                         << ", avoided: " << menu.getReloadsAvoided() << ")\n";
                 } else {
                     cout << "Failed to load the menu.\n";
                 }
@@ -98,25 +225,34 @@ int main() {
                 }
                 cin.ignore();
 
-                // Add the item to the menu and save to file.
-                menu.addMenuItem(MenuItem(name, description, price));
+                // Any answer that is not a station leaves the item on the line.
+                string stationName;
+                PrepStation station = STATION_LINE;
+                cout << "Station (line, grill, fryer, cold, bar): ";
+                getline(cin, stationName);
+                MenuItem::parseStation(stationName, station);
+
+                // Add the item to the menu and append it to the journal.
+                kitchen.waitUntilIdle();
+                int id = menu.addMenuItem(MenuItem(name, description, price, station));
                 cout << "Menu item added successfully.\n";
-                menu.saveMenuToFile("/Users/reine/Downloads/menu.txt");  // Save to file.
+                menuJournal.recordAdd(*menu.findMenuItem(id));
                 break;
             }
 
             case 3: // Delete a menu item by ID.
             {
-                menu.loadMenuFromFile("/Users/reine/Downloads/menu.txt");  // Reload menu.
+                kitchen.waitUntilIdle();
+                menuJournal.refresh();  // Reload menu if the file changed.
                 int id;
                 cout << "Enter the ID of the menu item to delete: ";
                 cin >> id;
                 cin.ignore();
 
-                // Attempt to delete the item and save changes.
+                // Attempt to delete the item and journal the change.
                 if (menu.deleteMenuItem(id)) {
                     cout << "Menu item deleted successfully.\n";
-                    menu.saveMenuToFile("/Users/reine/Downloads/menu.txt");
+                    menuJournal.recordDelete(id);
                 } else {
                     cout << "Menu item not found.\n";
                 }
@@ -124,8 +260,12 @@ int main() {
             }
 
             case 4: // Reset the menu to its initial state.
-                menu.resetMenu("/Users/reine/Downloads/menu.txt");
-                cout << "Menu reset successfully.\n";
+                kitchen.waitUntilIdle();
+                if (menuJournal.reset()) {         // Menu, menu file and journal together.
+                    cout << "Menu reset successfully.\n";
+                } else {
+                    cout << "Failed to reset the menu file.\n";
+                }
                 break;
 
             case 5: // Add a new order.
@@ -137,12 +277,11 @@ int main() {
 
                 int itemIds[30]; // Array to store item IDs (max capacity 30).
                 int itemId, itemCount = 0;
-                double totalPrice = 0.0;
 
                 cout << "Enter item IDs (0 to finish): ";
                 while (cin >> itemId && itemId != 0 && itemCount < 30) {
                     // Validate item ID input.
-                    while (cin.fail() || itemId < 0 || itemId > menu.getSize()) {
+                    while (cin.fail() || itemId < 0 || (itemId != 0 && menu.findMenuItem(itemId) == NULL)) {
                         cin.clear();
                         cin.ignore(10000, '\n');
                         cout << "Invalid index. Please try again." << endl;
@@ -152,19 +291,24 @@ int main() {
                     itemIds[itemCount++] = itemId;
                 }
 
+                int priority;
+                cout << "Enter priority (0 normal, 1 quick, 2 VIP, 3 pickup): ";
+                if (!(cin >> priority) || priority < 0 || priority >= PRIORITY_LEVELS) {
+                    cin.clear();
+                    cin.ignore(10000, '\n');
+                    priority = PRIORITY_NORMAL;  // Anything else is a normal order.
+                }
+
                 Order order(customerName);  // Create a new order.
-                for (int i = 0; i < itemCount; i++) {
-                    int id = itemIds[i];
-                    MenuItem* item = menu.findMenuItem(id);
-                    if (item) {
-                        order.addItem(id, *item, menu);
-                        totalPrice += item->getPrice();
-                    } else {
-                        cout << "Item with ID " << id << " not found in menu.\n";
-                    }
+                order.setPriority(static_cast<OrderPriority>(priority));
+                int added = order.addItems(itemIds, itemCount, menu);  // All items in one call.
+                if (added < itemCount) {
+                    cout << (itemCount - added) << " item(s) not found in menu.\n";
                 }
 
-                activeOrders.enqueue(order);  // Add order to the queue.
+                double totalPrice = order.getTotalPrice();
+                int orderId = activeOrders.enqueue(std::move(order));  // Move the order into the queue.
+                orderWal.recordEnqueue(*activeOrders.findOrder(orderId));  // Logged before it is confirmed.
                 cout << "Order added successfully.\n";
                 cout << "Total Price: $" << totalPrice << endl;
                 break;
@@ -174,9 +318,8 @@ int main() {
             {
                 Order processedOrder;
                 if (activeOrders.dequeue(processedOrder)) {
-                    processedOrder.setStatus("completed");
-                    completedOrders.push(processedOrder);
-                    cout << "Order processed successfully.\n";
+                    kitchen.submit(std::move(processedOrder));  // Split into station tickets now; logged once done.
+                    cout << "Order sent to the kitchen.\n";
                 } else {
                     cout << "No active orders to process.\n";
                 }
@@ -184,6 +327,7 @@ int main() {
             }
 
             case 7: // Display active and completed orders.
+                kitchen.waitUntilIdle();  // Show the orders just processed as completed.
                 cout << "--- Active Orders ---\n";
                 activeOrders.displayActiveOrders();
                 cout << "--- Completed Orders ---\n";
@@ -197,7 +341,7 @@ int main() {
                 cin >> orderId;
 
                 // Validate order ID.
-                while (cin.fail() || orderId < 0 || orderId > activeOrders.getSize()) {
+                while (cin.fail() || orderId < 0) {
                     cin.clear();
                     cin.ignore(10000, '\n');
                     cout << "Invalid order ID. Please try again.\n";
@@ -206,6 +350,7 @@ int main() {
 
                 // Attempt to delete the order.
                 if (activeOrders.deleteOrder(orderId)) {
+                    orderWal.recordCancel(orderId);
                     cout << "Order deleted successfully.\n";
                 } else {
                     cout << "Order not found.\n";
@@ -215,6 +360,7 @@ int main() {
 
             case 9: // Calculate and display total revenue from completed orders.
             {
+                kitchen.waitUntilIdle();
                 double totalRevenue = completedOrders.calculateTotalRevenue();
                 cout << "--- Total Revenue ---\n";
                 if (completedOrders.isEmpty()) {
@@ -222,21 +368,161 @@ int main() {
                 }
                 completedOrders.displayOrderPrice();
                 cout << "Total Sold: $" << totalRevenue << endl;
+                cout << "Orders: " << completedOrders.getSize()
+                     << ", Items: " << completedOrders.getTotalItemCount()
+                     << ", Average Ticket: $" << completedOrders.getAverageTicket() << endl;
                 break;
             }
 
             case 10: // Save completed orders to a file.
-                if (completedOrders.saveCompletedOrdersToFile("/Users/reine/Downloads/completedOrders.txt")) {
+            {
+                kitchen.waitUntilIdle();
+                bool saved;
+                if (orderLog.isOpen()) {
+                    orderLog.sync();  // Every logged order is on disk before the report is built.
+                    saved = CompletedOrdersStack::saveLogReportToFile(ORDER_LOG_FILE, ORDER_REPORT_FILE, &menu);
+                } else {
+                    saved = completedOrders.saveCompletedOrdersToFile(ORDER_REPORT_FILE);
+                }
+                if (saved) {
                     cout << "Orders saved successfully!\n";
                 } else {
                     cout << "Error saving completed orders.\n";
                 }
                 break;
+            }
 
             case 11: // Exit the program.
+                shutDown(kitchen, menuJournal, orderLog, snapshot, orderWal);
                 cout << "Exiting the program... Goodbye!\n";
                 break;
 
+            case 12: // Change the price of a menu item.
+            {
+                kitchen.waitUntilIdle();
+                menuJournal.refresh();  // Reload menu if the file changed.
+                int id;
+                double price;
+                cout << "Enter the ID of the menu item: ";
+                cin >> id;
+                cout << "New price in $: ";
+                cin >> price;
+                if (cin.fail()) {
+                    cin.clear();
+                    cin.ignore(10000, '\n');
+                    cout << "Invalid input.\n";
+                    break;
+                }
+                cin.ignore();
+
+                if (menu.updateMenuItemPrice(id, price)) {
+                    cout << "Price updated successfully.\n";
+                    menuJournal.recordPriceChange(id, price);
+                } else {
+                    cout << "Menu item not found.\n";
+                }
+                break;
+            }
+
+            case 13: // Save a snapshot of the whole system.
+                kitchen.waitUntilIdle();           // Orders in the kitchen are in neither container.
+                snapshot.save(SNAPSHOT_FILE);      // Written in the background.
+                cout << "Snapshot taken in " << snapshot.getLastEncodeMillis()
+                     << " ms; writing it in the background.\n";
+                break;
+
+            case 14: // Show how often and how fast the core operations ran.
+                OperationStats::writeReport(cout);
+                if (OperationStats::isEnabled() && OperationStats::saveJson(STATS_FILE)) {
+                    cout << "Statistics written to " << STATS_FILE << "\n";
+                }
+                break;
+
+            case 15: // Show how long completed orders waited and cooked.
+                kitchen.waitUntilIdle();
+                completedOrders.getTicketStats().writeReport(cout);
+                break;
+
+            case 16: // Choose between FIFO and priority scheduling.
+            {
+                int mode, agingMinutes;
+                cout << "Enter 0 for first come, first served or 1 for priority with aging: ";
+                cin >> mode;
+                if (mode == 1) {
+                    cout << "Enter minutes of waiting worth one priority class: ";
+                    cin >> agingMinutes;
+                }
+                if (cin.fail() || (mode != 0 && mode != 1) || (mode == 1 && agingMinutes < 0)) {
+                    cin.clear();
+                    cin.ignore(10000, '\n');
+                    cout << "Invalid input. Scheduling not changed.\n";
+                    break;
+                }
+                if (mode == 0) {
+                    activeOrders.setSchedulingMode(SCHEDULE_FIFO);
+                    cout << "Orders are processed first come, first served.\n";
+                } else {
+                    activeOrders.setSchedulingMode(SCHEDULE_PRIORITY, agingMinutes * 60000LL);
+                    cout << "Orders are processed by priority; every " << agingMinutes
+                         << " minutes of waiting counts as one class.\n";
+                }
+                break;
+            }
+
+            case 17: // Find dishes by any part of their name or description.
+            {
+                string query;
+                vector<int> ids;
+                cout << "Search for: ";
+                cin.ignore();
+                getline(cin, query);
+                int matches = menu.searchMenu(query, ids, 10);
+                if (matches == 0) {
+                    cout << "No menu items match \"" << query << "\".\n";
+                    break;
+                }
+                for (size_t i = 0; i < ids.size(); ++i) {
+                    menu.findMenuItem(ids[i])->display(cout);
+                }
+                if (matches > static_cast<int>(ids.size())) {
+                    cout << "Showing the best " << ids.size() << " of " << matches << " matches.\n";
+                }
+                break;
+            }
+
+            case 18: // List the items within a price range, cheapest first.
+            {
+                double minPrice, maxPrice;
+                vector<int> ids;
+                cout << "Lowest price in $: ";
+                cin >> minPrice;
+                cout << "Highest price in $: ";
+                cin >> maxPrice;
+                if (cin.fail() || minPrice > maxPrice) {
+                    cin.clear();
+                    cin.ignore(10000, '\n');
+                    cout << "Invalid price range.\n";
+                    break;
+                }
+
+                // Any answer that is not a station searches the whole menu.
+                string stationName;
+                PrepStation station = STATION_COUNT;
+                cout << "Station (line, grill, fryer, cold, bar, or all): ";
+                cin.ignore();
+                getline(cin, stationName);
+                MenuItem::parseStation(stationName, station);
+
+                if (menu.findItemsByPrice(minPrice, maxPrice, ids, station) == 0) {
+                    cout << "No menu items in that price range.\n";
+                    break;
+                }
+                for (size_t i = 0; i < ids.size(); ++i) {
+                    menu.findMenuItem(ids[i])->display(cout);
+                }
+                break;
+            }
+
             default: // Handle invalid menu options.
                 cout << "Invalid choice. Please try again.\n";
                 break;